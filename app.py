@@ -21,9 +21,167 @@ import plotly.graph_objs as go
 
 # -------------------- Helpers --------------------
 
+import socket
+import struct
 import subprocess
+import tempfile
+
+# In-process simulator (python3 setup.py build_ext --inplace); optional
+try:
+    import besim
+except ImportError:
+    besim = None
 
 CSV_PATH = os.path.join(os.path.dirname(__file__), 'resultats/simulations/circuit_output.csv')
+# Result files of a plain be-sim run, relative to its working directory
+OUTPUT_CSV = 'resultats/simulations/circuit_output.csv'
+OUTPUT_BIN = 'resultats/simulations/circuit_output.bin'
+OUTPUT_TRACE = 'resultats/simulations/circuit_output_trace.csv'
+# Points per plotted trace: the simulator reduces the result (per-bucket min/max)
+PLOT_POINTS = 4000
+
+
+def read_binary_output(path):
+    """
+    Read the columnar file written by 'be-sim --binaire' (see sortie_binaire.hpp).
+    Text header of 'entete' bytes (key=value lines), then n little-endian float64
+    values per column (temps, Vin, Vout). The columns are mapped, not parsed.
+    """
+    with open(path, 'rb') as fh:
+        first = fh.read(4096).decode('ascii', errors='replace')
+    if not first.startswith('BESIM-COLONNES'):
+        raise ValueError("en-tête binaire invalide")
+    header = dict(line.split('=', 1) for line in first.splitlines()[1:] if '=' in line)
+    n = int(header['n'])
+    valid = int(header['valides'])
+    offset = int(header['entete'])
+    names = [c.split(':')[0] for c in header['colonnes'].split(',')]
+    cols = np.memmap(path, dtype='<f8', mode='r', offset=offset, shape=(len(names), n))
+    return pd.DataFrame({name: cols[k, :valid] for k, name in enumerate(names)})
+
+FRAME_HEADER = struct.Struct('<4sI')
+# Persistent simulator ('be-sim --serveur'), used when its socket exists
+SIM_SOCKET = os.environ.get('BESIM_SOCKET', '/tmp/be-sim.sock')
+
+
+def read_frames(stream):
+    """Yield (type, payload) for each frame of 'be-sim --flux' (see flux_trames.hpp)."""
+    while True:
+        head = stream.read(FRAME_HEADER.size)
+        if len(head) < FRAME_HEADER.size:
+            return
+        kind, size = FRAME_HEADER.unpack(head)
+        payload = stream.read(size)
+        if len(payload) < size:
+            return
+        yield kind.decode('ascii', errors='replace'), payload
+
+
+def frame_columns(payload):
+    """ECHA/TRAC payload -> (first index, array of shape (3, m)), no copy."""
+    first, m = struct.unpack_from('<QQ', payload)
+    return first, np.frombuffer(payload, dtype='<f8', count=3 * m, offset=16).reshape(3, m)
+
+
+def collect_frames(stream, on_block=None):
+    """
+    Read one simulation answer (ENTE ... RESU) from a frame stream.
+    on_block(first_index, columns) is called for every sample block, so a
+    consumer can plot progressively. Returns (df, df_trace, summary), or None
+    if the stream does not start with a header frame.
+    """
+    blocks, df_trace, summary, header = [], None, {}, None
+    for kind, payload in read_frames(stream):
+        if header is None and kind not in ('ENTE', 'RESU'):
+            break
+        if kind == 'ENTE':
+            header = payload
+        elif kind == 'ECHA':
+            first, cols = frame_columns(payload)
+            blocks.append(cols)
+            if on_block is not None:
+                on_block(first, cols)
+        elif kind == 'TRAC':
+            cols = frame_columns(payload)[1]
+            df_trace = pd.DataFrame({'temps': cols[0], 'Vin': cols[1], 'Vout': cols[2]})
+        elif kind == 'RESU':
+            summary = dict(line.split('=', 1) for line in payload.decode().splitlines() if '=' in line)
+            break
+    if header is None and not summary:
+        return None
+    cols = np.concatenate(blocks, axis=1) if blocks else np.empty((3, 0))
+    df = pd.DataFrame({'temps': cols[0], 'Vin': cols[1], 'Vout': cols[2]})
+    return df, df_trace, summary
+
+
+def socket_simulation(request, on_block=None):
+    """
+    Send one request to the simulation server (key=value pairs, see serveur.hpp)
+    and read the frames it answers with. Returns None if no server is running.
+    """
+    if not os.path.exists(SIM_SOCKET):
+        return None
+    line = ' '.join(f'{k}={v}' for k, v in request.items()) + '\n'
+    try:
+        with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as sock:
+            sock.connect(SIM_SOCKET)
+            sock.sendall(line.encode() + b'fin\n')
+            with sock.makefile('rb') as stream:
+                return collect_frames(stream, on_block)
+    except OSError:
+        return None
+
+
+def library_simulation(request):
+    """
+    Run the simulation in-process through the besim extension module. The
+    columns are numpy views on the simulator's own arrays (no copy, no
+    parsing). Returns (df, df_trace, summary), or None if the module is
+    not built.
+    """
+    if besim is None:
+        return None
+    try:
+        result = besim.simuler(**request)
+    except ValueError as e:
+        return pd.DataFrame({'temps': [], 'Vin': [], 'Vout': []}), None, {'statut': 'erreur', 'message': str(e)}
+    cols = np.asarray(result['signal'])
+    df = pd.DataFrame({'temps': cols[0], 'Vin': cols[1], 'Vout': cols[2]}, copy=False)
+    df_trace = None
+    if result['trace'] is not None:
+        trace = np.asarray(result['trace'])
+        df_trace = pd.DataFrame({'temps': trace[0], 'Vin': trace[1], 'Vout': trace[2]})
+    summary = {'statut': 'ok', 'echantillons': result['n'], 'cache': result['cache'],
+               'pas_acceptes': result['pas_acceptes'], 'pas_rejetes': result['pas_rejetes']}
+    return df, df_trace, summary
+
+
+def stream_simulation(binary_path, input_str, work, on_block=None):
+    """
+    Run 'be-sim --flux' in the directory work and read its frames from the
+    pipe as they are produced. Returns (df, df_trace, summary), or None if the
+    binary does not speak the frame protocol (older build: its result files
+    are then in work).
+    """
+    process = subprocess.Popen(
+        [binary_path, '--flux', f'--trace={PLOT_POINTS}'],
+        cwd=work,
+        stdin=subprocess.PIPE,
+        stdout=subprocess.PIPE,
+        stderr=subprocess.PIPE,
+    )
+    process.stdin.write(input_str.encode())
+    process.stdin.close()
+
+    result = collect_frames(process.stdout, on_block)
+    process.stdout.read()
+    stderr = process.stderr.read().decode(errors='replace')
+    process.wait()
+
+    if result is not None and (process.returncode != 0 or result[2].get('statut') != 'ok'):
+        print(stderr)
+    return result
+
 
 def generate_simulation_csv(path, R=1e3, C=1e-6, L=0.0, h=1e-4, t_max=0.05,
                             method='Euler', source_type='Sinusoidal', amplitude=5.0, frequency=50.0,
@@ -37,7 +195,9 @@ def generate_simulation_csv(path, R=1e3, C=1e-6, L=0.0, h=1e-4, t_max=0.05,
     4. tmax (double)
     5. Source Choice: 1(Sin)/2(Step)/3(Tri)/4(Creneau)/5(Rect)
     6. Source Params...
-    7. Method: 1/2/3/4
+    7. Method: 1..9 (5 = RK45, followed by rtol and atol; 6/7/8 = implicit
+       Euler/trapezoidal/BDF2; 9 = automatic stiffness switch; 10 = exact
+       propagator)
     8. Circuit Params...
     """
     warnings = []
@@ -50,9 +210,10 @@ def generate_simulation_csv(path, R=1e3, C=1e-6, L=0.0, h=1e-4, t_max=0.05,
         
         # Binary location
         binary_path = os.path.join(os.path.dirname(__file__), 'be-sim')
-        if not os.path.exists(binary_path):
+        if besim is None and not os.path.exists(binary_path) and not os.path.exists(SIM_SOCKET):
              # Try to compile if missing? Or just warn.
-             return pd.DataFrame({'temps':[],'Vin':[],'Vout':[]}), ["Binary 'be-sim' not found"], h
+             empty = pd.DataFrame({'temps':[],'Vin':[],'Vout':[]})
+             return empty, empty, ["Binary 'be-sim' not found"], h
 
         # Build input string
         input_str = "n\n"  # No defaults
@@ -83,62 +244,84 @@ def generate_simulation_csv(path, R=1e3, C=1e-6, L=0.0, h=1e-4, t_max=0.05,
              
         # Method
         # Map method string to ID
-        m_map = {'Euler': 1, 'Euler2': 2, 'RK4': 3, 'Heun': 4}
+        m_map = {'Euler': 1, 'Euler2': 2, 'RK4': 3, 'Heun': 4, 'RK45': 5,
+                 'EulerImplicite': 6, 'Trapezes': 7, 'BDF2': 8, 'Auto': 9, 'Exacte': 10}
         m_id = m_map.get(method, 1) # Default Euler
         input_str += f"{m_id}\n"
+        if m_id == 5:
+            # RK45 (adaptive step): relative and absolute tolerances
+            input_str += "1e-6\n1e-9\n"
         
         # Circuit Params
         # Logic from main.cpp:
-        # if B: ask R1, R2, C
+        # if B: ask R1, R2, C, then the diode model (seuil/shockley; shockley
+        #       also asks Is, n, Vt)
         # else: ask R, C. If C/D ask L.
         if circuit_type == 'B':
             input_str += f"{R}\n"   # R1 maps to UI 'R'
             input_str += f"{R2}\n"  # R2
             input_str += f"{C}\n"
+            input_str += "seuil\n"  # same default diode as the request below
         else:
             input_str += f"{R}\n"
             input_str += f"{C}\n"
             if circuit_type in ['C', 'D']:
                 input_str += f"{L}\n"
 
-        # Run subprocess
-        process = subprocess.Popen(
-            [binary_path],
-            stdin=subprocess.PIPE,
-            stdout=subprocess.PIPE,
-            stderr=subprocess.PIPE,
-            text=True
-        )
-        stdout, stderr = process.communicate(input=input_str)
-        
-        if process.returncode != 0:
-            warnings.append(f"Erreur binaire C++ (code {process.returncode})")
-            print(stderr)
+        columns = {'temps': 'Time', 'Vin': 'InputVoltage', 'Vout': 'OutputVoltage'}
+        request = {'circuit': circuit_type, 'source': s_id, 'A': amplitude, 'f': frequency,
+                   'duty': duty, 'offset': offset, 'methode': m_id, 'npas': npas, 'tmax': t_max,
+                   'R': R, 'R2': R2, 'C': C, 'L': L, 'trace': PLOT_POINTS}
+        streamed = library_simulation(request)
+        if streamed is None:
+            streamed = socket_simulation(request)
+        if streamed is None:
+            # Stream frames from the simulator's stdout. It runs in a scratch
+            # directory: older binaries ignore --flux and write their result
+            # files there, never over the repository's copies, and concurrent
+            # runs do not overwrite each other.
+            with tempfile.TemporaryDirectory() as work:
+                streamed = stream_simulation(binary_path, input_str, work)
+                if streamed is None:
+                    return read_output_files(work, warnings, h)
+        df, df_trace, summary = streamed
+        if summary.get('statut') != 'ok':
+            warnings.append("Flux de simulation incomplet")
+        df = df.rename(columns=columns)
+        df_plot = df_trace.rename(columns=columns) if df_trace is not None else df
+        return df, df_plot, warnings, h
 
     except Exception as e:
         warnings.append(str(e))
-        return pd.DataFrame(), warnings, h
-
-    # Read the generated CSV
-    # Verify path exists
-    # Note: C++ output path is fixed to "resultats/simulations/circuit_output.csv"
-    # The 'path' arg passed to this func is mostly for where we *expect* it.
-    actual_csv_path = os.path.join(os.path.dirname(__file__), 'resultats/simulations/circuit_output.csv')
-    
-    if os.path.exists(actual_csv_path):
+        return pd.DataFrame(), pd.DataFrame(), warnings, h
+
+
+def read_output_files(work, warnings, h):
+    """
+    Result files written in work by a binary without --flux: the columns
+    (binary), or the CSV if the binary fell back to it. Copied in memory,
+    as work is removed afterwards.
+    """
+    columns = {'temps': 'Time', 'Vin': 'InputVoltage', 'Vout': 'OutputVoltage'}
+    bin_path = os.path.join(work, OUTPUT_BIN)
+    if os.path.exists(bin_path):
+        try:
+            df = read_binary_output(bin_path).copy().rename(columns=columns)
+            return df, load_plot_trace(df, work), warnings, h
+        except Exception as e:
+            warnings.append(f"Impossible de lire la sortie binaire: {e}")
+
+    csv_path = os.path.join(work, OUTPUT_CSV)
+    if os.path.exists(csv_path):
         try:
-            df = pd.read_csv(actual_csv_path)
-            # rename columns to match Dash expectation if needed
-            # C++: temps,Vin,Vout
-            # Dash: Time,InputVoltage,OutputVoltage
-            df = df.rename(columns={'temps': 'Time', 'Vin': 'InputVoltage', 'Vout': 'OutputVoltage'})
-            return df, warnings, h
+            df = pd.read_csv(csv_path).rename(columns=columns)
+            return df, load_plot_trace(df, work), warnings, h
         except Exception as e:
             warnings.append(f"Impossible de lire le CSV généré: {e}")
-            return pd.DataFrame(), warnings, h
+            return pd.DataFrame(), pd.DataFrame(), warnings, h
     else:
         warnings.append("Fichier CSV non trouvé après exécution.")
-        return pd.DataFrame(), warnings, h
+        return pd.DataFrame(), pd.DataFrame(), warnings, h
 
 
 # -------------------- Ensure CSV exists --------------------
@@ -150,6 +333,18 @@ app = Dash(__name__, external_stylesheets=external_stylesheets)
 app.title = 'Dashboard Simulation Circuit'
 
 
+def load_plot_trace(df_full, work):
+    """Plot-ready trace written by the simulator in work, or the full result if absent."""
+    trace_path = os.path.join(work, OUTPUT_TRACE)
+    if os.path.exists(trace_path):
+        try:
+            df = pd.read_csv(trace_path)
+            return df.rename(columns={'temps': 'Time', 'Vin': 'InputVoltage', 'Vout': 'OutputVoltage'})
+        except Exception:
+            pass
+    return df_full
+
+
 def load_csv_preview(path, nrows=10):
     if os.path.exists(path):
         df = pd.read_csv(path)
@@ -192,7 +387,7 @@ app.layout = html.Div([
                     html.H4('⏰ Paramètres de Simulation'),
                     html.Div(className='param-row', children=[html.Label('Pas de temps h (s)'), dcc.Input(id='h', type='number', value=1e-4, min=1e-7, step=1e-5)]),
                     html.Div(className='param-row', children=[html.Label('Temps max t_max (s)'), dcc.Input(id='tmax', type='number', value=0.05, min=0.001, step=0.001)]),
-                    html.Div(className='param-row', children=[html.Label('Méthode'), dcc.Dropdown(id='method', options=[{'label':'Euler (Ordre 1)','value':'Euler'},{'label':'Euler (Syst. 2)','value':'Euler2'},{'label':'Runge-Kutta 4','value':'RK4'}, {'label':'Heun','value':'Heun'}], value='RK4', clearable=False, searchable=False, className='themed-dropdown')]),
+                    html.Div(className='param-row', children=[html.Label('Méthode'), dcc.Dropdown(id='method', options=[{'label':'Euler (Ordre 1)','value':'Euler'},{'label':'Euler (Syst. 2)','value':'Euler2'},{'label':'Runge-Kutta 4','value':'RK4'}, {'label':'Heun','value':'Heun'}, {'label':'Dormand-Prince RK45 (adaptatif)','value':'RK45'}, {'label':'Euler implicite','value':'EulerImplicite'}, {'label':'Trapèzes (implicite)','value':'Trapezes'}, {'label':'BDF2 (implicite)','value':'BDF2'}, {'label':'Automatique (raideur)','value':'Auto'}, {'label':'Exacte (A, C, D)','value':'Exacte'}], value='RK4', clearable=False, searchable=False, className='themed-dropdown')]),
                 ]),
 
                 html.Hr(),
@@ -263,7 +458,8 @@ def update_all(n_clicks, R, C, L, h, tmax, method, amplitude, frequency, source_
     L = float(L) if L is not None else 0.0
     h = float(h) if h is not None and h > 0 else 0.0001
     tmax = float(tmax) if tmax is not None and tmax > 0 else 0.05
-    method = method if method in ('Euler', 'Euler2', 'Heun', 'RK4') else 'RK4'
+    method = method if method in ('Euler', 'Euler2', 'Heun', 'RK4', 'RK45',
+                                   'EulerImplicite', 'Trapezes', 'BDF2', 'Auto', 'Exacte') else 'RK4'
     amplitude = float(amplitude) if amplitude is not None else 5.0
     frequency = float(frequency) if frequency is not None else 50.0
     source_type = source_type if source_type is not None else 'Sinusoidal'
@@ -273,19 +469,20 @@ def update_all(n_clicks, R, C, L, h, tmax, method, amplitude, frequency, source_
     offset = float(offset) if offset is not None else 0.0
 
     # Generate a new CSV preview (simulate running the C++ sim)
-    df, warnings_list, h_used = generate_simulation_csv(CSV_PATH, R=R, C=C, L=L, h=h, t_max=tmax, method=method,
+    df, df_plot, warnings_list, h_used = generate_simulation_csv(CSV_PATH, R=R, C=C, L=L, h=h, t_max=tmax, method=method,
                                                         source_type=source_type, amplitude=amplitude, frequency=frequency,
                                                         circuit_type=c_type, R2=R2, duty=duty, offset=offset)
 
+    # Plots use the reduced trace; the table shows full-resolution rows
     # Build figures with dark theme styling
     fig_out = go.Figure()
-    fig_out.add_trace(go.Scatter(x=df['Time'], y=df['OutputVoltage'], mode='lines+markers', name='v_s(t)', line={'width':3}, marker={'size':4}))
+    fig_out.add_trace(go.Scatter(x=df_plot['Time'], y=df_plot['OutputVoltage'], mode='lines+markers', name='v_s(t)', line={'width':3}, marker={'size':4}))
     fig_out.update_layout(template='plotly_dark', paper_bgcolor='rgba(0,0,0,0)', plot_bgcolor='rgba(10,10,10,0.6)', margin={'t':30,'b':20,'l':40,'r':20})
     fig_out.update_xaxes(title='Temps (s)', showgrid=True, gridcolor='rgba(255,255,255,0.05)')
     fig_out.update_yaxes(title='v_s(t) (V)', showgrid=True, gridcolor='rgba(255,255,255,0.05)')
 
     fig_in = go.Figure()
-    fig_in.add_trace(go.Scatter(x=df['Time'], y=df['InputVoltage'], mode='lines', name='v_e(t)', line={'width':2, 'dash':'dash'}, marker={'size':3}))
+    fig_in.add_trace(go.Scatter(x=df_plot['Time'], y=df_plot['InputVoltage'], mode='lines', name='v_e(t)', line={'width':2, 'dash':'dash'}, marker={'size':3}))
     fig_in.update_layout(template='plotly_dark', paper_bgcolor='rgba(0,0,0,0)', plot_bgcolor='rgba(10,10,10,0.6)', margin={'t':30,'b':20,'l':40,'r':20})
     fig_in.update_xaxes(title='Temps (s)', showgrid=True, gridcolor='rgba(255,255,255,0.05)')
     fig_in.update_yaxes(title='v_e(t) (V)', showgrid=True, gridcolor='rgba(255,255,255,0.05)')
@@ -310,4 +507,3 @@ if __name__ == '__main__':
     except TypeError:
         # Fallback for older Dash versions that expect run_server
         app.run_server(debug=True)
-```
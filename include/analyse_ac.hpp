@@ -0,0 +1,62 @@
+#ifndef ANALYSE_AC_HPP
+#define ANALYSE_AC_HPP
+
+#include "circuit.hpp"
+#include "lot_circuits.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Analyse AC (petits signaux) : gain et phase de H(jω) = Vout / Vin sur un
+// balayage logarithmique de fréquences, sans aucune simulation temporelle.
+// Usage : be-sim --ac [cle=valeur ...]
+// Clés : circuit, R, R2, C, L, diode, Is, n, Vt (comme be-sim --serveur), plus :
+//   fmin=10, fmax=1e6     bornes du balayage (Hz)
+//   points=2000           nombre de fréquences (espacement logarithmique)
+//   offset=V              point de fonctionnement ve = V (circuit B : la
+//                         diode conduit d'autant plus que V est grand ;
+//                         diode=seuil : H = 0 sous 0,6 V)
+//   threads=N             0 : autant que de cœurs
+//   jeu=auto|scalaire|avx2|avx512
+//   format=csv|binaire    colonnes frequence, gain_db, phase_deg
+//   sortie=chemin         (défaut resultats/ac/bode.csv ou .bin)
+//
+// H(s) est construite depuis le modèle d'état du circuit, comme pour la
+// méthode exacte (propagateur.hpp) : A = jacobien, B = réponse des dérivées
+// à ve, sortie x1. Pour un circuit non linéaire (B), c'est la linéarisation
+// autour du point de fonctionnement. Le balayage est découpé en blocs
+// répartis sur un PoolTaches ; chaque bloc évalue H avec le noyau vectoriel
+// du processeur (noyaux_ac.hpp), puis gain (dB) et phase (degrés).
+
+// H(s) = (n[0] + n[1] s + n[2] s²) / (d[0] + d[1] s + d[2] s²)
+struct FonctionTransfert {
+    double n[3] = {0.0, 0.0, 0.0};
+    double d[3] = {1.0, 0.0, 0.0};
+};
+
+// R2 : résistance de décharge du circuit B ; polarisation : ve du point de fonctionnement
+FonctionTransfert fonctionTransfert(const Circuit& circuit, double R2, double polarisation);
+
+struct OptionsAC {
+    double fmin = 10.0;
+    double fmax = 1e6;
+    std::size_t points = 2000;
+    unsigned threads = 0;
+    JeuInstructions jeu = JeuInstructions::Auto;
+};
+
+struct ReponseFrequentielle {
+    std::vector<double> frequence;  // Hz
+    std::vector<double> gainDb;     // 20 log10 |H|
+    std::vector<double> phaseDeg;   // arg H, déroulée
+    JeuInstructions jeu = JeuInstructions::Scalaire;   // noyau utilisé
+};
+
+// false (avec un message) si le balayage est invalide
+bool analyseAC(const FonctionTransfert& h, const OptionsAC& opt, ReponseFrequentielle& r,
+               std::string& erreur);
+
+// Point d'entrée du mode AC (main.cpp)
+int lancerAC(int argc, char** argv);
+
+#endif // ANALYSE_AC_HPP
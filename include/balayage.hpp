@@ -0,0 +1,83 @@
+#ifndef BALAYAGE_HPP
+#define BALAYAGE_HPP
+
+#include "besim.hpp"
+#include "circuit.hpp"
+#include <string>
+#include <vector>
+
+// Balayage de paramètres : toutes les combinaisons de R, C, L, R2, fréquence de
+// la source et méthode sont simulées en parallèle sur un PoolTaches (vol de
+// tâches). Chaque point écrit son résultat dans sa propre case du tableau des
+// résultats : aucun verrou global pour la collecte.
+//
+// Usage : be-sim --balayage [fichier] [cle=valeur ...]
+// Le fichier contient des lignes "cle = valeur" (# pour les commentaires) ;
+// les arguments cle=valeur de la ligne de commande sont lus après lui.
+// Valeurs : une liste "100,220,470", une plage linéaire "100:1000:10"
+// (début:fin:nombre de points) ou logarithmique "1e-9:1e-6:4:log".
+// diode=shockley|seuil, Is, n et Vt (circuit B), rtol et atol (méthode 5)
+// prennent une seule valeur. Chaque point est vérifié avant le calcul
+// (verifierParametres : circuit A à D, source 1 à 5, méthode 1 à 10, valeurs
+// et fréquence positives, duty dans [0, 1]) ; un seul point invalide et le
+// balayage n'est pas lancé.
+
+struct ConfigBalayage {
+    char circuit = 'A';
+    int typeSource = 1;             // même numérotation que initialiserSource()
+    double amplitude = 5.0;
+    double dutyCycle = 0.5;
+    double offset = 0.0;
+    double startTime = 0.0;
+    ParametresDiode diode;          // circuit B
+
+    std::vector<double> R{1000.0};
+    std::vector<double> C{1e-6};
+    std::vector<double> L{1e-3};
+    std::vector<double> R2{1000.0};
+    std::vector<double> f{50.0};
+    std::vector<int> methodes{1};
+
+    int npas = 20000;
+    double tmax = 500e-9;
+    double rtol = 1e-6;             // méthode 5
+    double atol = 1e-9;
+
+    unsigned threads = 0;           // 0 : autant que de cœurs
+    bool echelle = false;           // mesure de l'efficacité de 1 à N threads
+    std::string sortie = "resultats/balayage/balayage.csv";
+};
+
+// Un point du balayage (n-uplet de paramètres)
+struct PointBalayage {
+    double R, C, L, R2, f;
+    int methode;
+};
+
+// Résultat d'un point : statistiques de Vout sur la simulation
+struct ResultatBalayage {
+    double vFinal = 0.0;
+    double vMin = 0.0;
+    double vMax = 0.0;
+    double vEff = 0.0;      // valeur efficace
+    double dureeNs = 0.0;   // temps de calcul du point
+};
+
+// Lecture de la configuration ; retourne false (avec un message) si invalide
+bool lireConfigBalayage(int argc, char** argv, ConfigBalayage& cfg, std::string& erreur);
+
+// Produit cartésien des listes de valeurs
+std::vector<PointBalayage> pointsBalayage(const ConfigBalayage& cfg);
+
+// Paramètres de simulation d'un point (vérifiés par verifierParametres)
+ParametresSimulation parametresPoint(const ConfigBalayage& cfg, const PointBalayage& p);
+
+// Simule tous les points avec nThreads threads ; retourne la durée totale (s)
+double executerBalayage(const ConfigBalayage& cfg, const std::vector<PointBalayage>& points,
+                        unsigned nThreads, std::vector<ResultatBalayage>& resultats,
+                        std::size_t* vols = nullptr);
+
+// Point d'entrée du mode balayage (main.cpp)
+int lancerBalayage(int argc, char** argv);
+
+#endif // BALAYAGE_HPP
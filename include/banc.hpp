@@ -0,0 +1,66 @@
+#ifndef BANC_HPP
+#define BANC_HPP
+
+#include <string>
+#include <vector>
+
+// Banc d'essai des solveurs, sans saisie clavier ni écriture dans la mesure
+// (sauf pour le chemin CSV, mesuré en tant que tel).
+// Usage : be-sim --banc [cle=valeur ...]
+// Trois familles de cas :
+//   noyau/<méthode>/<circuit>/<source>   fonctions de solver_static.hpp
+//       appelées directement pas après pas (euler1, rk4_order1, heun_order1
+//       pour A et B ; euler2, rk4, heun pour C et D), sur chaque source ;
+//   csv/<méthode>/<circuit>/<source>     chemin complet du mode interactif :
+//       simulerStatique() + EcrivainAsynchrone jusqu'au fichier CSV vidé
+//       (source sinus) ;
+//   lot/<jeu>/<méthode>/<circuit>        moteur lot (lot_circuits.hpp), N
+//       instances de R réparti de R/2 à 3R/2, source sinus, sur chaque jeu
+//       d'instructions disponible ; temps par pas d'instance. Avant la mesure,
+//       l'état final est comparé à celui de chaque instance intégrée seule
+//       (avancerStatique), sur la sinusoïde et sur un créneau dont les fronts
+//       coupent les pas : un écart relatif au-delà de 1e-9 arrête le banc.
+//       Circuit B : diode=seuil seulement (LotCircuits::accepte).
+// Clés : celles de be-sim --serveur pour les valeurs des composants et des
+// sources (A, f, duty, offset, t0, R, R2, C, L, diode, Is, n, Vt, tmax ;
+// défaut tmax = 2e-2), plus :
+//   npas=N           pas par mesure (défaut 200000)
+//   repetitions=N    mesures par cas (défaut 7)
+//   lot=N            instances des cas lot, npas pas chacune (défaut 64,
+//                    0 : pas de cas lot)
+//   methode=1..4     méthode du chemin CSV (défaut 3)
+//   csv=oui|non      mesurer aussi le chemin CSV (défaut oui)
+//   fichier=chemin   CSV écrit par ces cas (défaut resultats/banc/sortie.csv)
+//   filtre=texte     ne garder que les cas dont le nom contient texte
+//   json=chemin      exporter les résultats (défaut : aucun)
+//
+// Chaque cas est d'abord exécuté une fois, hors mesure, avec un circuit qui
+// compte ses évaluations de dérivées (chauffe des caches et du prédicteur de
+// branchement) ; suivent les répétitions chronométrées. On retient la médiane
+// du temps par pas, moins sensible qu'une moyenne à un passage de
+// l'ordonnanceur, avec le minimum et la dispersion (écart absolu médian
+// relatif) pour juger de la stabilité de la mesure.
+
+struct ResultatBanc {
+    std::string cas;                // ex. noyau/rk4/C/sinus
+    std::string famille, methode, source;
+    char circuit = 'A';
+    long pas = 0;                   // pas par répétition
+    long lignes = 0;                // lignes CSV par répétition (0 : noyau)
+    double evaluationsParPas = 0.0; // dérivées évaluées par pas
+    double nsMedian = 0.0, nsMin = 0.0;     // par pas
+    double dispersion = 0.0;        // écart absolu médian / médiane
+
+    double evaluationsParSeconde() const { return evaluationsParPas * 1e9 / nsMedian; }
+    double lignesParSeconde() const { return lignes > 0 ? lignes * 1e9 / (nsMedian * pas) : 0.0; }
+};
+
+// Export JSON (un objet, les cas dans "cas") ; false si le fichier ne peut
+// pas être écrit
+bool ecrireJsonBanc(const std::string& chemin, const std::vector<ResultatBanc>& resultats,
+                    int npas, int repetitions, double dt);
+
+// Point d'entrée du banc d'essai (main.cpp)
+int lancerBanc(int argc, char** argv);
+
+#endif // BANC_HPP
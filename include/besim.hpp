@@ -0,0 +1,100 @@
+#ifndef BESIM_HPP
+#define BESIM_HPP
+
+#include "circuit.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+
+// API de bibliothèque du simulateur : une simulation complète (circuit,
+// source, méthode) sans saisie clavier, sans fichier ni thread d'écriture.
+// Les résultats restent dans des tableaux possédés par ResultatSimulation,
+// que les liaisons Python (python/besim_module.cpp) exposent sans copie.
+//
+//   ParametresSimulation p;
+//   p.circuit = 'C'; p.typeSource = 4; p.methode = 3; p.npas = 100000; p.tmax = 2e-2;
+//   ResultatSimulation r;
+//   std::string erreur;
+//   if (simuler(p, r, erreur)) { r.signal.vout()[i] ... }
+
+struct ParametresSimulation {
+    char circuit = 'A';             // 'A', 'B', 'C' ou 'D'
+    int typeSource = 1;             // même numérotation que initialiserSource()
+    double amplitude = 5.0;
+    double f = 50.0;
+    double dutyCycle = 0.5;
+    double offset = 0.0;
+    double startTime = 0.0;
+
+    double R = 1000.0;
+    double R2 = 1000.0;
+    double C = 1e-6;
+    double L = 1e-3;
+    ParametresDiode diode;          // circuit B
+
+    int methode = 1;                // 1..10, même numérotation que le menu
+    int npas = 20000;
+    double tmax = 500e-9;
+    double rtol = 1e-6;             // méthode 5 uniquement
+    double atol = 1e-9;
+
+    std::size_t trace = 0;          // points de la trace réduite (0 : aucune)
+    bool lttb = false;              // trace LTTB au lieu de min/max
+};
+
+// Fixe un paramètre par son nom (clés de be-sim --serveur : circuit, source,
+// A, f, duty, offset, t0, R, R2, C, L, diode, Is, n, Vt, methode, npas, tmax,
+// rtol, atol, trace, lttb) ; false (avec un message) si la clé ou la valeur
+// est invalide
+bool fixerParametre(const std::string& cle, const std::string& valeur,
+                    ParametresSimulation& p, std::string& erreur);
+
+// Pas au plus par simulation gardée en mémoire (24 octets par échantillon)
+constexpr int NPAS_MAX = 100000000;
+
+// Cohérence de l'ensemble (types connus, 0 < npas <= npasMax ; tmax, f, R,
+// R2, C, L, rtol, atol et paramètres de la diode positifs et finis ; duty dans
+// [0, 1] ; A, offset et t0 finis). npasMax :
+// NPAS_MAX sauf pour les modes qui n'écrivent que sur disque (transitoire)
+bool verifierParametres(const ParametresSimulation& p, std::string& erreur,
+                        int npasMax = NPAS_MAX);
+
+// Trois colonnes (temps, Vin, Vout) dans un seul bloc non initialisé :
+// temps à l'indice 0, Vin à capacite(), Vout à 2 * capacite()
+class Colonnes {
+public:
+    void allouer(std::size_t capacite);
+
+    std::size_t taille() const { return n_; }
+    std::size_t capacite() const { return capacite_; }
+    void fixerTaille(std::size_t n) { n_ = n; }
+
+    double* temps() { return donnees_.get(); }
+    double* vin() { return donnees_.get() + capacite_; }
+    double* vout() { return donnees_.get() + 2 * capacite_; }
+    const double* temps() const { return donnees_.get(); }
+    const double* vin() const { return donnees_.get() + capacite_; }
+    const double* vout() const { return donnees_.get() + 2 * capacite_; }
+
+private:
+    std::unique_ptr<double[]> donnees_;
+    std::size_t n_ = 0;
+    std::size_t capacite_ = 0;
+};
+
+struct ResultatSimulation {
+    Colonnes signal;                // npas + 1 échantillons
+    Colonnes trace;                 // trace réduite si p.trace > 0, vide sinon
+    long pasAcceptes = 0;           // méthode 5
+    long pasRejetes = 0;
+    double dureeNs = 0.0;           // temps de calcul
+};
+
+// Trace réduite (Decimateur) d'un signal, au plus `points` points
+void reduire(const Colonnes& signal, std::size_t points, bool lttb, Colonnes& trace);
+
+// Simulation complète ; false (avec un message) si les paramètres sont invalides.
+// Voir aussi simulerEnCache() (cache_resultats.hpp).
+bool simuler(const ParametresSimulation& p, ResultatSimulation& r, std::string& erreur);
+
+#endif // BESIM_HPP
@@ -0,0 +1,141 @@
+#ifndef CACHE_RESULTATS_HPP
+#define CACHE_RESULTATS_HPP
+
+#include "besim.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+// Cache des résultats adressé par le contenu de la configuration.
+// La clé canonique ne retient que ce dont dépend la trajectoire (circuit et
+// ses composants utiles, source et ses paramètres utiles, méthode, npas,
+// tmax, tolérances de la méthode 5), chaque réel sous son écriture la plus
+// courte qui le relit exactement ; la trace réduite n'en fait pas partie.
+// Deux niveaux :
+//   - mémoire : LRU borné en octets, partagé par les appelants d'un même
+//     processus (serveur, module Python) ;
+//   - disque : un fichier <empreinte FNV-1a>.bin par résultat, au format de
+//     SortieBinaire (donc lisible par numpy.memmap), clé complète dans
+//     l'en-tête pour écarter les collisions ; éviction LRU sur la date de
+//     modification, mise à jour à chaque succès. Seulement si un dossier
+//     est donné (OptionsCache::dossier) : le serveur prend resultats/cache,
+//     la bibliothèque et le module Python restent en mémoire.
+// Une clé absente est réservée au premier demandeur, qui la calcule : les
+// demandes concurrentes de la même clé attendent son résultat au lieu de
+// refaire le calcul.
+
+// Clé canonique d'une configuration (texte "cle=valeur;...")
+std::string cleCanonique(const ParametresSimulation& p);
+
+// Même clé sans l'horizon (npas, tmax) : identité du circuit, de la source et
+// de la méthode, partagée par une simulation et ses prolongements
+std::string identiteTrajectoire(const ParametresSimulation& p);
+
+// Empreinte FNV-1a 64 bits
+std::uint64_t empreinteFnv1a(const std::string& texte);
+
+enum class OrigineResultat { Calcul, Memoire, Disque };
+
+const char* nomOrigine(OrigineResultat origine);
+
+struct OptionsCache {
+    std::string dossier;                        // vide : pas de niveau disque
+    std::size_t limiteDisque = std::size_t(1) << 30;
+    std::size_t limiteMemoire = std::size_t(256) << 20;
+};
+
+class CacheResultats {
+public:
+    struct Statistiques {
+        std::size_t succesMemoire = 0;
+        std::size_t succesDisque = 0;
+        std::size_t echecs = 0;
+        std::size_t octetsMemoire = 0;
+    };
+
+    // Calcul d'une clé réservé par chercher() : ranger() le résultat, ou
+    // détruire la réservation sans ranger (échec, exception) pour que l'un
+    // des demandeurs en attente prenne le calcul à son tour
+    class Reservation {
+    public:
+        Reservation() = default;
+        ~Reservation() { liberer(); }
+
+        Reservation(const Reservation&) = delete;
+        Reservation& operator=(const Reservation&) = delete;
+
+        bool active() const { return cache_ != nullptr; }
+
+        // Range le résultat calculé (signal seul) et libère la clé
+        void ranger(const std::shared_ptr<const ResultatSimulation>& r);
+
+    private:
+        friend class CacheResultats;
+        CacheResultats* cache_ = nullptr;
+        std::string cle_;
+
+        void liberer();
+    };
+
+    explicit CacheResultats(const OptionsCache& options = OptionsCache());
+
+    CacheResultats(const CacheResultats&) = delete;
+    CacheResultats& operator=(const CacheResultats&) = delete;
+
+    // Résultat rangé sous cette clé (mémoire puis disque). Absent : nullptr
+    // et la clé est réservée à l'appelant. Si un autre appelant la calcule
+    // déjà, attend qu'il range son résultat ou y renonce.
+    std::shared_ptr<const ResultatSimulation> chercher(const std::string& cle,
+                                                       OrigineResultat& origine,
+                                                       Reservation& reservation);
+
+    // Un résultat de n échantillons tient-il dans la limite mémoire ? Au-delà,
+    // il n'est pas gardé en mémoire
+    bool gardable(std::size_t n) const;
+
+    Statistiques statistiques() const;
+    const OptionsCache& options() const { return options_; }
+
+private:
+    struct Entree {
+        std::shared_ptr<const ResultatSimulation> resultat;
+        std::size_t octets;
+        std::list<std::string>::iterator position;
+    };
+
+    OptionsCache options_;
+    mutable std::mutex m_;
+    std::list<std::string> lru_;                // plus récent en tête
+    std::unordered_map<std::string, Entree> entrees_;
+    std::unordered_set<std::string> enCours_;   // clés réservées, en cours de calcul
+    std::condition_variable cvEnCours_;
+    Statistiques stats_;
+    std::mutex mDisque_;                        // écritures et élagage du dossier
+
+    void garderEnMemoire(const std::string& cle, const std::shared_ptr<const ResultatSimulation>& r);
+    void ranger(const std::string& cle, const std::shared_ptr<const ResultatSimulation>& r);
+    void liberer(const std::string& cle);
+    std::string cheminDisque(const std::string& cle) const;
+    std::shared_ptr<const ResultatSimulation> lireDisque(const std::string& cle);
+    void ecrireDisque(const std::string& cle, const ResultatSimulation& r);
+    void elaguerDisque();
+};
+
+// Cache du processus ; configurerCache() avant le premier appel pour changer les options
+CacheResultats& cacheResultats();
+void configurerCache(const OptionsCache& options);
+
+// Comme simuler(), en passant par le cache du processus : le signal est
+// partagé avec le cache (lecture seule), la trace est calculée dans trace si
+// p.trace > 0. false (avec un message) si les paramètres sont invalides.
+bool simulerEnCache(const ParametresSimulation& p, std::shared_ptr<const ResultatSimulation>& r,
+                    Colonnes& trace, std::string& erreur,
+                    OrigineResultat* origine = nullptr);
+
+#endif // CACHE_RESULTATS_HPP
@@ -1,9 +1,29 @@
 #ifndef CIRCUIT_HPP
 #define CIRCUIT_HPP
 
+#include <cmath>
 #include <string>
 
 
+// Diode du circuit B. Interrupteur idéal à seuil 0,6 V par défaut (modèle
+// historique, conducteur dès que ve > 0,6 V, y compris en inverse ; c'est
+// celui des noyaux du moteur lot), ou modèle de Shockley sur demande
+// (diode=shockley) :
+//   i = Is (exp(v / (n Vt)) - 1)
+// Le modèle de Shockley résout une équation implicite à chaque évaluation
+// des dérivées : plusieurs fois plus coûteux pour les méthodes explicites.
+struct ParametresDiode {
+    bool shockley = false;
+    double Is = 1e-14;      // courant de saturation (A)
+    double n = 1.0;         // facteur d'idéalité
+    double Vt = 0.025852;   // tension thermique (V), 300 K
+};
+
+// Limitation de la tension d'une jonction entre deux itérations de Newton
+// (pnjlim de SPICE) : au-delà de la tension critique, un grand pas sur
+// l'exponentielle est ramené à un pas logarithmique
+double limiterJonction(double v, double ancienne, double nvt, double is);
+
 // On crée la classe circuit de base équipée d'un constructeur par défaut et des constructeurs paramétrés
 // On définit les méthodes 
 // On définit les variables 
@@ -23,6 +43,10 @@ public:
     // Ordre 1 par défaut
     virtual int order() const { return 1; }
 
+    // Linéaire invariant (dx/dt = A x + B ve, A et B constants) : autorise
+    // le propagateur exact (propagateur.hpp)
+    virtual bool lineaire() const { return false; }
+
     // Système 1er ordre (circuits A and B)
     virtual double deriv1(double t, double x1, double ve, double extra) const {
         (void)t; (void)x1; (void)ve; (void)extra; return 0.0;
@@ -33,6 +57,29 @@ public:
         (void)t; (void)x1; (void)x2; (void)ve; dx1 = 0.0; dx2 = 0.0;
     }
 
+    // Jacobiens (dérivées partielles du second membre par rapport à l'état),
+    // utilisés par les méthodes implicites (solver_implicite.hpp).
+    // Par défaut : différences finies ; les circuits A à D les donnent
+    // analytiquement.
+    virtual double jacobien1(double t, double x1, double ve, double extra) const {
+        double h = 1e-7 * (1.0 + std::fabs(x1));
+        return (deriv1(t, x1 + h, ve, extra) - deriv1(t, x1 - h, ve, extra)) / (2.0 * h);
+    }
+
+    virtual void jacobien2(double t, double x1, double x2, double ve,
+                           double &j11, double &j12, double &j21, double &j22) const {
+        double h1 = 1e-7 * (1.0 + std::fabs(x1)), h2 = 1e-7 * (1.0 + std::fabs(x2));
+        double a1, a2, b1, b2;
+        deriv2(t, x1 + h1, x2, ve, a1, a2);
+        deriv2(t, x1 - h1, x2, ve, b1, b2);
+        j11 = (a1 - b1) / (2.0 * h1);
+        j21 = (a2 - b2) / (2.0 * h1);
+        deriv2(t, x1, x2 + h2, ve, a1, a2);
+        deriv2(t, x1, x2 - h2, ve, b1, b2);
+        j12 = (a1 - b1) / (2.0 * h2);
+        j22 = (a2 - b2) / (2.0 * h2);
+    }
+
     // destructeur virtuel
     virtual ~Circuit() = default;
 
@@ -44,6 +91,9 @@ protected:
     double frequency_; // Frequency 
     double timeConstant_; // Time constant
 
+    // Constructeur des classes dérivées : fixe directement le type (A/B/C/D)
+    Circuit(double R, double C, double L, double F, const std::string& type);
+
     // Méthodes utilitaires protégées
     void calculerConstanteTemps();
     void initialiserType();
@@ -52,41 +102,158 @@ protected:
 // Classes dérivées pour chaque type de circuit spécifique
 // Elles sont initialisées selon leur type avec les bons paramètres
 
-class CircuitA : public Circuit {
+class CircuitA final : public Circuit {
 public:
     CircuitA();
-    CircuitA(double R, double C, double F);
-    int order() const override;
+    // afficher = false : pas de message de création (balayages, lots)
+    CircuitA(double R, double C, double F, bool afficher = true);
+    int order() const override { return 1; }
+    bool lineaire() const override { return true; }
     double deriv1(double t, double x1, double ve, double extra) const override;
+    double jacobien1(double t, double x1, double ve, double extra) const override;
 };  
 
-class CircuitB : public Circuit {
+class CircuitB final : public Circuit {
 public:
     CircuitB();
         // Constructeur complet pour initialiser R1 et R2
-        CircuitB(double R1, double R2, double C, double F);
-    int order() const override;
+        CircuitB(double R1, double R2, double C, double F, bool afficher = true,
+                 const ParametresDiode& diode = ParametresDiode());
+    int order() const override { return 1; }
     double deriv1(double t, double x1, double ve, double extra) const override;
+    double jacobien1(double t, double x1, double ve, double extra) const override;
     double getR2() const { return R2_; }
+    const ParametresDiode& diode() const { return diode_; }
+
+    // Modèle de Shockley : diode et R1 en série sous la tension u = ve - vs.
+    // Tension de la diode (Newton depuis un point où le résidu est positif :
+    // convergence monotone, sans limitation), courant et g = di/du
+    double tensionDiode(double u) const;
+    double courantDiode(double u, double& g) const;
+
+    // Pas implicite vs = b + gh dvs/dt, ve et R2 = extra à la fin du pas :
+    // Newton sur (vs, vd) ensemble, jacobien analytique, vd limitée
+    // (limiterJonction). (vs, vd) : point de départ (vd non fini : calculé
+    // depuis vs), puis solution. Retourne le nombre d'itérations.
+    int resoudrePas(double& vs, double& vd, double b, double gh, double ve, double extra) const;
 private:
     double R2_ = 1000.0;
+    ParametresDiode diode_;
 };
 
-class CircuitC : public Circuit {
+class CircuitC final : public Circuit {
 public:
     CircuitC();
-    CircuitC(double R, double C, double L, double F);
-    int order() const override;
+    CircuitC(double R, double C, double L, double F, bool afficher = true);
+    int order() const override { return 2; }
+    bool lineaire() const override { return true; }
     void deriv2(double t, double x1, double x2, double ve, double &dx1, double &dx2) const override;
+    void jacobien2(double t, double x1, double x2, double ve,
+                   double &j11, double &j12, double &j21, double &j22) const override;
 };  
 
-class CircuitD : public Circuit {
+class CircuitD final : public Circuit {
 public:
     CircuitD();
-    CircuitD(double R, double C, double L, double F);
-    int order() const override;
+    CircuitD(double R, double C, double L, double F, bool afficher = true);
+    int order() const override { return 2; }
+    bool lineaire() const override { return true; }
     void deriv2(double t, double x1, double x2, double ve, double &dx1, double &dx2) const override;
+    void jacobien2(double t, double x1, double x2, double ve,
+                   double &j11, double &j12, double &j21, double &j22) const override;
 };
+
+// Définitions inline des équations différentielles : elles doivent être visibles
+// depuis les noyaux templates (solver_static.hpp) pour pouvoir être inlinées.
+// Les classes étant final, un appel sur le type concret est dévirtualisé.
+
+// Circuit RC passe-bas : dv_s/dt = (ve - v_s) / (R*C)
+inline double CircuitA::deriv1(double /*t*/, double vs, double ve, double /*extra*/) const {
+    return (ve - vs) / (R_ * C_);
+}
+
+// Circuit RCD avec diode (extra = R2) : C dvs/dt = i - vs/R2
+inline double CircuitB::deriv1(double /*t*/, double vs, double ve, double extra) const {
+    double R2 = extra;
+    if (diode_.shockley) {
+        double g;
+        return (courantDiode(ve - vs, g) - vs / R2) / C_;
+    }
+    double vBE = 0.6;
+    if (ve > vBE) {
+        return - (1.0/(R_ * C_) + 1.0/(R2 * C_)) * vs + (ve - vBE)/(R_ * C_);
+    } else {
+        return - vs/(R2 * C_);
+    }
+}
+
+// Circuit RLC série : x1 = vc, x2 = i
+inline void CircuitC::deriv2(double /*t*/, double vc, double i, double ve, double &dx1, double &dx2) const {
+    // Sécurité : protéger contre division par 0
+    if (C_ == 0.0 || L_ == 0.0) {
+        dx1 = 0.0;
+        dx2 = 0.0;
+        return;
+    }
+
+    dx1 = i / C_;                         // dvc/dt = i / C
+    dx2 = (ve - R_ * i - vc) / L_;        // di/dt = (ve - R*i - vc) / L
+}
+
+// Circuit RLC parallèle : x1 = vc, x2 = i (courant dans l'inductance)
+inline void CircuitD::deriv2(double /*t*/, double vc, double i, double ve, double &dx1, double &dx2) const {
+    if (C_ == 0.0 || L_ == 0.0 || R_ == 0.0) {
+        dx1 = 0.0;
+        dx2 = 0.0;
+        return;
+    }
+
+    dx1 = (i - vc / R_) / C_;   // dvc/dt
+    dx2 = (ve - vc) / L_;       // di/dt
+}
+
+// Jacobiens analytiques (constants pour A, C, D ; pour B, conductance de la
+// diode et de R1 en série au point courant)
+
+inline double CircuitA::jacobien1(double /*t*/, double /*vs*/, double /*ve*/, double /*extra*/) const {
+    return -1.0 / (R_ * C_);
+}
+
+inline double CircuitB::jacobien1(double /*t*/, double vs, double ve, double extra) const {
+    double R2 = extra;
+    if (diode_.shockley) {
+        double g;
+        courantDiode(ve - vs, g);
+        return -(g + 1.0 / R2) / C_;
+    }
+    double vBE = 0.6;
+    if (ve > vBE) {
+        return - (1.0/(R_ * C_) + 1.0/(R2 * C_));
+    } else {
+        return - 1.0/(R2 * C_);
+    }
+}
+
+inline void CircuitC::jacobien2(double /*t*/, double /*vc*/, double /*i*/, double /*ve*/,
+                                double &j11, double &j12, double &j21, double &j22) const {
+    if (C_ == 0.0 || L_ == 0.0) {
+        j11 = j12 = j21 = j22 = 0.0;
+        return;
+    }
+    j11 = 0.0;          j12 = 1.0 / C_;
+    j21 = -1.0 / L_;    j22 = -R_ / L_;
+}
+
+inline void CircuitD::jacobien2(double /*t*/, double /*vc*/, double /*i*/, double /*ve*/,
+                                double &j11, double &j12, double &j21, double &j22) const {
+    if (C_ == 0.0 || L_ == 0.0 || R_ == 0.0) {
+        j11 = j12 = j21 = j22 = 0.0;
+        return;
+    }
+    j11 = -1.0 / (R_ * C_);  j12 = 1.0 / C_;
+    j21 = -1.0 / L_;         j22 = 0.0;
+}
+
 #endif
 
 
@@ -0,0 +1,67 @@
+#ifndef DECIMATEUR_HPP
+#define DECIMATEUR_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Réduction d'un signal (t, Vin, Vout) à au plus `cible` points pour le tracé,
+// en un seul passage au fil de la simulation (mémoire : un ou deux seaux).
+//   - Mode::MinMax : par seau, les échantillons extrêmes de Vout et de Vin
+//     (4 points au plus, moins s'ils coïncident) ; les pics (diode,
+//     oscillations RLC) sont conservés.
+//   - Mode::Lttb   : Largest-Triangle-Three-Buckets sur Vout, un point par
+//     seau, celui qui forme le plus grand triangle avec le point retenu
+//     précédent et la moyenne du seau suivant.
+// Le premier et le dernier échantillon sont toujours gardés.
+
+class Decimateur {
+public:
+    enum class Mode { MinMax, Lttb };
+
+    struct Point {
+        std::size_t indice;
+        double t, vin, vout;
+    };
+
+    // n : nombre d'échantillons attendus (npas + 1)
+    Decimateur(std::size_t n, std::size_t cible, Mode mode = Mode::MinMax);
+
+    // Échantillons dans l'ordre, numérotés implicitement 0, 1, 2, ...
+    void ajouter(double t, double vin, double vout);
+    // Traite les derniers seaux ; à appeler après le dernier ajouter()
+    void terminer();
+
+    const std::vector<Point>& points() const { return points_; }
+
+    // Écrit la trace en CSV "temps,Vin,Vout" (temps = indice * dt si dt > 0)
+    bool ecrire(const std::string& chemin, double dt) const;
+
+private:
+    Mode mode_;
+    double largeurSeau_;            // échantillons par seau (réel pour LTTB)
+    std::size_t finSeau_;           // premier indice du seau suivant
+    std::size_t numeroSeau_ = 0;
+    std::size_t suivant_ = 0;       // indice du prochain échantillon
+    bool toutGarder_;
+    bool termine_ = false;
+
+    Point dernier_{};               // échantillon le plus récent, pas encore classé
+    std::vector<Point> points_;
+
+    // MinMax : extrêmes du seau courant
+    Point minVout_{}, maxVout_{}, minVin_{}, maxVin_{};
+    bool seauVide_ = true;
+
+    // LTTB : seau dont on choisit le point, seau en cours de remplissage
+    std::vector<Point> candidats_;
+    std::vector<Point> courant_;
+
+    void garder(const Point& p);
+    void classer(const Point& p);
+    void fermerSeau();
+    void choisir(const std::vector<Point>& seau, double ts, double vs);
+    void avancerFinSeau();
+};
+
+#endif // DECIMATEUR_HPP
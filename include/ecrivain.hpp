@@ -0,0 +1,126 @@
+#ifndef ECRIVAIN_HPP
+#define ECRIVAIN_HPP
+
+#include "emetteur_csv.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+class Colonnes;
+class Decimateur;
+class FluxTrames;
+class SortieBinaire;
+
+// Écriture asynchrone des échantillons (t, Vin, Vout).
+// L'intégrateur range les échantillons dans de gros paquets préalloués ; un
+// thread d'écriture les formate en CSV (EmetteurCsv) et fait de grandes écritures
+// séquentielles. Le nombre de paquets est borné : si le disque ne suit pas,
+// ajouter() attend qu'un paquet soit rendu (contre-pression) et ce temps
+// d'attente est mesuré. Aucun flush par ligne.
+// Avec une SortieBinaire, le thread d'écriture range les paquets directement
+// dans les colonnes projetées au lieu de formater du CSV ; avec un FluxTrames,
+// chaque paquet part en une trame binaire sur stdout.
+
+class EcrivainAsynchrone {
+public:
+    struct Echantillon {
+        double t, vin, vout;
+    };
+
+    // La sortie n'est plus touchée par l'appelant jusqu'à terminer().
+    // Si format.pasFixe(), le temps de l'échantillon i est écrit comme i * dt.
+    explicit EcrivainAsynchrone(std::ostream& sortie, const EmetteurCsv& format = EmetteurCsv(),
+                                std::size_t echantillonsParPaquet = 8192,
+                                std::size_t nombrePaquets = 4);
+    // Sortie binaire déjà ouverte ; fermée par l'appelant après terminer()
+    explicit EcrivainAsynchrone(SortieBinaire& sortie, std::size_t echantillonsParPaquet = 8192,
+                                std::size_t nombrePaquets = 4);
+    // Flux de trames déjà ouvert (en-tête envoyé) ; terminé par l'appelant
+    explicit EcrivainAsynchrone(FluxTrames& sortie, std::size_t echantillonsParPaquet = 8192,
+                                std::size_t nombrePaquets = 4);
+    ~EcrivainAsynchrone();
+
+    EcrivainAsynchrone(const EcrivainAsynchrone&) = delete;
+    EcrivainAsynchrone& operator=(const EcrivainAsynchrone&) = delete;
+
+    // Ajoute un échantillon (appelé à chaque pas par l'intégrateur)
+    void ajouter(double t, double vin, double vout) {
+        courant_->donnees[courant_->n++] = {t, vin, vout};
+        if (courant_->n == capacite_) {
+            envoyer();
+        }
+    }
+
+    // Trace réduite pour le tracé, alimentée par le thread d'écriture au fil
+    // des paquets ; à fixer avant le premier ajouter()
+    void fixerTrace(Decimateur& trace) { trace_ = &trace; }
+
+    // Copie des échantillons dans des colonnes allouées par l'appelant (au
+    // plus leur capacité), remplie par le thread d'écriture au fil des
+    // paquets : le cache du serveur se remplit pendant la diffusion. Taille
+    // remise à 0 ; à fixer avant le premier ajouter()
+    void fixerCopie(Colonnes& copie);
+
+    // Indice du premier échantillon (reprise d'une simulation : temps i * dt
+    // du CSV à pas fixe) ; à fixer avant le premier ajouter()
+    void fixerPremierIndice(std::size_t indice) { lignes_ = indice; }
+
+    // Envoie le paquet courant, même incomplet ; action() est exécutée par le
+    // thread d'écriture juste après avoir écrit ce paquet, donc quand tous les
+    // échantillons ajoutés avant l'appel sont dans la sortie (point de reprise)
+    void jalon(std::function<void()> action);
+
+    // Écrit le dernier paquet, attend le thread d'écriture et vide la sortie
+    void terminer();
+
+    // Temps passé par l'intégrateur à attendre un paquet libre (s)
+    double attenteIntegrateur() const { return attente_; }
+    // Temps de formatage + écriture sur le thread d'écriture (s)
+    double dureeEcriture() const { return ecriture_; }
+    std::size_t octetsEcrits() const { return octets_; }
+    std::size_t paquetsEcrits() const { return paquetsEcrits_; }
+
+private:
+    struct Paquet {
+        std::vector<Echantillon> donnees;
+        std::size_t n = 0;
+        std::function<void()> apres;    // jalon, exécuté une fois le paquet écrit
+    };
+
+    std::ostream* texte_ = nullptr;     // CSV
+    EmetteurCsv format_;                // utilisé par le thread d'écriture seulement
+    std::size_t lignes_ = 0;            // idem
+    Decimateur* trace_ = nullptr;       // idem, optionnel
+    Colonnes* copie_ = nullptr;         // idem, optionnel
+    SortieBinaire* binaire_ = nullptr;  // ou colonnes binaires
+    FluxTrames* flux_ = nullptr;        // ou trames sur stdout
+    std::size_t capacite_;
+    std::vector<std::unique_ptr<Paquet>> paquets_;  // tous les paquets (propriétaire)
+    std::deque<Paquet*> libres_;
+    std::deque<Paquet*> pleins_;
+    Paquet* courant_ = nullptr;                     // rempli par l'intégrateur
+
+    std::mutex m_;
+    std::condition_variable cvLibre_;
+    std::condition_variable cvPlein_;
+    bool fin_ = false;
+    bool termine_ = false;
+    std::thread thread_;
+
+    double attente_ = 0.0;
+    double ecriture_ = 0.0;         // écrit par le thread d'écriture seulement
+    std::size_t octets_ = 0;        // idem
+    std::size_t paquetsEcrits_ = 0; // idem
+
+    void demarrer(std::size_t nombrePaquets);
+    void envoyer();
+    void boucleEcriture();
+};
+
+#endif // ECRIVAIN_HPP
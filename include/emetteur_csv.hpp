@@ -0,0 +1,55 @@
+#ifndef EMETTEUR_CSV_HPP
+#define EMETTEUR_CSV_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Formatage des lignes CSV "temps,Vin,Vout" avec std::to_chars dans un tampon
+// réutilisable (pas de flux, pas de locale, pas d'allocation par ligne).
+//   - Mode::Court : écriture la plus courte qui relit exactement le double ;
+//   - Mode::Fixe  : `precision` chiffres significatifs (comme "%.*g").
+// Avec fixerPas(dt), le temps de la ligne i est i * dt :
+//   - Mode::Fixe : i * dt calculé en double, `precision` chiffres comme les
+//     autres colonnes ;
+//   - Mode::Court : si dt est, à quelques ulp près, un décimal d'au plus 9
+//     chiffres (1e-06, ou 2.5e-11 pour tmax / npas = 5e-07 / 20000), produit
+//     exact de i par ce décimal, arrondi à 17 chiffres significatifs : pas de
+//     2.9999999999999997e-06 pour le 3e pas de 1e-06. Sinon, écriture la plus
+//     courte de i * dt sur toutes les lignes : une seule forme par colonne.
+
+class EmetteurCsv {
+public:
+    enum class Mode { Court, Fixe };
+
+    explicit EmetteurCsv(Mode mode = Mode::Court, int precision = 17);
+
+    // Temps écrits sous forme indice * dt (dt > 0)
+    void fixerPas(double dt);
+    bool pasFixe() const { return pas_ > 0.0; }
+
+    // Ligne dont le temps est formaté comme une valeur
+    void ligne(double t, double vin, double vout);
+    // Ligne numéro i : temps = i * dt exact (fixerPas requis)
+    void ligneIndice(std::size_t i, double vin, double vout);
+
+    const char* donnees() const { return tampon_.data(); }
+    std::size_t taille() const { return taille_; }
+    void vider() { taille_ = 0; }
+
+private:
+    Mode mode_;
+    int precision_;
+    double pas_ = 0.0;
+    bool pasExact_ = false;             // temps en produit décimal exact
+    std::uint64_t mantissePas_ = 0;     // dt = mantissePas_ * 10^exposantPas_
+    int exposantPas_ = 0;
+    std::vector<char> tampon_;
+    std::size_t taille_ = 0;
+
+    char* reserver();
+    char* valeur(char* p, double v) const;
+    char* temps(char* p, std::size_t i) const;
+};
+
+#endif // EMETTEUR_CSV_HPP
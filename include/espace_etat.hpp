@@ -0,0 +1,92 @@
+#ifndef ESPACE_ETAT_HPP
+#define ESPACE_ETAT_HPP
+
+#include "circuit.hpp"
+#include "ecrivain.hpp"
+#include "source.hpp"
+#include <istream>
+#include <string>
+#include <vector>
+
+// Circuits linéaires d'ordre quelconque sous forme d'état :
+//   dx/dt = A x + B ve        Vout = C x + D ve
+// Circuit ne connaît que les ordres 1 et 2 (deriv1, deriv2) ; CircuitEtat
+// décrit les filtres d'ordre supérieur (cellules RLC en cascade, échelles).
+// Usage : be-sim --etat [cle=valeur ...]
+// Clés : celles de be-sim --serveur (circuit, source, A, f, duty, offset,
+// t0, R, C, L, methode, npas, tmax), plus :
+//   modele=circuit|echelle|rlc   circuit : A, C ou D de la clé circuit ;
+//                                echelle : cellules R série, C parallèle ;
+//                                rlc : cellules R et L série, C parallèle
+//                                (défaut circuit)
+//   sections=N                   cellules d'echelle et rlc (défaut 4)
+//   fichier=chemin               matrices lues dans un fichier (lireCircuitEtat)
+//   sortie=chemin.csv            (défaut resultats/etat/etat.csv)
+// Méthodes à pas fixe, même numérotation que le menu : 1 Euler (RK4 dès
+// l'ordre 2, comme le menu), 2 Euler, 3 RK4, 4 Heun, 6 Euler implicite,
+// 7 trapèzes, 8 BDF2, 9 automatique, 10 exacte ; mêmes conventions que
+// statique::boucle (lignes (t_i, Vin(t_i), Vout(t_i+1)), pas coupés sur les
+// fronts de la source).
+//
+// Les méthodes explicites évaluent A x avec les noyaux de noyaux_etat.hpp.
+// Le système étant linéaire, un pas des méthodes 6, 7, 8 et 10 est une
+// application affine x+ = M z, z = (x, valeurs de la source) : M est
+// calculée une fois par longueur de pas et chaque pas se réduit à un seul
+// produit matrice-vecteur.
+
+class CircuitEtat {
+public:
+    // a : n x n ligne par ligne, b et c : n valeurs. false (avec un message)
+    // si les tailles ne concordent pas
+    bool definir(int n, const std::vector<double>& a, const std::vector<double>& b,
+                 const std::vector<double>& c, double d, std::string& erreur);
+
+    int ordre() const { return n_; }
+    int hauteur() const { return h_; }
+
+    // Matrices rangées colonne par colonne, hauteur() valeurs par colonne
+    // (lignes de bourrage nulles)
+    const double* a() const { return a_.data(); }
+    const double* b() const { return b_.data(); }
+    const double* c() const { return c_.data(); }
+    double d() const { return d_; }
+    double a(int i, int j) const { return a_[static_cast<std::size_t>(j) * h_ + i]; }
+
+private:
+    int n_ = 0, h_ = 0;
+    std::vector<double> a_, b_, c_;
+    double d_ = 0.0;
+};
+
+// Modèle d'état d'un circuit linéaire d'ordre 1 ou 2 (A, C, D), lu comme
+// pour la méthode exacte : A = jacobien, B = réponse des dérivées à ve,
+// sortie x1. false (avec un message) pour un circuit non linéaire
+bool modeleCircuit(const Circuit& circuit, double R2, CircuitEtat& e, std::string& erreur);
+
+// Échelle de n cellules (R série, C parallèle) : états v1..vn, sortie vn.
+// n = 1 : circuit A
+void modeleEchelle(int sections, double R, double C, CircuitEtat& e);
+
+// n cellules (R et L série, C parallèle) : états (v1, i1, ..., vn, in),
+// sortie vn. n = 1 : circuit C
+void modeleRLC(int sections, double R, double L, double C, CircuitEtat& e);
+
+// Fichier de matrices : mots-clés A, B, C, D (casse indifférente) chacun
+// suivi de ses valeurs, ligne par ligne ; '#' : commentaire. n est le
+// nombre de valeurs de B ; A en compte n x n, C n, D une (absent : 0).
+bool lireCircuitEtat(std::istream& entree, const std::string& nom, CircuitEtat& e,
+                     std::string& erreur);
+
+// Simulation depuis l'état nul ; false (avec un message) si la méthode
+// n'est pas à pas fixe
+bool simulerEtat(const CircuitEtat& circuit, const Source& source, int choixMeth, int npas,
+                 double dt, EcrivainAsynchrone& ecrivain, std::string& erreur);
+
+// Même simulation, échantillons rangés dans trois tableaux de npas + 1 valeurs
+bool simulerEtat(const CircuitEtat& circuit, const Source& source, int choixMeth, int npas,
+                 double dt, double* temps, double* vin, double* vout, std::string& erreur);
+
+// Point d'entrée du mode modèle d'état (main.cpp)
+int lancerEtat(int argc, char** argv);
+
+#endif // ESPACE_ETAT_HPP
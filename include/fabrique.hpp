@@ -0,0 +1,22 @@
+#ifndef FABRIQUE_HPP
+#define FABRIQUE_HPP
+
+#include <memory>
+#include "circuit.hpp"
+#include "source.hpp"
+
+// Construction non interactive des circuits et des sources, à partir des mêmes
+// choix que les menus de main.cpp et initialiserSource() : utilisée par les
+// modes sans saisie clavier (balayage, ...).
+
+// type : 'A', 'B', 'C' ou 'D' (défaut A). R2 et diode ne servent qu'au
+// circuit B, L qu'à C et D. afficher = false : pas de message de création
+std::unique_ptr<Circuit> creerCircuit(char type, double R, double R2, double C, double L,
+                                      double f, bool afficher = false,
+                                      const ParametresDiode& diode = ParametresDiode());
+
+// typeSource : 1 Sinus, 2 Echelon, 3 Triangulaire, 4 Creneau, 5 Rectangulaire (défaut Sinus)
+std::unique_ptr<Source> creerSource(int typeSource, double A, double f, double dutyCycle,
+                                    double offset, double startTime = 0.0);
+
+#endif // FABRIQUE_HPP
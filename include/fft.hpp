@@ -0,0 +1,59 @@
+#ifndef FFT_HPP
+#define FFT_HPP
+
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+// Transformée de Fourier discrète rapide, toute longueur n >= 1 :
+//   X[k] = somme_j x[j] exp(-2iπ jk / n)
+// Cooley-Tukey à base mixte (décimation temporelle, hors place) : les
+// facteurs 4, 2, 3 et 5 ont des papillons dédiés, tout autre facteur premier
+// p une DFT directe de longueur p (coût n*p : une longueur à grand facteur
+// premier reste correcte mais lente). Le plan précalcule la factorisation et
+// les racines de l'unité ; transformer() est const et réentrant.
+
+class PlanFFT {
+public:
+    explicit PlanFFT(std::size_t n);
+
+    std::size_t taille() const { return n_; }
+
+    // sortie[k] = X[k], k = 0..n-1 ; entree et sortie distinctes
+    void transformer(const std::complex<double>* entree, std::complex<double>* sortie) const;
+
+private:
+    std::size_t n_;
+    std::vector<std::size_t> facteurs_;             // (p, m) : base puis longueur restante
+    std::vector<std::complex<double>> racines_;     // exp(-2iπ k / n), k = 0..n-1
+
+    void etape(std::complex<double>* sortie, const std::complex<double>* entree, std::size_t pas,
+               const std::size_t* facteur) const;
+    void papillon2(std::complex<double>* f, std::size_t pas, std::size_t m) const;
+    void papillon3(std::complex<double>* f, std::size_t pas, std::size_t m) const;
+    void papillon4(std::complex<double>* f, std::size_t pas, std::size_t m) const;
+    void papillon5(std::complex<double>* f, std::size_t pas, std::size_t m) const;
+    void papillonGenerique(std::complex<double>* f, std::size_t pas, std::size_t m,
+                           std::size_t p) const;
+};
+
+// Signal réel : seule la moitié X[0..n/2] est calculée (X[n-k] = conj X[k]).
+// n pair : FFT complexe de longueur n/2 sur les paires (x[2j], x[2j+1])
+// puis séparation des deux demi-spectres, deux fois moins de calcul ;
+// n impair : FFT complexe de longueur n.
+class PlanFFTReelle {
+public:
+    explicit PlanFFTReelle(std::size_t n);
+
+    std::size_t taille() const { return n_; }
+
+    // sortie[k] = X[k], k = 0..n/2
+    void transformer(const double* entree, std::complex<double>* sortie) const;
+
+private:
+    std::size_t n_;
+    PlanFFT plan_;                                  // longueur n/2 (pair) ou n
+    std::vector<std::complex<double>> separation_;  // exp(-2iπ k / n), k = 0..n/2
+};
+
+#endif // FFT_HPP
@@ -0,0 +1,64 @@
+#ifndef FLUX_TRAMES_HPP
+#define FLUX_TRAMES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+class Decimateur;
+
+// Sortie en flux de trames binaires (be-sim --flux), écrite sur stdout au fil
+// de l'intégration : aucun fichier intermédiaire, le lecteur peut tracer au
+// fur et à mesure. Chaque trame :
+//   type   : 4 octets ASCII
+//   taille : uint32 little-endian, nombre d'octets du contenu
+//   contenu
+// Types :
+//   "ENTE" en-tête, texte "cle=valeur\n" (n, colonnes, paramètres)
+//   "ECHA" bloc d'échantillons : uint64 premier indice, uint64 nombre m,
+//          puis m float64 temps, m float64 Vin, m float64 Vout (little-endian)
+//   "TRAC" trace réduite pour le tracé (--trace=N), même contenu que ECHA
+//          (premier indice 0, temps non uniformes)
+//   "RESU" résumé final, texte "cle=valeur\n" ; toujours la dernière trame
+
+class FluxTrames {
+public:
+    using Parametres = std::vector<std::pair<std::string, std::string>>;
+
+    explicit FluxTrames(std::FILE* sortie = stdout) : sortie_(sortie) {}
+
+    // Envoie l'en-tête ; false (avec un message) si le format n'est pas
+    // utilisable sur cette machine
+    bool ouvrir(std::size_t n, const Parametres& parametres);
+
+    void ajouter(double t, double vin, double vout) {
+        t_.push_back(t);
+        vin_.push_back(vin);
+        vout_.push_back(vout);
+    }
+
+    // Envoie les échantillons accumulés dans une trame "ECHA"
+    void envoyerBloc();
+    void envoyerTrace(const Decimateur& trace);
+    void terminer(const Parametres& resume);
+
+    std::size_t trames() const { return trames_; }
+    std::size_t octets() const { return octets_; }
+
+private:
+    std::FILE* sortie_;
+    std::vector<double> t_, vin_, vout_;
+    std::uint64_t premier_ = 0;         // indice du premier échantillon du bloc
+    std::size_t trames_ = 0;
+    std::size_t octets_ = 0;
+
+    void trame(const char* type, const std::vector<std::pair<const void*, std::size_t>>& morceaux);
+    void trameColonnes(const char* type, std::uint64_t premier, const std::vector<double>& t,
+                       const std::vector<double>& vin, const std::vector<double>& vout);
+    void trameTexte(const char* type, const std::string& texte);
+};
+
+#endif // FLUX_TRAMES_HPP
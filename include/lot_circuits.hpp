@@ -0,0 +1,96 @@
+#ifndef LOT_CIRCUITS_HPP
+#define LOT_CIRCUITS_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "circuit.hpp"
+#include "noyaux_lot.hpp"
+#include "source.hpp"
+
+// Moteur "lot" : N instances d'une même topologie (A, B, C ou D) avec des
+// valeurs R, C, L (et R2 pour B) différentes, intégrées ensemble.
+// Paramètres et états sont stockés en structure-of-arrays ; chaque pas avance
+// toutes les instances avec les noyaux AVX-512 / AVX2 / scalaire (noyaux_lot.hpp).
+// Toutes les instances partagent la même source : ve(t) est calculé une fois par
+// étage pour tout le lot.
+// Circuit B : diode idéale de seuil 0,6 V (défaut de CircuitB) ; le modèle
+// de Shockley, choisi avec diode=shockley, n'est pas pris en charge, voir
+// LotCircuits::accepte.
+// Un pas qui touche une discontinuité de la source est coupé en sous-pas qui
+// s'arrêtent exactement sur elle, comme statique::pasCoupe : même résultat,
+// aux arrondis près, que simulerStatique instance par instance (méthodes 1 à
+// 4). Mesuré et vérifié par be-sim --banc (cas lot/...).
+
+// Jeu d'instructions utilisé par les noyaux
+enum class JeuInstructions { Auto, Scalaire, AVX2, AVX512 };
+
+// Le jeu d'instructions est-il disponible sur ce processeur ?
+bool jeuDisponible(JeuInstructions jeu);
+
+class LotCircuits {
+public:
+    // typeCircuit : 'A', 'B', 'C' ou 'D' ; toutes les instances valent R=1000, C=1e-6, L=1e-3, R2=1000
+    LotCircuits(char typeCircuit, std::size_t nInstances);
+
+    // Le lot sait-il intégrer ce circuit ? false (avec un message) pour le
+    // circuit B avec le modèle de diode de Shockley
+    static bool accepte(char typeCircuit, const ParametresDiode& diode, std::string& erreur);
+
+    // Paramètres de l'instance i (L ignoré pour A/B, R2 utilisé pour B seulement)
+    void definirInstance(std::size_t i, double R, double C, double L, double R2 = 1000.0);
+
+    // Remet tous les états à 0 et le temps à t=0
+    void reinitialiser();
+
+    // Avance tout le lot de npas pas de dt avec la méthode choixMeth
+    // (même numérotation que le menu de main.cpp, 1 à 4 seulement). Les appels
+    // successifs jusqu'à reinitialiser() doivent passer la même source.
+    void avancer(const Source& source, int choixMeth, double dt, int npas);
+
+    // Choix du jeu d'instructions (Auto = le plus large supporté par le processeur)
+    void choisirJeuInstructions(JeuInstructions jeu);
+    JeuInstructions jeuInstructions() const { return jeu_; }
+    static const char* nomJeuInstructions(JeuInstructions jeu);
+
+    // Accès aux résultats
+    std::size_t taille() const { return n_; }
+    int order() const { return (type_ == 'A' || type_ == 'B') ? 1 : 2; }
+    double x1(std::size_t i) const { return x1_[i]; }
+    double x2(std::size_t i) const { return x2_[i]; }
+    double temps() const { return t_; }
+
+private:
+    char type_;
+    std::size_t n_;         // nombre d'instances
+    std::size_t nVoies_;    // n_ arrondi au multiple de 8 (voies de bourrage à coefficients nuls)
+    JeuInstructions jeu_;
+    double t_;
+
+    // Intervalle régulier courant de la source (statique::boucle)
+    bool segmentConnu_ = false;
+    double debutSeg_ = 0.0, finSeg_ = 0.0;
+
+    // États
+    std::vector<double> x1_, x2_;
+
+    // Coefficients précalculés (voir VueLot)
+    std::vector<double> a11_, a12_, a21_, a22_, b1_, b2_, g1_, g2_;
+
+    // Tampon des valeurs de la source : 3 valeurs par pas
+    std::vector<double> ve_;
+    // Source aux instants t + k*dt/2 du bloc (Source::remplir)
+    std::vector<double> demiPas_;
+
+    VueLot vue();
+
+    // nPas pas de dt sur tout le lot ; ve : 3 valeurs de la source par pas
+    void executer(const VueLot& v, NoyauLot noyau, int etages, const double* ve,
+                  std::size_t nPas, double dt);
+
+    // Pas [t, t+dt] coupé sur les fronts de la source (statique::pasCoupe)
+    void pasCoupe(const Source& source, const VueLot& v, NoyauLot noyau, int etages,
+                  double t, double dt);
+};
+
+#endif // LOT_CIRCUITS_HPP
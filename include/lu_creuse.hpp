@@ -0,0 +1,59 @@
+#ifndef LU_CREUSE_HPP
+#define LU_CREUSE_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Matrice creuse carrée au format colonnes compressées (CSC). Le motif est
+// fixé une fois (construireMotif) ; les valeurs sont ensuite réécrites en
+// place à chaque assemblage, par leur position dans valeurs.
+struct MatriceCreuse {
+    int n = 0;
+    std::vector<int> debut;         // colonne j : entrées debut[j] à debut[j+1]-1
+    std::vector<int> lignes;        // triées dans chaque colonne
+    std::vector<double> valeurs;
+
+    // Motif des paires (ligne, colonne) données, doublons fusionnés ; valeurs à 0
+    void construireMotif(int taille, std::vector<std::pair<int, int>> entrees);
+    // Position de (i, j) dans valeurs, -1 si l'entrée n'est pas dans le motif
+    int position(int i, int j) const;
+    std::size_t nonNuls() const { return lignes.size(); }
+};
+
+// Factorisation LU creuse P A Q = L U, gauche-droite (Gilbert-Peierls) :
+//   - analyser() : ordre des colonnes Q par degré minimum sur le motif de
+//     A + Aᵀ (limite le remplissage), une fois pour toutes ;
+//   - factoriser() : pivotage partiel avec préférence pour la diagonale
+//     (seuil 0,1), qui fixe l'ordre des pivots P et le motif de L et de U ;
+//   - refactoriser() : mêmes pivots, même motif, valeurs seules, sans
+//     recherche de pivot ni parcours de graphe. C'est le cas de chaque pas
+//     d'une simulation : seules les valeurs changent. Retourne false si un
+//     pivot devient trop petit ; l'appelant refait alors factoriser().
+class LUCreuse {
+public:
+    void analyser(const MatriceCreuse& a);
+    bool factoriser(const MatriceCreuse& a);
+    bool refactoriser(const MatriceCreuse& a);
+    bool factorisee() const { return factorisee_; }
+
+    // x <- A⁻¹ x
+    void resoudre(double* x) const;
+
+    std::size_t nonNulsL() const { return li_.size(); }
+    std::size_t nonNulsU() const { return ui_.size(); }
+
+private:
+    int n_ = 0;
+    bool factorisee_ = false;
+    std::vector<int> q_;            // colonne k de LU : colonne q_[k] de A
+    std::vector<int> pinv_;         // ligne i de A : ligne pinv_[i] de LU
+    // L unitaire (diagonale en tête de colonne), U (diagonale en fin de
+    // colonne, autres lignes croissantes) ; lignes en numérotation des pivots
+    std::vector<int> lp_, li_, up_, ui_;
+    std::vector<double> lx_, ux_;
+    std::vector<double> travail_;           // colonne en cours (refactoriser), nulle entre deux appels
+    mutable std::vector<double> solution_;  // second membre permuté (resoudre)
+};
+
+#endif // LU_CREUSE_HPP
@@ -0,0 +1,131 @@
+#ifndef NETLIST_HPP
+#define NETLIST_HPP
+
+#include "lu_creuse.hpp"
+#include "source.hpp"
+#include <functional>
+#include <istream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Circuits décrits par une netlist (format proche de SPICE) et simulés par
+// analyse nodale modifiée (MNA), sans classe C++ par topologie.
+// Usage : be-sim --netlist fichier.cir [cle=valeur ...]
+//   methode=6|7           Euler implicite ou trapèzes (défaut 7)
+//   npas=N, tmax=T        grille de sortie (défaut : directive .tran)
+//   noeud=nom             nœud écrit comme Vout (défaut : directive .sortie, sinon out)
+//   sortie=chemin.csv     colonnes temps, Vin, Vout (défaut resultats/netlist/<fichier>.csv)
+//   toute autre clé       remplace le .param du même nom (R=2k, f=1e3, ...)
+//
+// Lignes de la netlist (casse indifférente, '*' en tête : commentaire,
+// ';' : fin de ligne ignorée ; nœud 0 ou gnd : masse) :
+//   Rnom n1 n2 valeur                 résistance (Ω)
+//   Cnom n1 n2 valeur                 condensateur (F), chargé à 0 V à t = 0
+//   Lnom n1 n2 valeur                 inductance (H), courant nul à t = 0
+//   Dnom anode cathode [Is=1e-14] [N=1] [Vt=0.025852]   diode de Shockley
+//   Vnom n+ n- type [A=5] [f=50] [duty=0.5] [offset=0] [t0=0]
+//                                     source de tension : type sinus,
+//                                     echelon, triangle, creneau, rectangle
+//                                     (ou 1 à 5, numérotation du menu)
+//   .param nom=valeur ...             paramètres, utilisés sous la forme {nom}
+//   .tran pas fin                     npas = fin / pas, tmax = fin
+//   .sortie nœud                      nœud de sortie
+// Valeurs : nombre avec suffixe SPICE éventuel (f p n u m k meg g t).
+// Vin est la tension de la première source déclarée. Exemples : netlists/
+// (circuits A à D).
+//
+// Inconnues : tensions des nœuds, puis un courant de branche par source,
+// condensateur et inductance. Chaque pas résout A x = b ; le motif de A est
+// fixe, seules ses valeurs changent (pas coupé sur un front, linéarisation
+// des diodes). LUCreuse calcule l'ordre des colonnes et des pivots au premier
+// pas et ne refait ensuite que la partie numérique ; un circuit linéaire à
+// pas constant garde la même factorisation d'un pas à l'autre.
+
+struct ElementNetlist {
+    char type = 'R';                // R, C, L, D ou V
+    std::string nom;
+    int a = -1, b = -1;             // inconnues des deux nœuds (-1 : masse)
+    int branche = -1;               // inconnue du courant de a vers b (V, C, L)
+    double valeur = 0.0;            // R (Ω), C (F), L (H), Is de la diode (A)
+    double n = 1.0, vt = 0.025852;  // diode : facteur d'idéalité, tension thermique
+    std::shared_ptr<Source> source; // V
+};
+
+struct Netlist {
+    std::vector<std::string> noeuds;        // nom du nœud de l'inconnue i
+    std::vector<ElementNetlist> elements;
+    std::string sortie = "out";             // .sortie
+    double pas = 0.0, fin = 0.0;            // .tran (0 : absente)
+};
+
+// Lecture d'une netlist ; nom sert aux messages (nom:ligne). parametres
+// remplace les valeurs des .param de même nom. false (avec un message) si
+// une ligne est invalide
+bool lireNetlist(std::istream& entree, const std::string& nom,
+                 const std::map<std::string, std::string>& parametres, Netlist& netlist,
+                 std::string& erreur);
+
+class CircuitMNA {
+public:
+    // false (avec un message) sans source de tension ou si le nœud de sortie n'existe pas
+    bool construire(Netlist netlist, std::string& erreur);
+
+    // Transitoire à pas fixe depuis l'état nul, méthode 6 (Euler implicite)
+    // ou 7 (trapèzes). Mêmes conventions que statique::boucle : npas + 1
+    // lignes sortie(t_i, Vin(t_i), Vout(t_i+1)), pas coupés sur les fronts
+    // des sources. Aux trapèzes, le pas qui suit t = 0 et chaque front part
+    // de courants cohérents, ou est fait en Euler implicite si le circuit ne
+    // permet pas de les calculer (condensateur en parallèle sur une source).
+    // false (avec un message) si la matrice est singulière ou si Newton ne
+    // converge pas
+    bool simuler(int methode, int npas, double dt,
+                 const std::function<void(double, double, double)>& sortie, std::string& erreur);
+
+    int inconnues() const { return n_; }
+    std::size_t nonNulsA() const { return a_.nonNuls(); }
+    std::size_t nonNulsLU() const { return luPas_.nonNulsL() + luPas_.nonNulsU(); }
+
+    // Compteurs de la dernière simulation
+    long factorisations = 0;        // complètes (recherche des pivots)
+    long refactorisations = 0;      // numériques seules
+    long resolutions = 0;           // itérations de Newton comprises
+
+private:
+    enum class Mode { Initial, Pas };
+
+    Netlist netlist_;
+    int n_ = 0;
+    int sortie_ = -1;               // inconnue de Vout (-1 : masse)
+    bool lineaire_ = true;
+    MatriceCreuse a_;
+    LUCreuse luInitial_, luPas_;    // deux jeux de pivots : un par forme de la matrice
+    bool initialFactorise_ = false; // circuit linéaire : factorisations encore valables
+    double alphaFactorise_ = 0.0;   // coefficient des modèles compagnons factorisé
+    std::vector<double> x_, b_;
+
+    // Positions des entrées de chaque élément dans a_.valeurs (-1 : masse)
+    struct Positions {
+        int aa = -1, ab = -1, ba = -1, bb = -1;     // conductance (R, D)
+        int ak = -1, bk = -1, ka = -1, kb = -1, kk = -1;   // branche k
+    };
+    std::vector<Positions> positions_;
+    // Historique : tension et courant de chaque condensateur et inductance
+    // au début du pas ; tension de chaque diode (linéarisation de Newton)
+    std::vector<double> tension_, courant_;
+    // Intervalle régulier courant de chaque source (coupure sur les fronts)
+    std::vector<double> debutSeg_, finSeg_;
+    double marge_ = 0.0;
+
+    double tensionElement(const std::vector<double>& x, const ElementNetlist& e) const;
+    double valeurSource(std::size_t element, double t) const;
+    void assembler(Mode mode, double alpha, double t, bool trapezes, bool matrice);
+    void mettreAJourHistorique();
+    bool resoudre(Mode mode, double h, double t, bool trapezes, std::string& erreur);
+};
+
+// Point d'entrée du mode netlist (main.cpp)
+int lancerNetlist(int argc, char** argv);
+
+#endif // NETLIST_HPP
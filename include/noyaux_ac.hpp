@@ -0,0 +1,46 @@
+#ifndef NOYAUX_AC_HPP
+#define NOYAUX_AC_HPP
+
+#include <cstddef>
+
+// Noyau de l'analyse AC (voir analyse_ac.hpp) : réponse d'une fonction de
+// transfert rationnelle H(s) = (n0 + n1 s + n2 s²) / (d0 + d1 s + d2 s²) en
+// s = jω, pour un tableau de pulsations. Inclus par les mêmes unités que
+// noyaux_lot.hpp (src/batch/lot_*.cpp), qui fournissent le type I.
+//
+// re[k] + j im[k] = H(j omega[k]), k = 0..n-1, n multiple de la largeur
+// maximale (8) : les tableaux sont complétés par l'appelant.
+void reponseLotScalaire(const double num[3], const double den[3], const double* omega,
+                        std::size_t n, double* re, double* im);
+void reponseLotAvx2(const double num[3], const double den[3], const double* omega,
+                    std::size_t n, double* re, double* im);
+void reponseLotAvx512(const double num[3], const double den[3], const double* omega,
+                      std::size_t n, double* re, double* im);
+
+namespace {
+
+// Évaluation des deux polynômes et division complexe, sans branche :
+// I::L pulsations par itération
+template <class I>
+void noyauReponse(const double num[3], const double den[3], const double* omega,
+                  std::size_t n, double* re, double* im) {
+    using V = typename I::V;
+    const V n0 = I::diffuser(num[0]), n1 = I::diffuser(num[1]), n2 = I::diffuser(num[2]);
+    const V d0 = I::diffuser(den[0]), d1 = I::diffuser(den[1]), d2 = I::diffuser(den[2]);
+    const V un = I::diffuser(1.0);
+
+    for (std::size_t j = 0; j < n; j += I::L) {
+        const V w = I::charger(omega + j);
+        const V w2 = w * w;
+        // N(jω) = (n0 - n2 ω²) + j n1 ω, de même pour D
+        const V nr = n0 - n2 * w2, ni = n1 * w;
+        const V dr = d0 - d2 * w2, di = d1 * w;
+        const V inverse = un / (dr * dr + di * di);
+        I::ranger(re + j, (nr * dr + ni * di) * inverse);
+        I::ranger(im + j, (ni * dr - nr * di) * inverse);
+    }
+}
+
+} // namespace
+
+#endif // NOYAUX_AC_HPP
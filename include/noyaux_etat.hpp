@@ -0,0 +1,59 @@
+#ifndef NOYAUX_ETAT_HPP
+#define NOYAUX_ETAT_HPP
+
+// Noyaux des modèles d'état (voir espace_etat.hpp) : produit d'une matrice
+// rangée colonne par colonne par un vecteur, y = Σ_j z[j] M(:, j).
+// Chaque colonne occupe hauteur(n) valeurs (n arrondi au multiple de 4, lignes
+// de bourrage nulles) : une colonne est lue d'un bloc, contigu, et y reste en
+// registres pendant tout le produit.
+
+namespace etat {
+
+// Hauteur d'une colonne (et taille des vecteurs d'état) pour n états
+constexpr int hauteur(int n) { return (n + 3) / 4 * 4; }
+
+// Tailles dont le noyau est spécialisé à la compilation (espace_etat.cpp)
+constexpr int ORDRE_MAX_SPECIALISE = 8;
+
+// H connu à la compilation : boucle interne entièrement déroulée et
+// vectorisée, accumulateurs en registres
+template <int H>
+inline void combiner(const double* __restrict m, int colonnes, const double* __restrict z,
+                     double* __restrict y) {
+    double acc[H] = {};
+    for (int j = 0; j < colonnes; ++j) {
+        const double zj = z[j];
+        const double* col = m + j * H;
+        for (int i = 0; i < H; ++i) acc[i] += col[i] * zj;
+    }
+    for (int i = 0; i < H; ++i) y[i] = acc[i];
+}
+
+// Hauteur quelconque : blocs de 8 lignes (puis 4) parcourant toutes les
+// colonnes, chaque bloc accumulé en registres
+inline void combiner(const double* __restrict m, int h, int colonnes, const double* __restrict z,
+                     double* __restrict y) {
+    int i0 = 0;
+    for (; i0 + 8 <= h; i0 += 8) {
+        double acc[8] = {};
+        for (int j = 0; j < colonnes; ++j) {
+            const double zj = z[j];
+            const double* col = m + static_cast<long>(j) * h + i0;
+            for (int i = 0; i < 8; ++i) acc[i] += col[i] * zj;
+        }
+        for (int i = 0; i < 8; ++i) y[i0 + i] = acc[i];
+    }
+    if (i0 < h) {   // h multiple de 4 : reste un bloc de 4 lignes
+        double acc[4] = {};
+        for (int j = 0; j < colonnes; ++j) {
+            const double zj = z[j];
+            const double* col = m + static_cast<long>(j) * h + i0;
+            for (int i = 0; i < 4; ++i) acc[i] += col[i] * zj;
+        }
+        for (int i = 0; i < 4; ++i) y[i0 + i] = acc[i];
+    }
+}
+
+} // namespace etat
+
+#endif // NOYAUX_ETAT_HPP
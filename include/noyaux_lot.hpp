@@ -0,0 +1,150 @@
+#ifndef NOYAUX_LOT_HPP
+#define NOYAUX_LOT_HPP
+
+#include <cstddef>
+
+// Noyaux de calcul du moteur "lot" (voir lot_circuits.hpp).
+// Ce header est inclus par une unité de compilation par jeu d'instructions
+// (src/batch/lot_scalaire.cpp, lot_avx2.cpp, lot_avx512.cpp). Chacune fournit
+// un type I décrivant ses registres :
+//   I::V                  type vectoriel (double pour la version scalaire)
+//   I::L                  nombre de voies par registre
+//   I::charger(p)         lecture de L doubles
+//   I::ranger(p, v)       écriture de L doubles
+//   I::diffuser(a)        a recopié dans toutes les voies
+//   I::siSup(a, b, x)     x dans les voies où a > b, 0 ailleurs (masque)
+// Le header ne contient que des templates dans un espace anonyme : aucune
+// fonction compilée avec un jeu d'instructions ne peut être partagée avec les
+// autres unités par l'éditeur de liens.
+
+// Vue sur les tableaux structure-of-arrays d'un LotCircuits.
+// Système linéaire : dx1 = a11*x1 + a12*x2 + b1*ve ; dx2 = a21*x1 + a22*x2 + b2*ve
+// Diode (CircuitB) : dx1 = -(m*g1 + g2)*x1 + m*g1*(ve - vSeuil), m = (ve > vSeuil)
+struct VueLot {
+    double* x1;
+    double* x2;
+    const double* a11;
+    const double* a12;
+    const double* a21;
+    const double* a22;
+    const double* b1;
+    const double* b2;
+    const double* g1;
+    const double* g2;
+    double vSeuil;
+    std::size_t n;      // nombre de voies, multiple de la largeur maximale (8)
+};
+
+// Forme des équations d'un lot
+enum class NoyauLot { Lineaire1, Lineaire2, Diode };
+
+// Avance toutes les voies de nPas pas de dt.
+// ve contient 3 valeurs de la source par pas : ve(t), ve(t+dt/2), ve(t+dt).
+// etages : 1 = Euler, 2 = Heun, 4 = RK4.
+void avancerLotScalaire(const VueLot& v, NoyauLot noyau, int etages,
+                        const double* ve, std::size_t nPas, double dt);
+void avancerLotAvx2(const VueLot& v, NoyauLot noyau, int etages,
+                    const double* ve, std::size_t nPas, double dt);
+void avancerLotAvx512(const VueLot& v, NoyauLot noyau, int etages,
+                      const double* ve, std::size_t nPas, double dt);
+
+namespace {
+
+// Noyau commun : l'état d'un bloc de I::L voies reste en registres pendant
+// les nPas pas ; seule la valeur de la source (commune à toutes les voies)
+// est relue à chaque étage.
+template <class I, NoyauLot forme, int etages>
+void noyauLot(const VueLot& v, const double* ve, std::size_t nPas, double dt) {
+    using V = typename I::V;
+    const V h = I::diffuser(dt);
+    const V demi = I::diffuser(0.5);
+    const V deux = I::diffuser(2.0);
+    const V sixieme = I::diffuser(1.0 / 6.0);
+    const V seuil = I::diffuser(v.vSeuil);
+
+    for (std::size_t j = 0; j < v.n; j += I::L) {
+        const V a11 = I::charger(v.a11 + j), a12 = I::charger(v.a12 + j);
+        const V a21 = I::charger(v.a21 + j), a22 = I::charger(v.a22 + j);
+        const V b1 = I::charger(v.b1 + j), b2 = I::charger(v.b2 + j);
+        const V g1 = I::charger(v.g1 + j), g2 = I::charger(v.g2 + j);
+        V x1 = I::charger(v.x1 + j);
+        V x2 = I::charger(v.x2 + j);
+
+        // Champ de vecteurs fusionné (dx1, dx2) pour un étage
+        auto f = [&](V y1, V y2, V e, V& d1, V& d2) {
+            if constexpr (forme == NoyauLot::Diode) {
+                // Branche de la diode traitée par masque, sans saut
+                V g1m = I::siSup(e, seuil, g1);
+                d1 = (e - seuil) * g1m - (g1m + g2) * y1;
+                d2 = I::diffuser(0.0);
+            } else if constexpr (forme == NoyauLot::Lineaire1) {
+                d1 = a11 * y1 + b1 * e;
+                d2 = I::diffuser(0.0);
+            } else {
+                d1 = a11 * y1 + a12 * y2 + b1 * e;
+                d2 = a21 * y1 + a22 * y2 + b2 * e;
+            }
+        };
+
+        for (std::size_t k = 0; k < nPas; ++k) {
+            const double* e = ve + 3 * k;
+            V d1, d2;
+            if constexpr (etages == 4) {
+                // Runge-Kutta 4
+                const V emi = I::diffuser(e[1]);
+                f(x1, x2, I::diffuser(e[0]), d1, d2);
+                V k1_1 = h * d1, k1_2 = h * d2;
+                f(x1 + demi * k1_1, x2 + demi * k1_2, emi, d1, d2);
+                V k2_1 = h * d1, k2_2 = h * d2;
+                f(x1 + demi * k2_1, x2 + demi * k2_2, emi, d1, d2);
+                V k3_1 = h * d1, k3_2 = h * d2;
+                f(x1 + k3_1, x2 + k3_2, I::diffuser(e[2]), d1, d2);
+                V k4_1 = h * d1, k4_2 = h * d2;
+                x1 = x1 + (k1_1 + deux * k2_1 + deux * k3_1 + k4_1) * sixieme;
+                x2 = x2 + (k1_2 + deux * k2_2 + deux * k3_2 + k4_2) * sixieme;
+            } else if constexpr (etages == 2) {
+                // Heun
+                f(x1, x2, I::diffuser(e[0]), d1, d2);
+                V p1, p2;
+                f(x1 + h * d1, x2 + h * d2, I::diffuser(e[2]), p1, p2);
+                x1 = x1 + h * (d1 + p1) * demi;
+                x2 = x2 + h * (d2 + p2) * demi;
+            } else {
+                // Euler
+                f(x1, x2, I::diffuser(e[0]), d1, d2);
+                x1 = x1 + h * d1;
+                x2 = x2 + h * d2;
+            }
+        }
+
+        I::ranger(v.x1 + j, x1);
+        I::ranger(v.x2 + j, x2);
+    }
+}
+
+// Aiguillage (forme, méthode) -> noyau instancié pour le jeu d'instructions I
+template <class I>
+void avancerLot(const VueLot& v, NoyauLot noyau, int etages,
+                const double* ve, std::size_t nPas, double dt) {
+    switch (noyau) {
+        case NoyauLot::Lineaire1:
+            if (etages == 4) noyauLot<I, NoyauLot::Lineaire1, 4>(v, ve, nPas, dt);
+            else if (etages == 2) noyauLot<I, NoyauLot::Lineaire1, 2>(v, ve, nPas, dt);
+            else noyauLot<I, NoyauLot::Lineaire1, 1>(v, ve, nPas, dt);
+            break;
+        case NoyauLot::Lineaire2:
+            if (etages == 4) noyauLot<I, NoyauLot::Lineaire2, 4>(v, ve, nPas, dt);
+            else if (etages == 2) noyauLot<I, NoyauLot::Lineaire2, 2>(v, ve, nPas, dt);
+            else noyauLot<I, NoyauLot::Lineaire2, 1>(v, ve, nPas, dt);
+            break;
+        case NoyauLot::Diode:
+            if (etages == 4) noyauLot<I, NoyauLot::Diode, 4>(v, ve, nPas, dt);
+            else if (etages == 2) noyauLot<I, NoyauLot::Diode, 2>(v, ve, nPas, dt);
+            else noyauLot<I, NoyauLot::Diode, 1>(v, ve, nPas, dt);
+            break;
+    }
+}
+
+} // namespace
+
+#endif // NOYAUX_LOT_HPP
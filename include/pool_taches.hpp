@@ -0,0 +1,65 @@
+#ifndef POOL_TACHES_HPP
+#define POOL_TACHES_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Pool de threads à vol de tâches (work stealing).
+// Chaque thread possède sa propre file : il prend ses tâches par l'arrière
+// (les plus récentes, encore chaudes en cache) et, quand elle est vide, vole
+// par l'avant dans la file d'un autre thread. Il n'y a pas de file globale :
+// les tâches de coût très variable (npas, raideur) s'équilibrent d'elles-mêmes.
+
+class PoolTaches {
+public:
+    // nThreads = 0 : autant de threads que de cœurs
+    explicit PoolTaches(unsigned nThreads = 0);
+    ~PoolTaches();
+
+    PoolTaches(const PoolTaches&) = delete;
+    PoolTaches& operator=(const PoolTaches&) = delete;
+
+    // Ajoute une tâche. Appelée depuis un thread du pool, la tâche va dans sa
+    // propre file ; sinon les tâches sont réparties à tour de rôle.
+    void soumettre(std::function<void()> tache);
+
+    // Attend que toutes les tâches soumises soient terminées
+    void attendre();
+
+    unsigned taille() const { return static_cast<unsigned>(threads_.size()); }
+
+    // Nombre de tâches exécutées par un autre thread que celui qui les a reçues
+    std::size_t nombreVols() const { return vols_.load(); }
+
+private:
+    struct File {
+        std::mutex m;
+        std::deque<std::function<void()>> taches;
+    };
+
+    std::vector<std::unique_ptr<File>> files_;
+    std::vector<std::thread> threads_;
+
+    std::atomic<std::size_t> enAttente_{0};     // tâches dans les files
+    std::atomic<std::size_t> nonTerminees_{0};  // tâches soumises pas encore finies
+    std::atomic<std::size_t> vols_{0};
+    std::atomic<std::size_t> prochaineFile_{0};
+    std::atomic<bool> arret_{false};
+
+    // Seulement pour endormir / réveiller les threads, jamais pendant un calcul
+    std::mutex mSommeil_;
+    std::condition_variable cvTravail_;
+    std::condition_variable cvFini_;
+
+    void boucleThread(unsigned indice);
+    bool prendre(unsigned indice, std::function<void()>& tache);
+};
+
+#endif // POOL_TACHES_HPP
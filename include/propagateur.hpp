@@ -0,0 +1,61 @@
+#ifndef PROPAGATEUR_HPP
+#define PROPAGATEUR_HPP
+
+// Propagateur exact des circuits linéaires invariants (A, C, D) :
+//   dx/dt = A x + B ve
+// Sur un pas h où ve varie linéairement (maintien d'ordre 1) :
+//   x(t+h) = Φ x(t) + Γ0 ve(t) + Γ1 (ve(t+h) - ve(t)) / h
+// avec Φ = exp(A h), Γ0 = ∫[0,h] exp(A s) ds B et Γ1 = ∫[0,h] exp(A s) (h - s) ds B.
+// Les trois termes sont lus dans l'exponentielle de la matrice augmentée
+// M = [[A, B, 0], [0, 0, 1], [0, 0, 0]] (méthode de Van Loan), calculée une
+// seule fois par longueur de pas.
+// Le résultat est exact (aux arrondis près) pour les entrées affines par
+// morceaux (échelon, créneau, rectangulaire, triangle) puisque statique::boucle
+// s'arrête sur leurs discontinuités ; pour le sinus, seule reste l'erreur
+// O(h²) du maintien d'ordre 1.
+
+// exp(a) pour une matrice n x n (stockage ligne par ligne) :
+// mise à l'échelle, série de Taylor, puis élévations au carré
+void exponentielleMatrice(int n, const double* a, double* e);
+
+struct Propagateur {
+    double h = 0.0;         // longueur de pas des matrices (0 : non calculé)
+    int ordre = 0;
+    double phi[2][2] = {{0.0, 0.0}, {0.0, 0.0}};
+    double g0[2] = {0.0, 0.0};
+    double g1[2] = {0.0, 0.0};
+
+    // Calcule Φ, Γ0 et Γ1 pour le système (a, b) et le pas h
+    void calculer(int ordre, const double a[2][2], const double b[2], double h);
+
+    // Matrices A et B lues dans le circuit : A = jacobien, B = réponse des
+    // dérivées à ve = 1 depuis l'état nul (le circuit doit être linéaire)
+    template <class Circ>
+    void construire(const Circ& c, double extra, double pas) {
+        double a[2][2] = {{0.0, 0.0}, {0.0, 0.0}};
+        double b[2] = {0.0, 0.0};
+        if (c.order() == 1) {
+            a[0][0] = c.jacobien1(0.0, 0.0, 0.0, extra);
+            b[0] = c.deriv1(0.0, 0.0, 1.0, extra) - c.deriv1(0.0, 0.0, 0.0, extra);
+        } else {
+            double u1, u2, z1, z2;
+            c.jacobien2(0.0, 0.0, 0.0, 0.0, a[0][0], a[0][1], a[1][0], a[1][1]);
+            c.deriv2(0.0, 0.0, 0.0, 1.0, u1, u2);
+            c.deriv2(0.0, 0.0, 0.0, 0.0, z1, z2);
+            b[0] = u1 - z1;
+            b[1] = u2 - z2;
+        }
+        calculer(c.order(), a, b, pas);
+    }
+
+    // Un pas de longueur h, ve0 = ve(t), ve1 = ve(t+h)
+    void avancer(double& x1, double& x2, double ve0, double ve1) const {
+        double pente = (ve1 - ve0) / h;
+        double y1 = phi[0][0] * x1 + phi[0][1] * x2 + g0[0] * ve0 + g1[0] * pente;
+        double y2 = phi[1][0] * x1 + phi[1][1] * x2 + g0[1] * ve0 + g1[1] * pente;
+        x1 = y1;
+        x2 = y2;
+    }
+};
+
+#endif // PROPAGATEUR_HPP
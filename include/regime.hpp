@@ -0,0 +1,63 @@
+#ifndef REGIME_HPP
+#define REGIME_HPP
+
+#include "circuit.hpp"
+#include "ecrivain.hpp"
+#include "source.hpp"
+#include <string>
+
+// Régime permanent périodique (sources sinus, triangle, créneau, rectangle).
+// Usage : be-sim --regime [cle=valeur ...]
+// Clés de simulation : celles de be-sim --serveur (circuit, source, A, f,
+// duty, offset, R, R2, C, L, diode, Is, n, Vt, methode à pas fixe), plus :
+//   algo=tir|periodes     méthode de tir (défaut) ou transitoire arrêté dès
+//                         que deux périodes successives coïncident
+//   pas_periode=N         pas par période de la source (défaut 1000) ;
+//                         npas et tmax sont ignorés : dt = periode / N
+//   rtol=, atol=          écart toléré entre l'état au début et à la fin
+//                         d'une période (défaut 1e-6, 1e-9)
+//   periodes_max=K        borne du nombre de périodes intégrées (défaut 100000)
+//   sortie=chemin.csv     résultat (défaut resultats/regime/regime.csv) : une
+//                         période du régime établi (tir), ou le transitoire
+//                         complet jusqu'à l'arrêt (periodes)
+//
+// Tir : on cherche l'état x0 tel que Φ(x0) = x0, où Φ intègre une période
+// depuis t = 0 ; Newton sur F(x) = Φ(x) - x, jacobien de Φ par différences
+// finies (une période par composante d'état). Les circuits linéaires
+// convergent en une itération : quelques périodes intégrées au lieu des
+// dizaines de constantes de temps du transitoire (circuits C et D peu amortis).
+
+struct OptionsRegime {
+    int pasParPeriode = 1000;
+    double rtol = 1e-6;
+    double atol = 1e-9;
+    long periodesMax = 100000;
+};
+
+struct ResultatRegime {
+    double x1 = 0.0, x2 = 0.0;      // état au début d'une période du régime établi
+    bool converge = false;
+    int iterations = 0;             // itérations de Newton (tir)
+    long periodes = 0;              // périodes intégrées en tout (coût)
+    double ecart = 0.0;             // max |Φ(x) - x| à la sortie
+};
+
+// Période de la source (1 / f) ; false (avec un message) si elle n'est pas
+// périodique (échelon) ou si f n'est pas positive et finie
+bool periodeSource(int typeSource, double f, double& periode, std::string& erreur);
+
+// Méthode de tir, méthode à pas fixe (1 à 4, 6 à 10)
+bool regimeParTir(const Circuit& circuit, const Source& source, double R2, int methode,
+                  double periode, const OptionsRegime& opt, ResultatRegime& r,
+                  std::string& erreur);
+
+// Transitoire depuis l'état nul, arrêté à la première période dont la fin
+// coïncide avec le début ; échantillons écrits dans ecrivain s'il est fourni
+bool regimeParPeriodes(const Circuit& circuit, const Source& source, double R2, int methode,
+                       double periode, const OptionsRegime& opt, ResultatRegime& r,
+                       EcrivainAsynchrone* ecrivain, std::string& erreur);
+
+// Point d'entrée du mode régime permanent (main.cpp)
+int lancerRegime(int argc, char** argv);
+
+#endif // REGIME_HPP
@@ -0,0 +1,274 @@
+#ifndef RK45_HPP
+#define RK45_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include "circuit.hpp"
+#include "ecrivain.hpp"
+#include "source.hpp"
+
+// Intégrateur adaptatif de Dormand-Prince (RK5(4), FSAL) avec sortie dense.
+// Le pas est choisi automatiquement à partir d'une estimation de l'erreur
+// locale (tolérances relative et absolue) ; les pas trop imprécis sont rejetés
+// et recommencés. La sortie dense (interpolation d'ordre 4 de Hairer) permet
+// d'écrire le CSV sur la grille uniforme t_i = i*tmax/npas quel que soit le pas
+// réellement utilisé. Même convention que les méthodes à pas fixe
+// (statique::boucle) : la ligne t_i porte Vin(t_i) et l'état après le pas,
+// x1(t_i+1) ; l'intégration va donc jusqu'à t_npas+1 = tmax + tmax/npas.
+// Les discontinuités de la source sont des points d'arrêt imposés : aucun pas
+// ne les enjambe, et l'intégration repart sur chacune d'elles (k1 recalculé,
+// la propriété FSAL ne vaut pas à travers un front).
+
+struct OptionsRK45 {
+    double rtol = 1e-6;     // tolérance relative
+    double atol = 1e-9;     // tolérance absolue
+    double hMax = 0.0;      // pas maximal (0 : tmax)
+    long maxPas = 100000000;
+};
+
+struct StatsRK45 {
+    long pasAcceptes = 0;
+    long pasRejetes = 0;
+    long evaluations = 0;   // appels au champ de vecteurs (dérivées)
+};
+
+// État de l'intégration entre deux appels (point de reprise). Une
+// intégration reprise avec cet état (et x1, x2) refait exactement les mêmes
+// pas ; avec un tmax plus grand, elle prolonge l'horizon.
+struct EtatRK45 {
+    bool demarre = false;           // false : départ de t = 0
+    double t = 0.0;                 // instant atteint (fin du dernier pas accepté)
+    double h = 0.0;                 // pas proposé pour la suite
+    double debutSeg = 0.0, finSeg = 0.0;
+    int iSortie = 0;                // prochaine ligne de la grille de sortie
+    bool rejetPrecedent = false;
+};
+
+namespace rk45 {
+
+// Coefficients de Dormand-Prince
+constexpr double c2 = 1.0/5, c3 = 3.0/10, c4 = 4.0/5, c5 = 8.0/9;
+constexpr double a21 = 1.0/5;
+constexpr double a31 = 3.0/40, a32 = 9.0/40;
+constexpr double a41 = 44.0/45, a42 = -56.0/15, a43 = 32.0/9;
+constexpr double a51 = 19372.0/6561, a52 = -25360.0/2187, a53 = 64448.0/6561, a54 = -212.0/729;
+constexpr double a61 = 9017.0/3168, a62 = -355.0/33, a63 = 46732.0/5247, a64 = 49.0/176,
+                 a65 = -5103.0/18656;
+constexpr double a71 = 35.0/384, a73 = 500.0/1113, a74 = 125.0/192, a75 = -2187.0/6784,
+                 a76 = 11.0/84;
+// Différence entre les solutions d'ordre 5 et 4 (estimation d'erreur)
+constexpr double e1 = 71.0/57600, e3 = -71.0/16695, e4 = 71.0/1920, e5 = -17253.0/339200,
+                 e6 = 22.0/525, e7 = -1.0/40;
+// Sortie dense
+constexpr double d1 = -12715105075.0/11282082432, d3 = 87487479700.0/32700410799,
+                 d4 = -10690763975.0/1880347072, d5 = 701980252875.0/199316789632,
+                 d6 = -1453857185.0/822651844, d7 = 69997945.0/29380423;
+
+// Intégration de 0 à t_npas+1 = tmax + tmax/npas.
+//   champ(t, x1, x2, dx1, dx2)  dérivées de l'état (x2 ignoré si dim == 1)
+//   entree(t)                   valeur de la source, pour la sortie
+//   discontinuite(t)            prochaine discontinuité de la source après t
+//   sortie(t, Vin, x1)          appelé pour t_i = i*tmax/npas, i = 0..npas, avec
+//                               Vin(t_i) et x1(t_i+1)
+// x1, x2 : état initial en entrée, état à t_npas+1 en sortie.
+// e : état de reprise (départ de t = 0 si !e.demarre), mis à jour en sortie ;
+// jalon(e, x1, x2) est appelé après un pas accepté dès que la grille de
+// sortie franchit un multiple de intervalle (0 : jamais).
+template <class Champ, class Entree, class Discontinuite, class Sortie, class Jalon>
+StatsRK45 integrer(Champ&& champ, Entree&& entree, Discontinuite&& discontinuite, Sortie&& sortie,
+                   int dim, double tmax, int npas, const OptionsRK45& opt, double& x1, double& x2,
+                   EtatRK45& e, int intervalle, Jalon&& jalon) {
+    StatsRK45 stats;
+    const double dtSortie = tmax / npas;
+    // Fin de l'intégration : instant de l'état écrit sur la dernière ligne
+    const double tFinal = (npas + 1) * dtSortie;
+    const double hMax = (opt.hMax > 0.0) ? std::min(opt.hMax, tmax) : tmax;
+
+    // Intervalle courant sans discontinuité ; les étages sont évalués à
+    // l'intérieur (un étage posé sur le front voit la valeur d'avant le front)
+    const double marge = 1e-9 * dtSortie;
+    double debutSeg = e.demarre ? e.debutSeg : 0.0;
+    double finSeg = e.demarre ? e.finSeg : discontinuite(0.0);
+
+    // Norme de l'erreur pondérée par les tolérances
+    auto norme = [&](double v1, double v2, double s1, double s2) {
+        double r1 = v1 / s1, r2 = v2 / s2;
+        return (dim == 1) ? std::fabs(r1) : std::sqrt(0.5 * (r1 * r1 + r2 * r2));
+    };
+    auto f = [&](double t, double y1, double y2, double& d1, double& d2) {
+        ++stats.evaluations;
+        t = std::min(std::max(t, debutSeg + marge), finSeg - marge);
+        champ(t, y1, y2, d1, d2);
+        if (dim == 1) d2 = 0.0;
+    };
+
+    double t = e.demarre ? e.t : 0.0;
+    double y1 = x1, y2 = (dim == 1) ? 0.0 : x2;
+    double k1_1, k1_2;
+    f(t, y1, y2, k1_1, k1_2);   // à la reprise : même valeur que le k7 (FSAL) d'avant
+
+    double h = e.h;
+    int iSortie = e.iSortie;
+    bool rejetPrecedent = e.rejetPrecedent;
+    if (!e.demarre) {
+        // Pas initial (heuristique de Hairer, II.4)
+        double s1 = opt.atol + opt.rtol * std::fabs(y1), s2 = opt.atol + opt.rtol * std::fabs(y2);
+        double n0 = norme(y1, y2, s1, s2), n1 = norme(k1_1, k1_2, s1, s2);
+        double h0 = (n0 < 1e-5 || n1 < 1e-5) ? 1e-6 * tmax : 0.01 * n0 / n1;
+        h0 = std::min(h0, hMax);
+        double p1, p2;
+        f(t + h0, y1 + h0 * k1_1, y2 + h0 * k1_2, p1, p2);
+        double n2 = norme(p1 - k1_1, p2 - k1_2, s1, s2) / h0;
+        double nmax = std::max(n1, n2);
+        double h1 = (nmax <= 1e-15) ? std::max(1e-6 * tmax, h0 * 1e-3) : std::pow(0.01 / nmax, 0.2);
+        h = std::min({100.0 * h0, h1, hMax});
+
+        iSortie = 0;
+        rejetPrecedent = false;
+        e.demarre = true;
+    }
+    int prochainJalon = (intervalle > 0) ? (iSortie / intervalle + 1) * intervalle : 0;
+
+    // Range l'état courant dans e (jalon et fin de l'intégration)
+    auto memoriser = [&]() {
+        e.t = t;
+        e.h = h;
+        e.debutSeg = debutSeg;
+        e.finSeg = finSeg;
+        e.iSortie = iSortie;
+        e.rejetPrecedent = rejetPrecedent;
+    };
+
+    while (t < tFinal && stats.pasAcceptes + stats.pasRejetes < opt.maxPas) {
+        bool dernier = false, surFront = false;
+        double hAvantFront = h;
+        if (t + h >= tFinal || tFinal - (t + h) < 1e-10 * h) {
+            h = tFinal - t;
+            dernier = true;
+        }
+        if (finSeg < tFinal - marge && finSeg < t + h + marge) {
+            // Le pas s'arrête exactement sur la discontinuité
+            h = finSeg - t;
+            dernier = false;
+            surFront = true;
+        }
+
+        double k2_1, k2_2, k3_1, k3_2, k4_1, k4_2, k5_1, k5_2, k6_1, k6_2, k7_1, k7_2;
+        f(t + c2*h, y1 + h*(a21*k1_1), y2 + h*(a21*k1_2), k2_1, k2_2);
+        f(t + c3*h, y1 + h*(a31*k1_1 + a32*k2_1), y2 + h*(a31*k1_2 + a32*k2_2), k3_1, k3_2);
+        f(t + c4*h, y1 + h*(a41*k1_1 + a42*k2_1 + a43*k3_1),
+                    y2 + h*(a41*k1_2 + a42*k2_2 + a43*k3_2), k4_1, k4_2);
+        f(t + c5*h, y1 + h*(a51*k1_1 + a52*k2_1 + a53*k3_1 + a54*k4_1),
+                    y2 + h*(a51*k1_2 + a52*k2_2 + a53*k3_2 + a54*k4_2), k5_1, k5_2);
+        f(t + h, y1 + h*(a61*k1_1 + a62*k2_1 + a63*k3_1 + a64*k4_1 + a65*k5_1),
+                 y2 + h*(a61*k1_2 + a62*k2_2 + a63*k3_2 + a64*k4_2 + a65*k5_2), k6_1, k6_2);
+        double n1 = y1 + h*(a71*k1_1 + a73*k3_1 + a74*k4_1 + a75*k5_1 + a76*k6_1);
+        double n2 = y2 + h*(a71*k1_2 + a73*k3_2 + a74*k4_2 + a75*k5_2 + a76*k6_2);
+        f(t + h, n1, n2, k7_1, k7_2);   // FSAL : k1 du pas suivant
+
+        double err1 = h*(e1*k1_1 + e3*k3_1 + e4*k4_1 + e5*k5_1 + e6*k6_1 + e7*k7_1);
+        double err2 = h*(e1*k1_2 + e3*k3_2 + e4*k4_2 + e5*k5_2 + e6*k6_2 + e7*k7_2);
+        double s1 = opt.atol + opt.rtol * std::max(std::fabs(y1), std::fabs(n1));
+        double s2 = opt.atol + opt.rtol * std::max(std::fabs(y2), std::fabs(n2));
+        double err = norme(err1, err2, s1, s2);
+
+        // Facteur de pas : 0.9 * err^(-1/5), borné ; pas d'augmentation juste après un rejet
+        double facteur = (err == 0.0) ? 10.0 : 0.9 * std::pow(err, -0.2);
+
+        if (err > 1.0) {
+            ++stats.pasRejetes;
+            rejetPrecedent = true;
+            h *= std::max(0.2, facteur);
+            continue;
+        }
+
+        // Pas accepté : lignes dont l'état x1(t_i+1) est dans ]t, t+h]
+        ++stats.pasAcceptes;
+        double tFin = dernier ? tFinal : (surFront ? finSeg : t + h);
+        if (iSortie <= npas && (dernier || (iSortie + 1) * dtSortie <= tFin)) {
+            // Coefficients de l'interpolant (seul x1 est écrit)
+            double dy1 = n1 - y1;
+            double b1 = h * k1_1 - dy1;
+            double r4_1 = dy1 - h * k7_1 - b1;
+            double r5_1 = h*(d1*k1_1 + d3*k3_1 + d4*k4_1 + d5*k5_1 + d6*k6_1 + d7*k7_1);
+            while (iSortie <= npas && (dernier || (iSortie + 1) * dtSortie <= tFin)) {
+                double ti = iSortie * dtSortie;
+                double tEtat = (iSortie == npas) ? tFinal : (iSortie + 1) * dtSortie;
+                double th = std::min(1.0, (tEtat - t) / h), th1 = 1.0 - th;
+                double v1 = y1 + th * (dy1 + th1 * (b1 + th * (r4_1 + th1 * r5_1)));
+                sortie(ti, entree(ti), v1);
+                ++iSortie;
+            }
+        }
+
+        t = tFin;
+        y1 = n1; y2 = n2;
+        facteur = std::min(rejetPrecedent ? 1.0 : 10.0, std::max(0.2, facteur));
+        rejetPrecedent = false;
+
+        if (surFront) {
+            // Redémarrage : nouvel intervalle, k1 évalué après le front, et
+            // pas d'avant la coupure (le pas raccourci n'est pas représentatif)
+            debutSeg = finSeg;
+            finSeg = discontinuite(finSeg);
+            f(t, y1, y2, k1_1, k1_2);
+            h = std::min(std::max(h * facteur, hAvantFront), hMax);
+        } else {
+            k1_1 = k7_1; k1_2 = k7_2;
+            h = std::min(h * facteur, hMax);
+        }
+
+        if (intervalle > 0 && iSortie >= prochainJalon) {
+            memoriser();
+            jalon(static_cast<const EtatRK45&>(e), y1, y2);
+            prochainJalon = (iSortie / intervalle + 1) * intervalle;
+        }
+    }
+
+    memoriser();
+    x1 = y1;
+    x2 = y2;
+    return stats;
+}
+
+// Intégration complète depuis t = 0, sans reprise
+template <class Champ, class Entree, class Discontinuite, class Sortie>
+StatsRK45 integrer(Champ&& champ, Entree&& entree, Discontinuite&& discontinuite, Sortie&& sortie,
+                   int dim, double tmax, int npas, const OptionsRK45& opt, double& x1, double& x2) {
+    EtatRK45 e;
+    return integrer(champ, entree, discontinuite, sortie, dim, tmax, npas, opt, x1, x2, e, 0,
+                    [](const EtatRK45&, double, double) {});
+}
+
+} // namespace rk45
+
+// Intégration RK45 d'un circuit : écrit (t, Vin, Vout) sur npas+1 points
+// uniformes. Utilise les types concrets (champ inliné) quand ils sont connus.
+StatsRK45 simulerRK45(const Circuit& circuit, const Source& source, double R2,
+                      int npas, double tmax, const OptionsRK45& opt,
+                      double& x1, double& x2, EcrivainAsynchrone& ecrivain);
+
+// Reprise (voir EtatRK45) : de l'état etat jusqu'à tmax, jalon(etat, x1, x2)
+// tous les intervalle points de sortie
+StatsRK45 simulerRK45(const Circuit& circuit, const Source& source, double R2,
+                      int npas, double tmax, const OptionsRK45& opt,
+                      double& x1, double& x2, EtatRK45& etat, EcrivainAsynchrone& ecrivain,
+                      int intervalle,
+                      const std::function<void(const EtatRK45&, double, double)>& jalon);
+
+// Même intégration, sortie rangée dans trois tableaux de npas + 1 valeurs ;
+// nombre : échantillons écrits (moins de npas + 1 si opt.maxPas est atteint)
+StatsRK45 simulerRK45(const Circuit& circuit, const Source& source, double R2,
+                      int npas, double tmax, const OptionsRK45& opt,
+                      double& x1, double& x2, double* temps, double* vin, double* vout,
+                      std::size_t& nombre);
+
+// Même intégration, chaque point passé à sortie(t, Vin, Vout) (statistiques
+// du balayage, sans rien garder en mémoire)
+StatsRK45 simulerRK45(const Circuit& circuit, const Source& source, double R2,
+                      int npas, double tmax, const OptionsRK45& opt,
+                      double& x1, double& x2,
+                      const std::function<void(double, double, double)>& sortie);
+
+#endif // RK45_HPP
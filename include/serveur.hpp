@@ -0,0 +1,51 @@
+#ifndef SERVEUR_HPP
+#define SERVEUR_HPP
+
+#include "besim.hpp"
+#include <cstdio>
+#include <string>
+
+// Mode serveur : be-sim --serveur [chemin_socket] [threads=N] [cache=dossier|non] [cache_mo=M]
+//                                [inactivite=S] [arret=oui|non]
+// Processus persistant à l'écoute d'une socket Unix (défaut /tmp/be-sim.sock).
+// Un fichier existant à ce chemin n'est remplacé que s'il s'agit d'une socket.
+// Chaque connexion est servie par une tâche d'un PoolTaches, rendue au pool
+// quand le client ferme ou reste inactif plus de S secondes entre deux
+// requêtes (défaut 60, 0 : jamais) ; elle envoie une
+// requête par ligne, des paires cle=valeur séparées par des espaces :
+//   circuit=C source=4 A=5 f=200 duty=0.3 methode=3 npas=100000 tmax=2e-2 R=10 C=1e-6 L=1e-3
+// Clés : circuit, source (numérotation de initialiserSource), A, f, duty,
+// offset, t0, R, R2, C, L, diode (seuil par défaut|shockley), Is, n, Vt (diode du
+// circuit B), methode (1..10), npas, tmax, rtol, atol (méthode 5),
+// trace (points de la trace réduite, 0 : aucune), lttb (0/1).
+// La réponse est le flux de trames de be-sim --flux (voir flux_trames.hpp),
+// sur la même connexion ; une requête invalide (voir verifierParametres) ou
+// dont la simulation échoue (mémoire épuisée, ...) reçoit une trame "RESU"
+// avec statut=erreur et message=..., sans arrêter le serveur. Une ligne de
+// plus de 64 Kio reçoit cette trame, puis la connexion est fermée.
+// Lignes spéciales : "fin" ferme la connexion, "arret" arrête le serveur
+// si celui-ci a été lancé avec arret=oui (sinon trame d'erreur : n'importe
+// quel client pourrait l'arrêter). SIGTERM ou SIGINT l'arrêtent toujours.
+// À l'arrêt, plus de nouvelles connexions ; celles ouvertes sont servies
+// jusqu'au bout, puis la socket est supprimée.
+// Les résultats passent par le cache du processus (cache_resultats.hpp,
+// dossier resultats/cache par défaut, M Mo sur disque) ; le résumé indique
+// cache=calcul|memoire|disque. Un calcul est diffusé au fil de l'intégration
+// pendant que son entrée se remplit ; les requêtes identiques arrivées
+// entre-temps attendent ce calcul au lieu de le refaire. Un résultat plus
+// grand que la limite mémoire du cache est diffusé sans être gardé
+// (cache=non dans le résumé), comme avec l'option cache=non.
+
+// Une requête porte les paramètres de la bibliothèque (besim.hpp)
+using RequeteSimulation = ParametresSimulation;
+
+// Lecture d'une ligne de requête ; false (avec un message) si invalide
+bool lireRequete(const std::string& ligne, RequeteSimulation& r, std::string& erreur);
+
+// Simule (ou lit dans le cache) et envoie le résultat en trames sur sortie
+void simulerRequete(const RequeteSimulation& r, std::FILE* sortie, bool avecCache = true);
+
+// Point d'entrée du mode serveur (main.cpp)
+int lancerServeur(int argc, char** argv);
+
+#endif // SERVEUR_HPP
@@ -13,9 +13,9 @@ struct SimContext {
     // f1 : (t, vs) -> dx1  (pour circuits ordre 1)
     std::function<double(double,double)> f1;
 
-    // f2_1, f2_2 : (t, x1, x2) -> dx1/dx2 (pour circuits ordre 2)
-    std::function<double(double,double,double)> f2_1;
-    std::function<double(double,double,double)> f2_2;
+    // f2 : (t, x1, x2) -> (dx1, dx2), retourne ve(t) (pour circuits ordre 2)
+    // Champ fusionné : une seule évaluation de la source et de deriv2 par étage
+    std::function<double(double,double,double,double&,double&)> f2;
 };
 
 // Factory : construit un SimContext en reliant le circuit et la source
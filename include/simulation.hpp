@@ -15,6 +15,10 @@ public:
     
     // Méthode pour lire les paramètres depuis l'utilisateur
     void lireParametres();
+
+    // Reprise ou prolongement de l'horizon : garde exactement le pas dt d'une
+    // simulation précédente, npas pas en tout (tmax = npas * dt)
+    void prolonger(double dt, int npas);
     
     // Getters
     int getNpas() const { return npas_; }
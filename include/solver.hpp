@@ -2,7 +2,11 @@
 #define SOLVER_HPP
 #include <functional>
 using Deriv1 = std::function<double(double, double)>;
-using Deriv2 = std::function<double(double, double, double)>;
+
+// Champ de vecteurs fusionné pour les systèmes 2x2 :
+// (t, x1, x2) -> (dx1, dx2) en un seul appel, retourne ve(t).
+// La source et Circuit::deriv2 ne sont évalués qu'une fois par étage.
+using Champ2 = std::function<double(double t, double x1, double x2, double& dx1, double& dx2)>;
 
 // On définit les fonctions de résolution d'équations différentielles
 
@@ -10,17 +14,16 @@ using Deriv2 = std::function<double(double, double, double)>;
 
 void euler1(double& x, double dt, double t, Deriv1 f);
 
-// Euler pour systèmes 2x2 (circuits 2ème ordre) 
-
-void euler2(double& x1, double& x2, double dt, double t, Deriv2 f1, Deriv2 f2);
+// Euler pour systèmes 2x2 (circuits 2ème ordre)
+// Retourne ve(t), la valeur de la source au début du pas (réutilisée en sortie)
 
-// Runge-Kutta 4ème ordre pour systèmes 2x2
+double euler2(double& x1, double& x2, double dt, double t, const Champ2& f);
 
 // Runge-Kutta 4ème ordre pour systèmes 2x2
-void rk4(double& x1, double& x2, double dt, double t, Deriv2 f1, Deriv2 f2);
+double rk4(double& x1, double& x2, double dt, double t, const Champ2& f);
 
 // Heun (Euler amélioré) pour systèmes 2x2
-void heun(double& x1, double& x2, double dt, double t, Deriv2 f1, Deriv2 f2);
+double heun(double& x1, double& x2, double dt, double t, const Champ2& f);
 
 // --- Méthodes pour systèmes d'ordre 1 ---
 
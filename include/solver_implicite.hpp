@@ -0,0 +1,167 @@
+#ifndef SOLVER_IMPLICITE_HPP
+#define SOLVER_IMPLICITE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "circuit.hpp"
+#include "propagateur.hpp"
+
+// Méthodes implicites pour les circuits raides (petits C ou L, grand R/L).
+// Les méthodes explicites (Euler, Heun, RK4) ne sont stables que si dt*|λ|
+// reste petit pour toutes les valeurs propres λ du système ; les méthodes
+// ci-dessous sont A-stables et acceptent des pas bien plus grands.
+// Chaque pas résout x = b + gh*f(t+dt, x) par Newton, avec le jacobien
+// analytique du circuit (Circuit::jacobien1 / jacobien2). Les circuits A, C
+// et D étant linéaires en l'état, Newton converge en une itération ; la
+// diode de Shockley du circuit B a sa propre résolution (CircuitB::resoudrePas).
+
+namespace statique {
+
+// Mémoire conservée d'un pas à l'autre par statique::boucle
+struct MemoirePas {
+    double x1 = 0.0, x2 = 0.0;  // état au début du pas précédent (BDF2)
+    double h = 0.0;             // longueur du pas précédent
+    bool valide = false;        // false : pas de passé utilisable (départ, front)
+    bool raide = false;         // mode automatique : méthode implicite en cours
+    // Tension de la diode de CircuitB à la fin du pas précédent : départ à
+    // chaud de Newton (non finie : à calculer depuis l'état)
+    double vd = std::numeric_limits<double>::quiet_NaN();
+    // Itérations de Newton de la diode : total, pas résolus, maximum par pas
+    long iterationsNewton = 0, resolutionsNewton = 0;
+    int iterationsNewtonMax = 0;
+    Propagateur exact;          // méthode exacte : matrices du pas dt
+    Propagateur exactSousPas;   // et du dernier sous-pas (coupure sur un front)
+};
+
+// Mode automatique : RK4 tant que dt*|λ|max reste nettement dans sa région de
+// stabilité (|dt*λ| < 2.78 sur l'axe réel), BDF2 au-delà. L'écart entre les
+// deux seuils évite de basculer à chaque pas.
+constexpr double SEUIL_RAIDE = 2.0;
+constexpr double SEUIL_NON_RAIDE = 1.0;
+
+// Dérivées de l'état pour un circuit d'ordre 1 ou 2 (dx2 = 0 à l'ordre 1)
+template <class Circ>
+inline void derivees(const Circ& c, double t, double x1, double x2, double ve, double extra,
+                     double& dx1, double& dx2) {
+    if (c.order() == 1) {
+        dx1 = c.deriv1(t, x1, ve, extra);
+        dx2 = 0.0;
+    } else {
+        c.deriv2(t, x1, x2, ve, dx1, dx2);
+    }
+}
+
+// Newton pour x = b + gh*f(t, x) ; (x1, x2) contient l'estimation initiale
+// et reçoit la solution
+template <class Circ>
+inline void resoudreNewton(double& x1, double& x2, double b1, double b2, double gh,
+                           double t, double ve, const Circ& c, double extra) {
+    for (int k = 0; k < 20; ++k) {
+        if (c.order() == 1) {
+            double r = x1 - b1 - gh * c.deriv1(t, x1, ve, extra);
+            double dx = -r / (1.0 - gh * c.jacobien1(t, x1, ve, extra));
+            x1 += dx;
+            if (std::fabs(dx) <= 1e-12 * (1.0 + std::fabs(x1))) return;
+        } else {
+            double d1, d2, j11, j12, j21, j22;
+            c.deriv2(t, x1, x2, ve, d1, d2);
+            c.jacobien2(t, x1, x2, ve, j11, j12, j21, j22);
+            double r1 = x1 - b1 - gh * d1;
+            double r2 = x2 - b2 - gh * d2;
+
+            // Matrice de Newton M = I - gh*J, inversée directement (2x2)
+            double m11 = 1.0 - gh * j11, m12 = -gh * j12;
+            double m21 = -gh * j21,      m22 = 1.0 - gh * j22;
+            double det = m11 * m22 - m12 * m21;
+            double dx1 = -(m22 * r1 - m12 * r2) / det;
+            double dx2 = -(m11 * r2 - m21 * r1) / det;
+            x1 += dx1;
+            x2 += dx2;
+            if (std::fabs(dx1) <= 1e-12 * (1.0 + std::fabs(x1)) &&
+                std::fabs(dx2) <= 1e-12 * (1.0 + std::fabs(x2))) return;
+        }
+    }
+}
+
+template <class Circ>
+inline void resoudreImplicite(double& x1, double& x2, double b1, double b2, double gh,
+                              double t, double ve, const Circ& c, double extra, MemoirePas& /*m*/) {
+    resoudreNewton(x1, x2, b1, b2, gh, t, ve, c, extra);
+}
+
+// Circuit B, diode de Shockley : Newton sur (vs, vd), départ à chaud depuis
+// vd du pas précédent ; 1 à 3 itérations par pas en régime établi
+inline void resoudreImplicite(double& x1, double& x2, double b1, double b2, double gh,
+                              double t, double ve, const CircuitB& c, double extra, MemoirePas& m) {
+    if (!c.diode().shockley) {
+        resoudreNewton(x1, x2, b1, b2, gh, t, ve, c, extra);
+        return;
+    }
+    const int k = c.resoudrePas(x1, m.vd, b1, gh, ve, extra);
+    m.iterationsNewton += k;
+    ++m.resolutionsNewton;
+    m.iterationsNewtonMax = std::max(m.iterationsNewtonMax, k);
+}
+
+// Euler implicite (ordre 1, L-stable) : x+ = x + dt*f(t+dt, x+)
+template <class Circ, class Src>
+inline double euler_implicite(double& x1, double& x2, double dt, double t,
+                              const Circ& c, const Src& s, double extra, MemoirePas& m) {
+    double ve = s.ve(t);
+    resoudreImplicite(x1, x2, x1, x2, dt, t + dt, s.ve(t + dt), c, extra, m);
+    return ve;
+}
+
+// Trapèzes (ordre 2, A-stable) : x+ = x + dt/2*(f(t, x) + f(t+dt, x+))
+template <class Circ, class Src>
+inline double trapezes(double& x1, double& x2, double dt, double t,
+                       const Circ& c, const Src& s, double extra, MemoirePas& m) {
+    double ve = s.ve(t);
+    double d1, d2;
+    derivees(c, t, x1, x2, ve, extra, d1, d2);
+    resoudreImplicite(x1, x2, x1 + 0.5 * dt * d1, x2 + 0.5 * dt * d2, 0.5 * dt,
+                      t + dt, s.ve(t + dt), c, extra, m);
+    return ve;
+}
+
+// BDF2 à pas variable (ordre 2, L-stable), avec w = dt / h_précédent :
+// x+ - (1+w)²/(1+2w) x + w²/(1+2w) x- = dt (1+w)/(1+2w) f(t+dt, x+)
+// Sans passé valide (départ, front de la source), démarre par Euler implicite.
+template <class Circ, class Src>
+inline double bdf2(double& x1, double& x2, double dt, double t,
+                   const Circ& c, const Src& s, double extra, MemoirePas& m) {
+    if (!m.valide || m.h <= 0.0) {
+        return euler_implicite(x1, x2, dt, t, c, s, extra, m);
+    }
+    double w = dt / m.h;
+    double a = (1.0 + w) * (1.0 + w) / (1.0 + 2.0 * w);
+    double b = w * w / (1.0 + 2.0 * w);
+    double g = (1.0 + w) / (1.0 + 2.0 * w);
+    double ve = s.ve(t);
+    resoudreImplicite(x1, x2, a * x1 - b * m.x1, a * x2 - b * m.x2, g * dt,
+                      t + dt, s.ve(t + dt), c, extra, m);
+    return ve;
+}
+
+// Rayon spectral du jacobien (plus grand |λ|) : mesure de la raideur
+template <class Circ>
+inline double rayonSpectral(const Circ& c, double t, double x1, double x2, double ve, double extra) {
+    if (c.order() == 1) {
+        return std::fabs(c.jacobien1(t, x1, ve, extra));
+    }
+    double j11, j12, j21, j22;
+    c.jacobien2(t, x1, x2, ve, j11, j12, j21, j22);
+    double demiTrace = 0.5 * (j11 + j22);
+    double det = j11 * j22 - j12 * j21;
+    double disc = demiTrace * demiTrace - det;
+    if (disc >= 0.0) {
+        double r = std::sqrt(disc);
+        return std::max(std::fabs(demiTrace + r), std::fabs(demiTrace - r));
+    }
+    return std::sqrt(det);   // paire complexe conjuguée : |λ|² = det
+}
+
+} // namespace statique
+
+#endif // SOLVER_IMPLICITE_HPP
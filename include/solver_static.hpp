@@ -0,0 +1,431 @@
+#ifndef SOLVER_STATIC_HPP
+#define SOLVER_STATIC_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include "circuit.hpp"
+#include "ecrivain.hpp"
+#include "solver_implicite.hpp"
+#include "source.hpp"
+
+// Versions templates des solveurs de solver.hpp.
+// Elles prennent le type concret du circuit et de la source : plus de
+// std::function, plus d'appel virtuel, chaque pas est entièrement inliné.
+// Le choix (circuit, source, méthode) est fait une seule fois avant la boucle
+// par aiguiller() ; simulerStatique() (src/dispatch.cpp) l'utilise pour le CSV.
+
+// État d'une boucle à pas fixe entre deux appels (point de reprise) : prochain
+// échantillon, mémoire des méthodes multipas, intervalle régulier courant de
+// la source. Les matrices de la méthode exacte sont reconstruites à la reprise.
+struct EtatBoucle {
+    int indice = 0;                 // prochain échantillon à calculer
+    statique::MemoirePas m;
+    double debutSeg = 0.0, finSeg = 0.0;
+    bool demarre = false;           // false : intervalle de la source à initialiser
+};
+
+namespace statique {
+
+// --- Méthodes pour systèmes d'ordre 1 (CircuitA, CircuitB) ---
+
+// Euler simple pour l'ordre 1
+template <class Circ, class Src>
+inline double euler1(double& x, double dt, double t, const Circ& c, const Src& s, double extra) {
+    double ve = s.ve(t);
+    x += dt * c.deriv1(t, x, ve, extra);
+    return ve;
+}
+
+// Runge-Kutta 4 pour l'ordre 1
+template <class Circ, class Src>
+inline double rk4_order1(double& x, double dt, double t, const Circ& c, const Src& s, double extra) {
+    double ve = s.ve(t);
+    double k1 = dt * c.deriv1(t, x, ve, extra);
+    double k2 = dt * c.deriv1(t + dt/2.0, x + k1/2.0, s.ve(t + dt/2.0), extra);
+    double k3 = dt * c.deriv1(t + dt/2.0, x + k2/2.0, s.ve(t + dt/2.0), extra);
+    double k4 = dt * c.deriv1(t + dt, x + k3, s.ve(t + dt), extra);
+
+    x += (k1 + 2.0*k2 + 2.0*k3 + k4) / 6.0;
+    return ve;
+}
+
+// Heun pour l'ordre 1
+template <class Circ, class Src>
+inline double heun_order1(double& x, double dt, double t, const Circ& c, const Src& s, double extra) {
+    // Prédiction (Euler)
+    double ve = s.ve(t);
+    double slope1 = c.deriv1(t, x, ve, extra);
+    double x_pred = x + dt * slope1;
+
+    // Correction
+    double slope2 = c.deriv1(t + dt, x_pred, s.ve(t + dt), extra);
+    x += dt * (slope1 + slope2) / 2.0;
+    return ve;
+}
+
+// --- Méthodes pour systèmes 2x2 (CircuitC, CircuitD) ---
+
+// Euler pour systèmes 2x2
+template <class Circ, class Src>
+inline double euler2(double& x1, double& x2, double dt, double t, const Circ& c, const Src& s) {
+    double dx1, dx2;
+    double ve = s.ve(t);
+    c.deriv2(t, x1, x2, ve, dx1, dx2);
+    x1 += dt * dx1;
+    x2 += dt * dx2;
+    return ve;
+}
+
+// Runge-Kutta 4ème ordre pour systèmes 2x2
+template <class Circ, class Src>
+inline double rk4(double& x1, double& x2, double dt, double t, const Circ& c, const Src& s) {
+    double d1, d2;
+
+    double ve = s.ve(t);
+    c.deriv2(t, x1, x2, ve, d1, d2);
+    double k1_x1 = dt * d1, k1_x2 = dt * d2;
+
+    c.deriv2(t + dt/2, x1 + k1_x1/2, x2 + k1_x2/2, s.ve(t + dt/2), d1, d2);
+    double k2_x1 = dt * d1, k2_x2 = dt * d2;
+
+    c.deriv2(t + dt/2, x1 + k2_x1/2, x2 + k2_x2/2, s.ve(t + dt/2), d1, d2);
+    double k3_x1 = dt * d1, k3_x2 = dt * d2;
+
+    c.deriv2(t + dt, x1 + k3_x1, x2 + k3_x2, s.ve(t + dt), d1, d2);
+    double k4_x1 = dt * d1, k4_x2 = dt * d2;
+
+    // Mise à jour finale
+    x1 += (k1_x1 + 2*k2_x1 + 2*k3_x1 + k4_x1) / 6;
+    x2 += (k1_x2 + 2*k2_x2 + 2*k3_x2 + k4_x2) / 6;
+    return ve;
+}
+
+// Heun (Euler amélioré) pour systèmes 2x2
+template <class Circ, class Src>
+inline double heun(double& x1, double& x2, double dt, double t, const Circ& c, const Src& s) {
+    // Étape de prédiction (Euler)
+    double dx1_dt, dx2_dt;
+    double ve = s.ve(t);
+    c.deriv2(t, x1, x2, ve, dx1_dt, dx2_dt);
+
+    double x1_pred = x1 + dt * dx1_dt;
+    double x2_pred = x2 + dt * dx2_dt;
+
+    // Étape de correction (moyenne des pentes)
+    double dx1_dt_pred, dx2_dt_pred;
+    c.deriv2(t + dt, x1_pred, x2_pred, s.ve(t + dt), dx1_dt_pred, dx2_dt_pred);
+
+    x1 += dt * (dx1_dt + dx1_dt_pred) / 2;
+    x2 += dt * (dx2_dt + dx2_dt_pred) / 2;
+    return ve;
+}
+
+// Un pas de la méthode choixMeth (même numérotation que le menu de main.cpp).
+// choixMeth est un paramètre template : le choix disparaît à la compilation.
+// Retourne ve(t), la valeur de la source en début de pas, réutilisée en sortie.
+// m : mémoire entre les pas (passé de BDF2, état du mode automatique,
+// matrices de la méthode exacte), utilisée par les méthodes 6 à 10 seulement.
+template <int choixMeth, class Circ, class Src>
+inline double pas(double& x1, double& x2, double dt, double t, const Circ& c, const Src& s,
+                  double extra, MemoirePas& m) {
+    if constexpr (choixMeth == 10) {
+        // Méthode exacte (propagateur.hpp) ; circuit non linéaire (B) : RK4
+        if (!c.lineaire()) {
+            if (c.order() == 1) return rk4_order1(x1, dt, t, c, s, extra);
+            return rk4(x1, x2, dt, t, c, s);
+        }
+        // Matrices du pas nominal (construites par boucle) ou d'un sous-pas ;
+        // la tolérance absorbe l'arrondi de (t + dt) - t. Un sous-pas proche
+        // réutilise les matrices construites pour p->h : relues d'un point de
+        // reprise (h seul, ordre 0), elles sont reconstruites pour ce même h
+        Propagateur* p = &m.exact;
+        if (std::fabs(dt - p->h) > 1e-9 * dt) {
+            p = &m.exactSousPas;
+            if (std::fabs(dt - p->h) > 1e-9 * dt) p->construire(c, extra, dt);
+            else if (p->ordre == 0) p->construire(c, extra, p->h);
+        }
+        double ve = s.ve(t);
+        p->avancer(x1, x2, ve, s.ve(t + dt));
+        return ve;
+    } else if constexpr (choixMeth >= 6) {
+        double x1n = x1, x2n = x2;
+        double ve;
+        if constexpr (choixMeth == 6) {
+            ve = euler_implicite(x1, x2, dt, t, c, s, extra, m);
+        } else if constexpr (choixMeth == 7) {
+            ve = trapezes(x1, x2, dt, t, c, s, extra, m);
+        } else if constexpr (choixMeth == 8) {
+            ve = bdf2(x1, x2, dt, t, c, s, extra, m);
+        } else {
+            // 9 : automatique, RK4 ou BDF2 selon dt*|λ|max au début du pas
+            double rho = dt * rayonSpectral(c, t, x1, x2, s.ve(t), extra);
+            m.raide = m.raide ? (rho > SEUIL_NON_RAIDE) : (rho > SEUIL_RAIDE);
+            if (m.raide) {
+                ve = bdf2(x1, x2, dt, t, c, s, extra, m);
+            } else if (c.order() == 1) {
+                ve = rk4_order1(x1, dt, t, c, s, extra);
+            } else {
+                ve = rk4(x1, x2, dt, t, c, s);
+            }
+        }
+        m.x1 = x1n;
+        m.x2 = x2n;
+        m.h = dt;
+        m.valide = true;
+        return ve;
+    } else if (c.order() == 1) {
+        if constexpr (choixMeth == 3) {
+            return rk4_order1(x1, dt, t, c, s, extra);
+        } else if constexpr (choixMeth == 4) {
+            return heun_order1(x1, dt, t, c, s, extra);
+        } else {
+            // Défaut ou choix 1 (Euler) ou 2 (Euler 2x2 pas applicable)
+            return euler1(x1, dt, t, c, s, extra);
+        }
+    } else {
+        if constexpr (choixMeth == 2) {
+            return euler2(x1, x2, dt, t, c, s);
+        } else if constexpr (choixMeth == 4) {
+            return heun(x1, x2, dt, t, c, s);
+        } else {
+            // choix 3 ou défaut : RK4
+            return rk4(x1, x2, dt, t, c, s);
+        }
+    }
+}
+
+// Source vue depuis un intervalle sans discontinuité [debut, fin] : les
+// instants d'évaluation sont ramenés dans l'intervalle, si bien qu'un étage
+// placé sur un front voit la valeur du côté courant (limite à gauche en fin de
+// sous-pas, à droite au début du suivant) et non celle d'après le front.
+template <class Src>
+struct SourceSegment {
+    const Src& s;
+    double debut, fin;
+    double ve(double t) const { return s.ve(t < debut ? debut : (t > fin ? fin : t)); }
+};
+
+// Source lue dans un tableau précalculé (Source::remplir) aux instants
+// t0 + k*dt/2 : couvre les étages t, t+dt/2 et t+dt de toutes les méthodes à
+// pas fixe. Un accès mémoire au lieu d'un sin() ou d'un fmod() par étage.
+struct SourceTabulee {
+    const double* valeurs;
+    double t0, inverseDemiPas;
+    double ve(double t) const {
+        return valeurs[static_cast<int>((t - t0) * inverseDemiPas + 0.5)];
+    }
+};
+
+// Nombre de pas dont la source est précalculée d'un coup
+constexpr int PAS_PAR_BLOC_SOURCE = 256;
+
+// Nombre maximal de sous-pas dans un pas coupé sur les fronts. Au-delà (fronts
+// plus serrés que le pas, ou source dont les fronts n'avancent plus), la fin
+// du pas est faite d'un seul tenant et l'intervalle de la source est recalé
+// après le pas : la boucle se termine toujours.
+constexpr int SOUS_PAS_MAX = 1024;
+
+// Pas [t, t+dt] qui touche une discontinuité de la source : coupé en sous-pas
+// qui s'arrêtent exactement sur elle. [debutSeg, finSeg] est l'intervalle
+// régulier courant, avancé à chaque front franchi. Retourne ve(t).
+template <int choixMeth, class Circ, class Src>
+double pasCoupe(double& x1, double& x2, double dt, double t, const Circ& c, const Src& s,
+                double extra, MemoirePas& m, double& debutSeg, double& finSeg, double marge) {
+    double tFin = t + dt;
+    double tc = t;
+    double Vin = s.ve(t);
+    bool premier = true;
+    for (int sousPas = 1;; ++sousPas) {
+        bool force = sousPas > SOUS_PAS_MAX;
+        bool front = !force && finSeg < tFin + marge;   // le pas atteint un front
+        double fin = (!force && finSeg < tFin - marge) ? finSeg : tFin;
+        if (fin - tc > marge) {
+            double v = (s.estContinue() || force)
+                ? pas<choixMeth>(x1, x2, fin - tc, tc, c, s, extra, m)
+                : pas<choixMeth>(x1, x2, fin - tc, tc, c,
+                                 SourceSegment<Src>{s, debutSeg + marge, finSeg - marge}, extra, m);
+            if (premier) { Vin = v; premier = false; }
+        }
+        if (force) {
+            debutSeg = tFin;
+            finSeg = s.prochaineDiscontinuite(tFin);
+            m.valide = false;
+            break;
+        }
+        if (!front) break;
+        // Redémarrage sur le front : nouvel intervalle de la source,
+        // le passé des méthodes multipas n'est plus utilisable
+        tc = fin;
+        debutSeg = finSeg;
+        finSeg = s.prochaineDiscontinuite(finSeg);
+        m.valide = false;
+        if (tFin - tc <= marge) break;
+    }
+    return Vin;
+}
+
+// Boucle de simulation complète pour un triplet (circuit, source, méthode) figé.
+// Même contenu que la boucle historique de main.cpp ; chaque point (t, Vin, x1)
+// est passé à sortie(t, Vin, x1) (écriture CSV, statistiques, ...).
+// La source est précalculée par blocs de PAS_PAR_BLOC_SOURCE pas
+// (Source::remplir) et les étages lisent ce tableau.
+// Un pas [t, t+dt] qui contient une discontinuité de la source (front de
+// créneau, début d'échelon, ...) est coupé en sous-pas qui s'arrêtent
+// exactement sur elle : la méthode garde son ordre au lieu de tomber à
+// l'ordre 1 sur chaque front. La grille de sortie reste t_i = i*dt.
+//
+// Reprise : la boucle part de e.indice avec l'état (x1, x2, e) d'une boucle
+// précédente et va jusqu'à npas (plus grand ou égal : prolongement de
+// l'horizon). Les blocs de la source restent alignés sur les multiples de
+// PAS_PAR_BLOC_SOURCE depuis i = 0 : le résultat est identique, bit à bit, à
+// celui d'une seule boucle. jalon(e, x1, x2) est appelé en fin de bloc quand
+// l'indice atteint est un multiple de intervalle (0 : jamais).
+template <int choixMeth, class Circ, class Src, class Sortie, class Jalon>
+void boucle(const Circ& c, const Src& s, double extra, int npas, double dt,
+            double& x1, double& x2, EtatBoucle& e, Sortie&& sortie, int intervalle, Jalon&& jalon) {
+    MemoirePas& m = e.m;
+    if constexpr (choixMeth == 10) {
+        if (c.lineaire()) m.exact.construire(c, extra, dt);
+    }
+
+    // Intervalle régulier courant de la source ; t = 0 est une borne exacte.
+    // La marge absorbe les arrondis sur la position des fronts.
+    const double marge = 1e-7 * dt;
+    if (!e.demarre) {
+        e.debutSeg = -std::numeric_limits<double>::infinity();
+        e.finSeg = s.prochaineDiscontinuite(0.0);
+        e.demarre = true;
+    }
+    double debutSeg = e.debutSeg;
+    double finSeg = e.finSeg;
+
+    double tampon[2 * PAS_PAR_BLOC_SOURCE + 1];
+    for (int i0 = e.indice - e.indice % PAS_PAR_BLOC_SOURCE; i0 <= npas; i0 += PAS_PAR_BLOC_SOURCE) {
+        const int i1 = std::min(npas + 1, i0 + PAS_PAR_BLOC_SOURCE);
+        const double t0 = i0 * dt;
+        // Bloc toujours complet, même au-delà de npas : chaque valeur ne
+        // dépend que du début du bloc (reprise au milieu d'un bloc bit à bit)
+        s.remplir(t0, 0.5 * dt, 2 * PAS_PAR_BLOC_SOURCE + 1, tampon);
+        const SourceTabulee tab{tampon, t0, 2.0 / dt};
+
+        for (int i = std::max(i0, e.indice); i < i1; ++i) {
+            double t = i * dt;
+            double Vin;
+            if (t > debutSeg + marge && finSeg > t + dt + marge) {
+                // Pas entièrement dans un intervalle régulier : source tabulée
+                Vin = pas<choixMeth>(x1, x2, dt, t, c, tab, extra, m);
+            } else {
+                Vin = pasCoupe<choixMeth>(x1, x2, dt, t, c, s, extra, m, debutSeg, finSeg, marge);
+            }
+
+            // pour avoir des sorties propres (éviter les -0.000000)
+            if (std::fabs(x1) < 1e-12) x1 = 0.0;
+            if (std::fabs(x2) < 1e-12) x2 = 0.0;
+
+            sortie(t, Vin, x1);
+        }
+
+        e.indice = i1;
+        if (intervalle > 0 && i1 % intervalle == 0) {
+            e.debutSeg = debutSeg;
+            e.finSeg = finSeg;
+            jalon(static_cast<const EtatBoucle&>(e), x1, x2);
+        }
+    }
+    e.debutSeg = debutSeg;
+    e.finSeg = finSeg;
+}
+
+// Boucle complète depuis t = 0, sans reprise
+template <int choixMeth, class Circ, class Src, class Sortie>
+void boucle(const Circ& c, const Src& s, double extra, int npas, double dt,
+            double& x1, double& x2, Sortie&& sortie) {
+    EtatBoucle e;
+    boucle<choixMeth>(c, s, extra, npas, dt, x1, x2, e, sortie, 0,
+                      [](const EtatBoucle&, double, double) {});
+}
+
+// Aiguillage (circuit, source) fait une seule fois : appelle
+// visiteur(circuitConcret, sourceConcrete) avec les types concrets.
+// Retourne false si un des types n'est pas connu.
+template <class Circ, class Visiteur>
+bool aiguillerSource(const Circ& c, const Source& source, Visiteur& v) {
+    if (auto s = dynamic_cast<const SinusSource*>(&source)) v(c, *s);
+    else if (auto s = dynamic_cast<const EchelonSource*>(&source)) v(c, *s);
+    else if (auto s = dynamic_cast<const TriangulaireSource*>(&source)) v(c, *s);
+    else if (auto s = dynamic_cast<const CreneauSource*>(&source)) v(c, *s);
+    else if (auto s = dynamic_cast<const RectangulaireSource*>(&source)) v(c, *s);
+    else return false;
+    return true;
+}
+
+template <class Visiteur>
+bool aiguillerTypes(const Circuit& circuit, const Source& source, Visiteur&& v) {
+    if (auto c = dynamic_cast<const CircuitA*>(&circuit)) return aiguillerSource(*c, source, v);
+    if (auto c = dynamic_cast<const CircuitB*>(&circuit)) return aiguillerSource(*c, source, v);
+    if (auto c = dynamic_cast<const CircuitC*>(&circuit)) return aiguillerSource(*c, source, v);
+    if (auto c = dynamic_cast<const CircuitD*>(&circuit)) return aiguillerSource(*c, source, v);
+    return false;
+}
+
+// Idem avec la méthode : appelle
+// visiteur(circuitConcret, sourceConcrete, std::integral_constant<int, choixMeth>{})
+template <class Visiteur>
+bool aiguiller(const Circuit& circuit, const Source& source, int choixMeth, Visiteur&& v) {
+    return aiguillerTypes(circuit, source, [&](const auto& c, const auto& s) {
+        switch (choixMeth) {
+            case 2: v(c, s, std::integral_constant<int, 2>{}); break;
+            case 3: v(c, s, std::integral_constant<int, 3>{}); break;
+            case 4: v(c, s, std::integral_constant<int, 4>{}); break;
+            case 6: v(c, s, std::integral_constant<int, 6>{}); break;
+            case 7: v(c, s, std::integral_constant<int, 7>{}); break;
+            case 8: v(c, s, std::integral_constant<int, 8>{}); break;
+            case 9: v(c, s, std::integral_constant<int, 9>{}); break;
+            case 10: v(c, s, std::integral_constant<int, 10>{}); break;
+            default: v(c, s, std::integral_constant<int, 1>{}); break;
+        }
+    });
+}
+
+} // namespace statique
+
+// Aiguillage unique (circuit, source, méthode) -> boucle template spécialisée.
+// Retourne false si le couple circuit/source n'est pas un type connu ; l'appelant
+// doit alors utiliser la boucle générique (SimContext + std::function).
+bool simulerStatique(const Circuit& circuit, const Source& source, double R2,
+                     int choixMeth, int npas, double dt,
+                     double& x1, double& x2, EcrivainAsynchrone& ecrivain);
+
+// Reprise d'une boucle (voir statique::boucle) : de etat.indice à npas ;
+// jalon(etat, x1, x2) tous les intervalle pas (multiple de
+// statique::PAS_PAR_BLOC_SOURCE, 0 : jamais)
+bool simulerStatique(const Circuit& circuit, const Source& source, double R2,
+                     int choixMeth, int npas, double dt,
+                     double& x1, double& x2, EtatBoucle& etat, EcrivainAsynchrone& ecrivain,
+                     int intervalle,
+                     const std::function<void(const EtatBoucle&, double, double)>& jalon);
+
+// Même aiguillage, échantillons rangés directement dans trois tableaux de
+// npas + 1 valeurs (bibliothèque, sans thread d'écriture)
+bool simulerStatique(const Circuit& circuit, const Source& source, double R2,
+                     int choixMeth, int npas, double dt,
+                     double& x1, double& x2, double* temps, double* vin, double* vout);
+
+// Reprise d'une boucle rangée dans trois tableaux : échantillons etat.indice
+// à npas, soit npas + 1 - etat.indice valeurs (spectre.hpp)
+bool simulerStatique(const Circuit& circuit, const Source& source, double R2,
+                     int choixMeth, int npas, double dt,
+                     double& x1, double& x2, EtatBoucle& etat,
+                     double* temps, double* vin, double* vout);
+
+// Même aiguillage, sans sortie : avance (x1, x2, etat) de etat.indice jusqu'à
+// npas, pour les analyses qui n'ont besoin que de l'état final (regime.hpp)
+bool avancerStatique(const Circuit& circuit, const Source& source, double R2,
+                     int choixMeth, int npas, double dt,
+                     double& x1, double& x2, EtatBoucle& etat);
+
+#endif // SOLVER_STATIC_HPP
@@ -0,0 +1,71 @@
+#ifndef SORTIE_BINAIRE_HPP
+#define SORTIE_BINAIRE_HPP
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Format binaire en colonnes (.bin), ouvert directement par numpy.memmap :
+//   - en-tête texte de TAILLE_ENTETE octets : lignes "cle=valeur" (magie,
+//     n, valides, dt, npas, colonnes et types, paramètres de la simulation),
+//     complété par des espaces ;
+//   - puis les colonnes temps, Vin, Vout : n float64 little-endian contigus
+//     chacune.
+// Lecture en Python, sans aucune analyse des données :
+//   np.memmap(chemin, dtype='<f8', mode='r', offset=4096, shape=(3, n))[:, :valides]
+// Le fichier est préalloué à sa taille finale (n connu : npas + 1) et rempli
+// à travers un mmap.
+
+class SortieBinaire {
+public:
+    static const std::size_t TAILLE_ENTETE = 4096;
+
+    using Parametres = std::vector<std::pair<std::string, std::string>>;
+
+    SortieBinaire() = default;
+    ~SortieBinaire();
+
+    SortieBinaire(const SortieBinaire&) = delete;
+    SortieBinaire& operator=(const SortieBinaire&) = delete;
+
+    // Crée le fichier pour n échantillons ; false (avec un message) en cas d'échec
+    bool ouvrir(const std::string& chemin, std::size_t n, const Parametres& parametres);
+
+    // Noms des trois colonnes annoncés dans l'en-tête (défaut temps, Vin,
+    // Vout) ; à fixer avant ouvrir()
+    void nommerColonnes(const std::string& c1, const std::string& c2, const std::string& c3) {
+        noms_ = c1 + ":<f8," + c2 + ":<f8," + c3 + ":<f8";
+    }
+
+    // Ajoute un échantillon à la suite (ignoré au-delà de n)
+    void ajouter(double t, double vin, double vout) {
+        if (valides_ < n_) {
+            colonnes_[valides_] = t;
+            colonnes_[n_ + valides_] = vin;
+            colonnes_[2 * n_ + valides_] = vout;
+            ++valides_;
+        }
+    }
+
+    // Écrit l'en-tête définitif (nombre d'échantillons valides) et ferme
+    void fermer();
+
+    bool ouvert() const { return base_ != nullptr; }
+    std::size_t taille() const { return taille_; }
+
+private:
+    std::string chemin_;
+    Parametres parametres_;
+    std::string noms_ = "temps:<f8,Vin:<f8,Vout:<f8";
+    std::size_t n_ = 0;
+    std::size_t valides_ = 0;
+    std::size_t taille_ = 0;
+    char* base_ = nullptr;          // début du fichier projeté
+    double* colonnes_ = nullptr;    // base_ + TAILLE_ENTETE
+    int fd_ = -1;
+
+    void ecrireEntete();
+};
+
+#endif // SORTIE_BINAIRE_HPP
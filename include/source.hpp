@@ -1,6 +1,10 @@
 #ifndef SOURCE_HPP
 #define SOURCE_HPP
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
 #include <string>
 
 
@@ -12,7 +16,48 @@ public:
     virtual double ve(double t) const = 0;
     virtual std::string getType() const = 0;
 
+    // Prochain instant de discontinuité (front, début d'échelon, pointe du
+    // triangle) strictement après t ; infini si la source n'en a plus.
+    // Les intégrateurs s'arrêtent exactement sur ces instants au lieu de
+    // les enjamber (voir statique::boucle et rk45::integrer).
+    // Par défaut : seule la mise en route à t = 0.
+    virtual double prochaineDiscontinuite(double t) const {
+        return (t < 0.0) ? 0.0 : std::numeric_limits<double>::infinity();
+    }
+
+    // Vrai si le signal est continu : ses discontinuités ne portent que sur
+    // la pente (triangle), sa valeur sur un point d'arrêt n'est pas ambiguë
+    virtual bool estContinue() const { return false; }
+
+    // Évaluation par blocs : valeurs[k] = ve(t0 + k*dt), k = 0..n-1.
+    // Les sources périodiques évitent sin() et fmod() à chaque échantillon
+    // (récurrence de rotation, accumulateur de phase) ; par défaut : ve().
+    virtual void remplir(double t0, double dt, std::size_t n, double* valeurs) const {
+        for (std::size_t k = 0; k < n; ++k) valeurs[k] = ve(t0 + k * dt);
+    }
+
 protected:
+    // Vrai si la fréquence f donne une période positive et finie
+    static bool frequenceValide(double f) {
+        return f > 0.0 && std::isfinite(f) && std::isfinite(1.0 / f);
+    }
+
+    // Plus petit instant k*periode + phase (k entier) situé après t, toujours
+    // strictement plus grand que t (infini si la période n'est pas valide).
+    // La tolérance évite de renvoyer le front sur lequel on vient de s'arrêter.
+    static double prochainFront(double t, double periode, double phase) {
+        if (!(periode > 0.0) || !std::isfinite(periode)) return std::numeric_limits<double>::infinity();
+        double k = std::floor((t - phase + 1e-9 * periode) / periode) + 1.0;
+        double front = k * periode + phase;
+        if (!(front > t)) front = (k + 1.0) * periode + phase;
+        return (front > t) ? front : std::nextafter(t, std::numeric_limits<double>::infinity());
+    }
+
+    // Phases (fraction de période dans [0, 1[) des instants t0 + k*dt pour une
+    // fréquence f ; -1 pour les instants t < 0. L'accumulateur est recalé sur
+    // t*f au début de chaque bloc : pas de dérive, boucle interne vectorisable.
+    static void remplirPhases(double t0, double dt, std::size_t n, double f, double* phases);
+
     // Attributs communs à TOUTES les sources
     double amplitude_;  
     double offset_;     
@@ -21,12 +66,14 @@ protected:
 
 // Source Sinus : V(t) = A*sin(2πft)
 
-class SinusSource : public Source {
+class SinusSource final : public Source {
 public:
     SinusSource();
     SinusSource(double amplitude, double frequency, double offset);
     double ve(double t) const override;
     std::string getType() const override { return "Sinus"; }
+    bool estContinue() const override { return true; }
+    void remplir(double t0, double dt, std::size_t n, double* valeurs) const override;
     
 private:
     // amplitude_ et offset_ sont HÉRITÉS de Source
@@ -36,12 +83,14 @@ private:
 
 // Source Échelon : V(t) = 0 si t<t0, V si t≥t0
 
-class EchelonSource : public Source {
+class EchelonSource final : public Source {
 public:
     EchelonSource();
     EchelonSource(double amplitude, double startTime = 0.0);
     double ve(double t) const override;
+    double prochaineDiscontinuite(double t) const override;
     std::string getType() const override { return "Echelon"; }
+    void remplir(double t0, double dt, std::size_t n, double* valeurs) const override;
     
 private:
     // amplitude_ et offset_ sont HÉRITÉS de Source
@@ -50,12 +99,15 @@ private:
 
 // Source Triangulaire
 
-class TriangulaireSource : public Source {
+class TriangulaireSource final : public Source {
 public:
     TriangulaireSource();
     TriangulaireSource(double amplitude, double frequency, double offset);
     double ve(double t) const override;                       
+    double prochaineDiscontinuite(double t) const override;
     std::string getType() const override { return "Triangulaire"; }
+    bool estContinue() const override { return true; }
+    void remplir(double t0, double dt, std::size_t n, double* valeurs) const override;
 
 private:
     // amplitude_ et offset_ sont HÉRITÉS de Source
@@ -64,29 +116,158 @@ private:
 
 // Source Créneau
 
-class CreneauSource : public Source {
+class CreneauSource final : public Source {
 public:
     CreneauSource();
     CreneauSource(double amplitude, double frequency, double dutyCycle, double offset);
     double ve(double t) const override;                    
+    double prochaineDiscontinuite(double t) const override;
     std::string getType() const override { return "Creneau"; }          
+    void remplir(double t0, double dt, std::size_t n, double* valeurs) const override;
 private:
     // amplitude_ et offset_ sont HÉRITÉS de Source
     double frequency_;
     double dutyCycle_;
 };
 
-class RectangulaireSource : public Source {
+class RectangulaireSource final : public Source {
 public:
     RectangulaireSource();
     RectangulaireSource(double amplitude, double frequency, double dutyCycle, double offset);
     double ve(double t) const override;                    
+    double prochaineDiscontinuite(double t) const override;
     std::string getType() const override { return "Rectangulaire"; }          
+    void remplir(double t0, double dt, std::size_t n, double* valeurs) const override;
 private:
     // amplitude_ et offset_ sont HÉRITÉS de Source
     double frequency_;
     double dutyCycle_;
 };  
 
+// Définitions inline de ve(t) : visibles par les noyaux templates
+// (solver_static.hpp) pour que l'évaluation de la source soit inlinée.
+
+// Calcul de la valeur : signal sinusodal
+inline double SinusSource::ve(double t) const {
+    // Toutes les sources sont nulles pour t < 0
+    if (t < 0.0) {
+        return 0.0;
+    }
+
+    return amplitude_ * sin(2 * M_PI * frequency_ * t) + offset_;
+}
+
+// Calcul de la valeur : signal échelon
+inline double EchelonSource::ve(double t) const {
+    // Toutes les sources sont nulles pour t < 0
+    if (t < 0.0) {
+        return 0.0;
+    }
+
+    if (t < startTime_) {
+        return offset_;               // Avant le début de l'échelon
+    } else {
+        return amplitude_ + offset_;  // Après le début de l'échelon
+    }
+}
+
+// Calcul de la valeur : signal triangulaire
+inline double TriangulaireSource::ve(double t) const {
+    // Null for negative time per specification
+    if (t < 0.0) {
+        return 0.0;
+    }
+
+    double period = 1.0 / frequency_;
+    double timeInPeriod = fmod(t, period);
+    if (timeInPeriod < 0.0) timeInPeriod += period;
+    double halfPeriod = period / 2.0;
+
+    if (timeInPeriod < halfPeriod) {
+        // Montée : de offset_ à (offset_ + amplitude_)
+        return offset_ + (amplitude_ / halfPeriod) * timeInPeriod;
+    } else {
+        // Descente : de (offset_ + amplitude_) à offset_
+        return offset_ + amplitude_ - (amplitude_ / halfPeriod) * (timeInPeriod - halfPeriod);
+    }
+}
+
+// Calcul de la valeur : signal carré/créneau
+// Remplacé : getValue -> ve ; ajout de la condition t < 0
+inline double CreneauSource::ve(double t) const {
+    // 1) Toutes les sources sont nulles pour t < 0
+    if (t < 0.0) {
+        return 0.0;
+    }
+
+    // 2) Calcul du créneau pour t >= 0
+    double period = 1.0 / frequency_;
+    double timeInPeriod = fmod(t, period);  // modulo pour doubles
+    if (timeInPeriod < 0.0) {
+        timeInPeriod += period; // sécurise pour valeurs négatives éventuelles
+    }
+    double onTime = period * dutyCycle_;
+
+    if (timeInPeriod < onTime) {
+        return amplitude_ + offset_; // partie haute
+    } else {
+        return offset_;              // partie basse
+    }
+}
+
+// Calcul de la valeur : signal rectangulaire
+inline double RectangulaireSource::ve(double t) const {
+    // 1) Null for negative time
+    if (t < 0.0) {
+        return 0.0;
+    }
+
+    double period = 1.0 / frequency_;
+    double timeInPeriod = fmod(t, period);  // modulo fonctionne avec les doubles
+    if (timeInPeriod < 0.0) timeInPeriod += period;
+    double onTime = period * dutyCycle_;
+    
+    if ( timeInPeriod < onTime ) {
+        return amplitude_ + offset_;             // Dans la partie haute
+    } else {
+        return offset_;                          // Dans la partie basse
+    }
+}
+
+// Instants de discontinuité (mêmes conventions que ve : nulle pour t < 0)
+
+// Échelon : mise en route à t = 0, puis front à startTime_
+inline double EchelonSource::prochaineDiscontinuite(double t) const {
+    if (t < 0.0) return 0.0;
+    if (t + 1e-9 * std::fabs(startTime_) < startTime_) return startTime_;
+    return std::numeric_limits<double>::infinity();
+}
+
+// Triangle : signal continu, mais sa pente change à chaque demi-période
+inline double TriangulaireSource::prochaineDiscontinuite(double t) const {
+    if (t < 0.0) return 0.0;
+    if (!frequenceValide(frequency_)) return std::numeric_limits<double>::infinity();
+    return prochainFront(t, 0.5 / frequency_, 0.0);
+}
+
+// Créneau : fronts montants en k*T, descendants en k*T + dutyCycle_*T
+// (aucun front si le rapport cyclique vaut 0 ou 1, ou si la fréquence n'est
+// pas positive et finie)
+inline double CreneauSource::prochaineDiscontinuite(double t) const {
+    if (t < 0.0) return 0.0;
+    if (!(dutyCycle_ > 0.0 && dutyCycle_ < 1.0) || !frequenceValide(frequency_))
+        return std::numeric_limits<double>::infinity();
+    double period = 1.0 / frequency_;
+    return std::min(prochainFront(t, period, 0.0), prochainFront(t, period, dutyCycle_ * period));
+}
+
+// Rectangulaire : mêmes fronts que le créneau
+inline double RectangulaireSource::prochaineDiscontinuite(double t) const {
+    if (t < 0.0) return 0.0;
+    if (!(dutyCycle_ > 0.0 && dutyCycle_ < 1.0) || !frequenceValide(frequency_))
+        return std::numeric_limits<double>::infinity();
+    double period = 1.0 / frequency_;
+    return std::min(prochainFront(t, period, 0.0), prochainFront(t, period, dutyCycle_ * period));
+}
 
 #endif // SOURCE_HPP
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef SPECTRE_HPP
+#define SPECTRE_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Analyse spectrale de Vin et Vout en régime permanent : amplitudes des
+// harmoniques et taux de distorsion harmonique (THD), sans passer par le CSV
+// complet. Usage : be-sim --spectre [cle=valeur ...]
+// Clés de simulation : celles de be-sim --regime (source périodique, méthode
+// à pas fixe, pas_periode, rtol, atol, periodes_max), plus :
+//   periodes=K            périodes de la source analysées (défaut 10)
+//   harmoniques=H         harmoniques prises en compte (défaut 20)
+//   regime=tir|transitoire
+//                         fenêtre partant de l'état du régime établi trouvé
+//                         par la méthode de tir (défaut), ou après un
+//                         transitoire depuis l'état nul
+//   ignorer=P             périodes du transitoire écartées avant la fenêtre
+//                         (regime=transitoire, défaut 100)
+//   sortie=chemin.csv     raies 0 à H*K : colonnes frequence, vin, vout
+//                         (amplitudes) ; les harmoniques 1 à H, avec leurs
+//                         phases, vont dans <chemin>_harmoniques.csv
+//                         (défaut resultats/spectre/spectre.csv)
+//
+// La fenêtre couvre exactement K périodes, soit N = K * pas_periode
+// échantillons : l'harmonique h tombe sur la raie h*K, sans fuite spectrale
+// ni fenêtre de pondération. La FFT (fft.hpp) accepte toute longueur N.
+
+struct ResultatSpectre {
+    double fondamentale = 0.0;              // Hz
+    int periodes = 0;                       // K : l'harmonique h est la raie h*K
+    int harmoniques = 0;                    // harmoniques comptées dans le THD (<= H)
+    std::vector<double> frequence;          // raie k : k / (N dt), k = 0..N/2
+    std::vector<double> amplitudeVin;       // amplitude crête (raie 0 : valeur moyenne)
+    std::vector<double> amplitudeVout;
+    std::vector<double> phaseVin;           // degrés, par rapport à un cosinus
+    std::vector<double> phaseVout;
+    double thdVin = 0.0, thdVout = 0.0;     // sqrt(A2² + ... + AH²) / A1 (NaN si A1 = 0)
+};
+
+// vin et vout : n échantillons alignés (même instant), pas dt, sur exactement
+// periodes périodes de la source. false (avec un message) si la fenêtre est invalide
+bool analyserSpectre(const double* vin, const double* vout, std::size_t n, int periodes,
+                     int harmoniques, double dt, ResultatSpectre& r, std::string& erreur);
+
+// Point d'entrée du mode spectre (main.cpp)
+int lancerSpectre(int argc, char** argv);
+
+#endif // SPECTRE_HPP
@@ -0,0 +1,47 @@
+#ifndef TRANSITOIRE_HPP
+#define TRANSITOIRE_HPP
+
+#include "rk45.hpp"
+#include "solver_static.hpp"
+#include <cstdint>
+#include <string>
+
+// Longues simulations transitoires avec points de reprise.
+// Usage : be-sim --transitoire [cle=valeur ...]
+// Clés de simulation : celles de be-sim --serveur (circuit, source, A, f,
+// duty, offset, t0, R, R2, C, L, diode, Is, n, Vt, methode, npas, tmax, rtol,
+// atol), plus :
+//   sortie=chemin.csv   résultat (défaut resultats/transitoire/transitoire.csv)
+//   point=chemin        point de reprise (défaut <sortie>.reprise)
+//   intervalle=N        pas entre deux points de reprise (défaut 1048576)
+//   reprendre=oui|non   repartir du point de reprise s'il existe (défaut oui)
+// Le point de reprise est réécrit tous les `intervalle` pas, par le thread
+// d'écriture une fois les lignes qu'il couvre écrites dans le CSV, puis en
+// fin de calcul. Au lancement, s'il existe et décrit la même configuration
+// (circuit, source, méthode, tolérances), le CSV est ramené aux lignes qu'il
+// couvre et le calcul repart de là :
+//   - après un arrêt brutal, seul l'intervalle en cours est recalculé ;
+//   - avec un tmax plus grand, seul le nouvel intervalle est simulé (le pas
+//     dt du point est conservé, npas = tmax / dt).
+// Méthodes à pas fixe : le CSV obtenu est identique, octet pour octet, à
+// celui d'un calcul d'une traite. Méthode 5 : mêmes pas tant que tmax ne
+// change pas ; un prolongement repart du dernier pas proposé.
+
+struct PointReprise {
+    std::string identite;           // identiteTrajectoire() de la configuration
+    double dt = 0.0;
+    double x1 = 0.0, x2 = 0.0;
+    EtatBoucle boucle;              // méthodes à pas fixe
+    EtatRK45 rk45;                  // méthode 5
+    std::uintmax_t octets = 0;      // taille du CSV couvert par le point
+};
+
+// Fichier texte "cle=valeur", réels sous leur écriture la plus courte exacte ;
+// écrit sous un nom temporaire puis renommé (jamais de point à moitié écrit)
+bool ecrirePointReprise(const std::string& chemin, const PointReprise& p);
+bool lirePointReprise(const std::string& chemin, PointReprise& p, std::string& erreur);
+
+// Point d'entrée du mode transitoire (main.cpp)
+int lancerTransitoire(int argc, char** argv);
+
+#endif // TRANSITOIRE_HPP
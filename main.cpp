@@ -1,14 +1,31 @@
+#include "analyse_ac.hpp"
+#include "balayage.hpp"
+#include "banc.hpp"
 #include "circuit.hpp"
+#include "decimateur.hpp"
+#include "espace_etat.hpp"
+#include "flux_trames.hpp"
+#include "netlist.hpp"
+#include "ecrivain.hpp"
+#include "rk45.hpp"
+#include "serveur.hpp"
 #include "sim_context.hpp"
 #include "simulation.hpp"
+#include "sortie_binaire.hpp"
 #include "solver.hpp"
+#include "solver_static.hpp"
+#include "transitoire.hpp"
+#include "regime.hpp"
 #include "source.hpp"
+#include "spectre.hpp"
 #include <cmath>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <limits> // pour numeric_limits utilisé lors de la lecture utilisateur
 #include <memory>
+#include <sstream>
 
 // déclaration fonction initialisation source
 std::unique_ptr<Source> initialiserSource(bool useDefaults, double &A,
@@ -24,16 +41,100 @@ using namespace std;
 // - Choix du circuit (A/B/C/D)
 // - Appel fonction lecture des paramètres de simulation (npas, tmax)
 // - Choix type de source et variables associées
-// - Choix de la méthode numérique (Euler / Euler 2x2 / RK4 / Heun)
+// - Choix de la méthode numérique (Euler / Euler 2x2 / RK4 / Heun / RK45 /
+//   méthodes implicites / automatique)
 // - Boucle de simulation -> écriture CSV (temps, Vin, Vout)
 
 // - Si test:
 // - Choix du circuit
 // - Choix de la source
 // -
+
+// - Modes non interactifs (ligne de commande) :
+// - be-sim --balayage [fichier] [cle=valeur ...] : balayage de paramètres
+//   multithread (voir balayage.hpp)
+// - be-sim --binaire : simulation interactive, résultats écrits en colonnes
+//   float64 dans circuit_output.bin (voir sortie_binaire.hpp) au lieu du CSV
+// - be-sim --precision=N : CSV avec N chiffres significatifs (par défaut :
+//   écriture la plus courte qui relit exactement chaque valeur)
+// - be-sim --trace=N [--lttb] : écrit aussi circuit_output_trace.csv, réduit à
+//   au plus N points pour le tracé (min/max par seau, ou LTTB)
+// - be-sim --flux : trames binaires sur stdout au fil de l'intégration, sans
+//   fichier (voir flux_trames.hpp) ; questions et messages passent sur stderr
+// - be-sim --serveur [socket] [threads=N] : serveur persistant sur une socket
+//   Unix, requêtes cle=valeur et réponses en trames (voir serveur.hpp)
+// - be-sim --transitoire [cle=valeur ...] : longue simulation avec points de
+//   reprise, reprise après arrêt et prolongement de l'horizon (voir transitoire.hpp)
+// - be-sim --regime [cle=valeur ...] : régime permanent périodique par la
+//   méthode de tir, ou transitoire arrêté une fois établi (voir regime.hpp)
+// - be-sim --ac [cle=valeur ...] : gain et phase de Vout/Vin sur un balayage
+//   logarithmique de fréquences, sans simulation temporelle (voir analyse_ac.hpp)
+// - be-sim --spectre [cle=valeur ...] : spectres de Vin et Vout, harmoniques et
+//   THD sur un nombre entier de périodes du régime établi (voir spectre.hpp)
+// - be-sim --netlist fichier.cir [cle=valeur ...] : circuit quelconque décrit
+//   par une netlist, analyse nodale modifiée et LU creuse (voir netlist.hpp)
+// - be-sim --etat [cle=valeur ...] : circuit linéaire d'ordre quelconque sous
+//   forme d'état, échelles et cellules RLC en cascade (voir espace_etat.hpp)
+// - be-sim --banc [cle=valeur ...] : banc d'essai, temps par pas des solveurs
+//   sur chaque circuit et source, débit du chemin CSV, export JSON (voir banc.hpp)
 // ==========================
 
-int main() {
+int main(int argc, char **argv) {
+
+  if (argc > 1 && string(argv[1]) == "--balayage") {
+    return lancerBalayage(argc - 2, argv + 2);
+  }
+  if (argc > 1 && string(argv[1]) == "--serveur") {
+    return lancerServeur(argc - 2, argv + 2);
+  }
+  if (argc > 1 && string(argv[1]) == "--transitoire") {
+    return lancerTransitoire(argc - 2, argv + 2);
+  }
+  if (argc > 1 && string(argv[1]) == "--regime") {
+    return lancerRegime(argc - 2, argv + 2);
+  }
+  if (argc > 1 && string(argv[1]) == "--ac") {
+    return lancerAC(argc - 2, argv + 2);
+  }
+  if (argc > 1 && string(argv[1]) == "--spectre") {
+    return lancerSpectre(argc - 2, argv + 2);
+  }
+  if (argc > 1 && string(argv[1]) == "--netlist") {
+    return lancerNetlist(argc - 2, argv + 2);
+  }
+  if (argc > 1 && string(argv[1]) == "--etat") {
+    return lancerEtat(argc - 2, argv + 2);
+  }
+  if (argc > 1 && string(argv[1]) == "--banc") {
+    return lancerBanc(argc - 2, argv + 2);
+  }
+  bool sortieColonnes = false;
+  bool sortieFlux = false;
+  EmetteurCsv formatCsv;
+  size_t pointsTrace = 0;
+  Decimateur::Mode modeTrace = Decimateur::Mode::MinMax;
+  for (int a = 1; a < argc; ++a) {
+    string option = argv[a];
+    if (option == "--binaire") {
+      sortieColonnes = true;
+    } else if (option == "--flux") {
+      sortieFlux = true;
+    } else if (option.rfind("--precision=", 0) == 0) {
+      formatCsv = EmetteurCsv(EmetteurCsv::Mode::Fixe, atoi(option.c_str() + 12));
+    } else if (option.rfind("--trace=", 0) == 0) {
+      pointsTrace = static_cast<size_t>(atol(option.c_str() + 8));
+    } else if (option == "--lttb") {
+      modeTrace = Decimateur::Mode::Lttb;
+    } else {
+      cerr << "Option inconnue ignorée : " << option << endl;
+    }
+  }
+
+  // Flux : stdout ne porte que les trames, le texte habituel va sur stderr
+  streambuf *coutInitial = cout.rdbuf();
+  if (sortieFlux) {
+    cout.rdbuf(cerr.rdbuf());
+  }
 
   cout << "=== Simulateur de Circuits Électriques ===" << endl;
 
@@ -69,6 +170,7 @@ int main() {
   // Déclaration des paramètres du circuit (valeurs par défaut)
   double R = 1000.0, C = 1e-6, L = 1e-3;
   double R2 = 1000.0;
+  ParametresDiode diode; // circuit B
 
   // Choix et création de la source
   double A = 5.0, f = 50.0, off = 0.0;
@@ -85,9 +187,32 @@ int main() {
     cout << "  2 - Euler (système 2x2)" << endl;
     cout << "  3 - Runge-Kutta 4 (2x2)" << endl;
     cout << "  4 - Heun (2x2)" << endl;
+    cout << "  5 - Dormand-Prince RK45 (pas adaptatif)" << endl;
+    cout << "  6 - Euler implicite (circuits raides)" << endl;
+    cout << "  7 - Trapèzes (implicite)" << endl;
+    cout << "  8 - BDF2 (implicite)" << endl;
+    cout << "  9 - Automatique (RK4 ou BDF2 selon la raideur)" << endl;
+    cout << "  10 - Exacte (propagateur exp(A dt), circuits A, C, D)" << endl;
     cin >> choixMeth;
   }
 
+  // Tolérances du pas adaptatif (méthode 5 uniquement)
+  OptionsRK45 optRK45;
+  if (!useDefaults && choixMeth == 5) {
+    cout << "Tolérance relative ? [1e-6] ";
+    if (!(cin >> optRK45.rtol)) {
+      cin.clear();
+      cin.ignore(numeric_limits<streamsize>::max(), '\n');
+      optRK45.rtol = 1e-6;
+    }
+    cout << "Tolérance absolue ? [1e-9] ";
+    if (!(cin >> optRK45.atol)) {
+      cin.clear();
+      cin.ignore(numeric_limits<streamsize>::max(), '\n');
+      optRK45.atol = 1e-9;
+    }
+  }
+
   // Si on utilise les paramètres par défaut, afficher un résumé compact
   if (useDefaults) {
     cout << "Paramètres par défaut utilisés :" << endl;
@@ -134,6 +259,36 @@ int main() {
         C = 1e-6;
       }
 
+      // Seuil à 0,6 V par défaut, comme en --serveur ; Shockley sur demande
+      cout << "Modèle de la diode (seuil/shockley) ? [seuil] ";
+      string modeleDiode;
+      cin >> modeleDiode;
+      if (modeleDiode == "shockley") {
+        diode.shockley = true;
+      } else if (modeleDiode != "seuil") {
+        cout << "Modèle inconnu, seuil à 0,6 V utilisé" << endl;
+      }
+      if (diode.shockley) {
+        cout << "Is (A) ? [1e-14] ";
+        if (!(cin >> diode.Is) || !(diode.Is > 0.0)) {
+          cin.clear();
+          cin.ignore(numeric_limits<streamsize>::max(), '\n');
+          diode.Is = 1e-14;
+        }
+        cout << "n ? [1] ";
+        if (!(cin >> diode.n) || !(diode.n > 0.0)) {
+          cin.clear();
+          cin.ignore(numeric_limits<streamsize>::max(), '\n');
+          diode.n = 1.0;
+        }
+        cout << "Vt (V) ? [0.025852] ";
+        if (!(cin >> diode.Vt) || !(diode.Vt > 0.0)) {
+          cin.clear();
+          cin.ignore(numeric_limits<streamsize>::max(), '\n');
+          diode.Vt = 0.025852;
+        }
+      }
+
     } else {
       cout << "R (Ohms) ? [1000] ";
       if (!(cin >> R)) {
@@ -171,7 +326,7 @@ int main() {
     circuitPtr = make_unique<CircuitA>(R, C, f);
     break;
   case 'B':
-    circuitPtr = make_unique<CircuitB>(R, R2, C, f);
+    circuitPtr = make_unique<CircuitB>(R, R2, C, f, true, diode);
     break;
   case 'C':
     circuitPtr = make_unique<CircuitC>(R, C, L, f);
@@ -185,28 +340,124 @@ int main() {
     break;
   }
 
+  if (choixMeth == 10 && !circuitPtr->lineaire()) {
+    cout << "Méthode exacte : circuit non linéaire, RK4 utilisé à la place"
+         << endl;
+  }
+
   // États initiaux des variables d'état et wrappers
   // Ces éléments sont fournis par la structure SimContext, extraite en module
   SimContext ctx = createSimContext(*circuitPtr, *source, R2);
 
-  // Génération du fichier CSV pour tracer Vout(t)
+  // Paramètres rappelés dans l'en-tête des sorties binaires (fichier, flux)
+  auto texte = [](double v) {
+    ostringstream os;
+    os.precision(17);
+    os << v;
+    return os.str();
+  };
+  const SortieBinaire::Parametres parametres = {
+      {"dt", texte(sim.getDt())},
+      {"npas", to_string(sim.getNpas())},
+      {"tmax", texte(sim.getTmax())},
+      {"circuit", string(1, choixCircuit)},
+      {"methode", to_string(choixMeth)},
+      {"source", source->getType()},
+      {"R", texte(R)},
+      {"R2", texte(R2)},
+      {"C", texte(C)},
+      {"L", texte(L)}};
+
+  // Flux de trames sur stdout : aucun fichier
+  FluxTrames flux;
+  bool fluxOuvert =
+      sortieFlux &&
+      flux.ouvrir(static_cast<size_t>(sim.getNpas()) + 1, parametres);
+
+  // Génération du fichier de sortie pour tracer Vout(t)
   // Crée le dossier de sortie si nécessaire
-  std::filesystem::create_directories("resultats/simulations");
-  ofstream fichier("resultats/simulations/circuit_output.csv");
-  fichier << "temps,Vin,Vout" << endl;
+  if (!fluxOuvert) {
+    std::filesystem::create_directories("resultats/simulations");
+  }
+  string cheminSortie = "resultats/simulations/circuit_output.csv";
+
+  // Format binaire : fichier préalloué pour npas + 1 échantillons, l'en-tête
+  // rappelle les paramètres de la simulation
+  SortieBinaire sortieBinaire;
+  if (sortieColonnes && !fluxOuvert) {
+    if (sortieBinaire.ouvrir("resultats/simulations/circuit_output.bin",
+                             static_cast<size_t>(sim.getNpas()) + 1,
+                             parametres)) {
+      cheminSortie = "resultats/simulations/circuit_output.bin";
+    } else {
+      cout << "Sortie binaire indisponible, écriture CSV" << endl;
+    }
+  }
+
+  // CSV : temps écrits exactement comme i * dt
+  ofstream fichier;
+  formatCsv.fixerPas(sim.getDt());
+  if (!fluxOuvert && !sortieBinaire.ouvert()) {
+    fichier.open(cheminSortie);
+    fichier << "temps,Vin,Vout\n";
+  }
+
+  // Les échantillons passent par un thread d'écriture (paquets, pas de flush
+  // par ligne) : l'intégration n'attend le disque que si celui-ci ne suit pas
+  unique_ptr<EcrivainAsynchrone> ecrivainPtr;
+  if (fluxOuvert) {
+    ecrivainPtr = make_unique<EcrivainAsynchrone>(flux);
+  } else if (sortieBinaire.ouvert()) {
+    ecrivainPtr = make_unique<EcrivainAsynchrone>(sortieBinaire);
+  } else {
+    ecrivainPtr = make_unique<EcrivainAsynchrone>(fichier, formatCsv);
+  }
+  EcrivainAsynchrone &ecrivain = *ecrivainPtr;
+
+  // Trace réduite pour le tableau de bord, calculée au fil de l'écriture
+  Decimateur trace(static_cast<size_t>(sim.getNpas()) + 1, pointsTrace,
+                   modeTrace);
+  if (pointsTrace > 0) {
+    ecrivain.fixerTrace(trace);
+  }
+
+  // Méthode 5 : pas adaptatif, CSV échantillonné sur la même grille uniforme
+  // grâce à la sortie dense
+  bool boucleStatique = false;
+  if (choixMeth == 5) {
+    StatsRK45 stats = simulerRK45(*circuitPtr, *source, R2, sim.getNpas(),
+                                  sim.getTmax(), optRK45, ctx.x1, ctx.x2,
+                                  ecrivain);
+    boucleStatique = true;
+    cout << "RK45 : " << stats.pasAcceptes << " pas acceptés, "
+         << stats.pasRejetes << " rejetés, " << stats.evaluations
+         << " évaluations des dérivées (RK4 à pas fixe : "
+         << 4L * (sim.getNpas() + 1) << ")" << endl;
+  }
 
   // Boucle de simulation
+  // Chemin rapide : circuit, source et méthode aiguillés une seule fois vers
+  // une boucle template entièrement inlinée (voir solver_static.hpp)
+  if (!boucleStatique) {
+    boucleStatique = simulerStatique(*circuitPtr, *source, R2, choixMeth,
+                                     sim.getNpas(), sim.getDt(), ctx.x1,
+                                     ctx.x2, ecrivain);
+  }
 
-  for (int i = 0; i <= sim.getNpas(); ++i) {
+  // Chemin générique (types inconnus) : wrappers std::function du SimContext
+  for (int i = 0; !boucleStatique && i <= sim.getNpas(); ++i) {
 
-    // Calcul de l'entrée ve(t) à l'instant courant
+    // Instant courant ; ve(t) est fourni par le solveur 2x2 (champ fusionné)
+    // et calculé ici seulement pour les circuits d'ordre 1
     double t = i * sim.getDt();
-    double Vin = source->ve(t);
+    double Vin;
 
     // On applique la méthode numérique choisie suivant le type d'ordre du
     // circuit
     if (circuitPtr->order() == 1) {
 
+      Vin = source->ve(t);
+
       // 1er ordre : appliquer la méthode choisie
       if (choixMeth == 3) {
         rk4_order1(ctx.x1, sim.getDt(), t, ctx.f1);
@@ -218,21 +469,21 @@ int main() {
       }
     } else {
 
-      // 2ème ordre : utiliser les wrappers f2_1 / f2_2 et
+      // 2ème ordre : utiliser le champ fusionné f2
       // Différents cas en fonction de la méthode choisie choixMeth
 
       if (choixMeth == 2) {
-        euler2(ctx.x1, ctx.x2, sim.getDt(), t, ctx.f2_1, ctx.f2_2);
+        Vin = euler2(ctx.x1, ctx.x2, sim.getDt(), t, ctx.f2);
 
       } else if (choixMeth == 3) {
-        rk4(ctx.x1, ctx.x2, sim.getDt(), t, ctx.f2_1, ctx.f2_2);
+        Vin = rk4(ctx.x1, ctx.x2, sim.getDt(), t, ctx.f2);
 
       } else if (choixMeth == 4) {
-        heun(ctx.x1, ctx.x2, sim.getDt(), t, ctx.f2_1, ctx.f2_2);
+        Vin = heun(ctx.x1, ctx.x2, sim.getDt(), t, ctx.f2);
 
       } else {
         // défaut: RK4
-        rk4(ctx.x1, ctx.x2, sim.getDt(), t, ctx.f2_1, ctx.f2_2);
+        Vin = rk4(ctx.x1, ctx.x2, sim.getDt(), t, ctx.f2);
       }
     }
 
@@ -244,18 +495,54 @@ int main() {
       ctx.x2 = 0.0;
 
     // Tableau de sortie tension observée Vout = x1
-    fichier << t << "," << Vin << "," << ctx.x1 << endl;
+    ecrivain.ajouter(t, Vin, ctx.x1);
   }
 
-  fichier.close();
+  ecrivain.terminer();
+  if (pointsTrace > 0) {
+    trace.terminer();
+  }
+
+  if (fluxOuvert) {
+    // Trace puis résumé : le résumé est toujours la dernière trame
+    if (pointsTrace > 0) {
+      flux.envoyerTrace(trace);
+    }
+    flux.terminer({{"statut", "ok"},
+                   {"paquets", to_string(ecrivain.paquetsEcrits())},
+                   {"ecriture_ms", texte(ecrivain.dureeEcriture() * 1e3)},
+                   {"attente_ms", texte(ecrivain.attenteIntegrateur() * 1e3)}});
+    cout << " Flux : " << flux.trames() << " trames, " << flux.octets()
+         << " octets sur stdout" << endl;
+    cout.rdbuf(coutInitial);
+    return 0;
+  }
+
+  if (sortieBinaire.ouvert()) {
+    sortieBinaire.fermer();
+  } else {
+    fichier.close();
+  }
 
   // Message de succès et rappel des paramètres
   // Affichage pas et temps de simulation
 
-  cout << " Fichier 'resultats/simulations/circuit_output.csv' généré avec "
-          "succès !"
-       << endl;
+  cout << " Fichier '" << cheminSortie << "' généré avec succès !" << endl;
+  if (pointsTrace > 0) {
+    if (trace.ecrire("resultats/simulations/circuit_output_trace.csv",
+                     sim.getDt())) {
+      cout << " Trace 'resultats/simulations/circuit_output_trace.csv' : "
+           << trace.points().size() << " points" << endl;
+    } else {
+      cerr << "Impossible d'écrire la trace" << endl;
+    }
+  }
   cout << "   " << (sim.getNpas() + 1) << " points de 0 à " << sim.getTmax()
        << " secondes" << endl;
+  cout << "   Écriture : " << ecrivain.octetsEcrits() << " octets en "
+       << ecrivain.paquetsEcrits() << " paquets, "
+       << ecrivain.dureeEcriture() * 1e3 << " ms sur le thread d'écriture, "
+       << ecrivain.attenteIntegrateur() * 1e3
+       << " ms d'attente de l'intégrateur" << endl;
   return 0;
 }
\ No newline at end of file
@@ -0,0 +1,109 @@
+"""Comparaison du THD calculé par be-sim --spectre et par le chemin Python
+(CSV complet du transitoire, puis pandas + numpy.fft).
+
+    python3 python/bench_spectre.py [--be-sim ./be-sim] [--repetitions 3]
+                                    [cle=valeur ...]
+
+Les clé=valeur (circuit, source, A, f, R, C, methode, periodes, ignorer,
+pas_periode, harmoniques) sont passées aux deux chemins ; la même fenêtre
+(périodes ignorer à ignorer + periodes) est analysée des deux côtés.
+"""
+
+import argparse
+import csv
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+import numpy as np
+import pandas as pd
+
+DEFAUTS = {
+    "circuit": "B", "source": "1", "A": "5", "f": "50", "methode": "3",
+    "periodes": "10", "ignorer": "100", "pas_periode": "1000", "harmoniques": "20",
+}
+# Clés propres à --spectre, non transmises à --transitoire
+CLES_SPECTRE = ("periodes", "ignorer", "pas_periode", "harmoniques")
+
+
+def thd(amplitude, periodes, harmoniques):
+    harm = amplitude[periodes * np.arange(1, harmoniques + 1)]
+    return np.sqrt(np.sum(harm[1:] ** 2)) / harm[0]
+
+
+def chemin_python(be_sim, params, dossier):
+    """CSV complet écrit par be-sim, relu et analysé en Python."""
+    pas, periodes, ignorer = (int(params[c]) for c in ("pas_periode", "periodes", "ignorer"))
+    npas = (ignorer + periodes) * pas
+    tmax = (ignorer + periodes) / float(params["f"])
+    sortie = os.path.join(dossier, "transitoire.csv")
+    args = [f"{c}={v}" for c, v in params.items() if c not in CLES_SPECTRE]
+    debut = time.perf_counter()
+    subprocess.run([be_sim, "--transitoire", *args, f"npas={npas}", f"tmax={tmax!r}",
+                    f"sortie={sortie}", "reprendre=non"],
+                   check=True, stdout=subprocess.DEVNULL)
+    simulation = time.perf_counter() - debut
+    donnees = pd.read_csv(sortie)
+    fenetre = donnees.iloc[ignorer * pas:(ignorer + periodes) * pas]
+    n = len(fenetre)
+    resultat = {}
+    for colonne in ("Vin", "Vout"):
+        spectre = np.abs(np.fft.rfft(fenetre[colonne].to_numpy())) * 2.0 / n
+        resultat[colonne] = thd(spectre, periodes, int(params["harmoniques"]))
+    total = time.perf_counter() - debut
+    taille = os.path.getsize(sortie) + os.path.getsize(sortie + ".reprise")
+    return total, simulation, taille, resultat
+
+
+def chemin_cpp(be_sim, params, dossier):
+    """Spectre calculé dans le simulateur, seules les raies sont écrites."""
+    sortie = os.path.join(dossier, "spectre.csv")
+    args = [f"{c}={v}" for c, v in params.items()]
+    debut = time.perf_counter()
+    subprocess.run([be_sim, "--spectre", *args, "regime=transitoire", f"sortie={sortie}"],
+                   check=True, stdout=subprocess.DEVNULL)
+    total = time.perf_counter() - debut
+    harmoniques = os.path.join(dossier, "spectre_harmoniques.csv")
+    with open(harmoniques, newline="") as fichier:
+        lignes = list(csv.DictReader(fichier))
+    resultat = {}
+    for colonne, cle in (("Vin", "vin"), ("Vout", "vout")):
+        a = np.array([float(l[cle]) for l in lignes])
+        resultat[colonne] = np.sqrt(np.sum(a[1:] ** 2)) / a[0]
+    taille = os.path.getsize(sortie) + os.path.getsize(harmoniques)
+    return total, taille, resultat
+
+
+def main():
+    analyse = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    analyse.add_argument("--be-sim", default=os.path.join(os.path.dirname(__file__), "..", "be-sim"))
+    analyse.add_argument("--repetitions", type=int, default=3)
+    analyse.add_argument("params", nargs="*", help="cle=valeur")
+    options = analyse.parse_args()
+    params = dict(DEFAUTS)
+    for p in options.params:
+        cle, _, valeur = p.partition("=")
+        params[cle] = valeur
+
+    with tempfile.TemporaryDirectory() as dossier:
+        python = min((chemin_python(options.be_sim, params, dossier) for _ in range(options.repetitions)),
+                     key=lambda r: r[0])
+        cpp = min((chemin_cpp(options.be_sim, params, dossier) for _ in range(options.repetitions)),
+                  key=lambda r: r[0])
+
+    echantillons = (int(params["ignorer"]) + int(params["periodes"])) * int(params["pas_periode"])
+    print(f"Circuit {params['circuit']}, {echantillons} pas, fenêtre de {params['periodes']} périodes")
+    print(f"  Python (CSV + pandas + numpy) : {python[0] * 1e3:9.1f} ms "
+          f"(dont be-sim {python[1] * 1e3:.1f} ms), {python[2] / 1e6:.2f} Mo écrits")
+    print(f"  be-sim --spectre              : {cpp[0] * 1e3:9.1f} ms, {cpp[1] / 1e3:.2f} ko écrits")
+    print(f"  Accélération : x{python[0] / cpp[0]:.1f}")
+    for colonne in ("Vin", "Vout"):
+        a, b = python[3][colonne], cpp[2][colonne]
+        print(f"  THD {colonne:4s} : Python {100 * a:.9f} %, be-sim {100 * b:.9f} %, écart {abs(a - b):.2e}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
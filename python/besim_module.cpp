@@ -0,0 +1,217 @@
+// Module Python "besim" : liaisons de la bibliothèque (besim.hpp).
+// Construction : python3 setup.py build_ext --inplace (depuis la racine)
+//
+//   import besim, numpy as np
+//   r = besim.simuler(circuit='C', source=4, methode=3, npas=100000, tmax=2e-2, trace=4000)
+//   t, vin, vout = np.asarray(r['signal'])      # tableau (3, n) sans copie
+//
+// Les résultats passent par le cache du processus (cache_resultats.hpp),
+// en mémoire seulement : rien n'est écrit dans le dossier courant. Une
+// configuration déjà simulée est servie sans recalcul (r['cache'] vaut
+// 'memoire') ; cache=False force le calcul.
+// Les colonnes sont exposées par le protocole buffer (format 'd', forme
+// (3, n)) : numpy, memoryview ou struct y accèdent directement dans la
+// mémoire de ResultatSimulation, qui vit tant qu'une vue existe.
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include "besim.hpp"
+#include "cache_resultats.hpp"
+#include <memory>
+#include <new>
+#include <string>
+
+// --- Type besim.Colonnes : vue en lecture seule sur un Colonnes ---
+
+struct ObjetColonnes {
+    PyObject_HEAD
+    std::shared_ptr<const ResultatSimulation> resultat;   // propriétaire des tableaux
+    const Colonnes* colonnes;
+    Py_ssize_t forme[2];
+    Py_ssize_t pas[2];
+};
+
+static void colonnesDetruire(PyObject* self) {
+    ObjetColonnes* o = reinterpret_cast<ObjetColonnes*>(self);
+    o->resultat.~shared_ptr<const ResultatSimulation>();
+    Py_TYPE(self)->tp_free(self);
+}
+
+static int colonnesBuffer(PyObject* self, Py_buffer* vue, int drapeaux) {
+    ObjetColonnes* o = reinterpret_cast<ObjetColonnes*>(self);
+    if (drapeaux & PyBUF_WRITABLE) {
+        PyErr_SetString(PyExc_BufferError, "colonnes en lecture seule");
+        return -1;
+    }
+    // Les trois lignes sont séparées de capacite() valeurs : contigu seulement si n == capacite
+    const bool contigu = o->colonnes->taille() == o->colonnes->capacite();
+    if (!contigu && (drapeaux & PyBUF_STRIDES) != PyBUF_STRIDES) {
+        PyErr_SetString(PyExc_BufferError, "colonnes non contiguës : pas requis");
+        return -1;
+    }
+    vue->buf = const_cast<double*>(o->colonnes->temps());
+    vue->obj = self;
+    Py_INCREF(self);
+    vue->len = 3 * o->forme[1] * static_cast<Py_ssize_t>(sizeof(double));
+    vue->readonly = 1;
+    vue->itemsize = sizeof(double);
+    vue->format = (drapeaux & PyBUF_FORMAT) ? const_cast<char*>("d") : nullptr;
+    vue->ndim = 2;
+    vue->shape = (drapeaux & PyBUF_ND) == PyBUF_ND ? o->forme : nullptr;
+    vue->strides = (drapeaux & PyBUF_STRIDES) == PyBUF_STRIDES ? o->pas : nullptr;
+    vue->suboffsets = nullptr;
+    vue->internal = nullptr;
+    return 0;
+}
+
+static Py_ssize_t colonnesLongueur(PyObject* self) {
+    return reinterpret_cast<ObjetColonnes*>(self)->forme[1];
+}
+
+static PyBufferProcs colonnesTampon = {colonnesBuffer, nullptr};
+
+static PySequenceMethods colonnesSequence = {colonnesLongueur, nullptr, nullptr, nullptr,
+                                             nullptr, nullptr, nullptr, nullptr,
+                                             nullptr, nullptr};
+
+static PyTypeObject TypeColonnes = {PyVarObject_HEAD_INIT(nullptr, 0) "besim.Colonnes"};
+
+static PyObject* creerColonnes(const std::shared_ptr<const ResultatSimulation>& resultat,
+                               const Colonnes& colonnes) {
+    ObjetColonnes* o = PyObject_New(ObjetColonnes, &TypeColonnes);
+    if (!o) return nullptr;
+    new (&o->resultat) std::shared_ptr<const ResultatSimulation>(resultat);
+    o->colonnes = &colonnes;
+    o->forme[0] = 3;
+    o->forme[1] = static_cast<Py_ssize_t>(colonnes.taille());
+    o->pas[0] = static_cast<Py_ssize_t>(colonnes.capacite() * sizeof(double));
+    o->pas[1] = sizeof(double);
+    return reinterpret_cast<PyObject*>(o);
+}
+
+// --- besim.simuler(**parametres) ---
+
+static bool texteParametre(PyObject* valeur, std::string& texte) {
+    // bool avant int : True/False deviennent "1"/"0" pour lttb
+    PyObject* s = PyBool_Check(valeur) ? PyUnicode_FromString(valeur == Py_True ? "1" : "0")
+                                       : PyObject_Str(valeur);
+    if (!s) return false;
+    const char* c = PyUnicode_AsUTF8(s);
+    if (c) texte = c;
+    Py_DECREF(s);
+    return c != nullptr;
+}
+
+static PyObject* besimSimuler(PyObject*, PyObject* args, PyObject* kwargs) {
+    if (PyTuple_GET_SIZE(args) != 0) {
+        PyErr_SetString(PyExc_TypeError, "simuler() n'accepte que des arguments nommés");
+        return nullptr;
+    }
+    ParametresSimulation p;
+    std::string erreur;
+    bool avecCache = true;
+    if (kwargs) {
+        PyObject *cle, *valeur;
+        Py_ssize_t pos = 0;
+        while (PyDict_Next(kwargs, &pos, &cle, &valeur)) {
+            std::string texte;
+            const char* nom = PyUnicode_AsUTF8(cle);
+            if (!nom) return nullptr;
+            if (std::string(nom) == "cache") {
+                const int vrai = PyObject_IsTrue(valeur);
+                if (vrai < 0) return nullptr;
+                avecCache = vrai != 0;
+                continue;
+            }
+            if (!texteParametre(valeur, texte)) return nullptr;
+            if (!fixerParametre(nom, texte, p, erreur)) {
+                PyErr_SetString(PyExc_ValueError, erreur.c_str());
+                return nullptr;
+            }
+        }
+    }
+
+    // Signal partagé avec le cache ; trace propre à cet appel
+    std::shared_ptr<const ResultatSimulation> resultat;
+    auto propre = std::make_shared<ResultatSimulation>();
+    OrigineResultat origine = OrigineResultat::Calcul;
+    bool ok;
+    Py_BEGIN_ALLOW_THREADS
+    if (avecCache) {
+        ok = simulerEnCache(p, resultat, propre->trace, erreur, &origine);
+    } else {
+        ok = simuler(p, *propre, erreur);
+        resultat = propre;
+    }
+    Py_END_ALLOW_THREADS
+    if (!ok) {
+        PyErr_SetString(PyExc_ValueError, erreur.c_str());
+        return nullptr;
+    }
+
+    PyObject* signal = creerColonnes(resultat, resultat->signal);
+    PyObject* trace = p.trace > 0 ? creerColonnes(propre, propre->trace)
+                                  : (Py_INCREF(Py_None), Py_None);
+    if (!signal || !trace) {
+        Py_XDECREF(signal);
+        Py_XDECREF(trace);
+        return nullptr;
+    }
+    return Py_BuildValue("{s:N,s:N,s:n,s:l,s:l,s:d,s:s}",
+                         "signal", signal,
+                         "trace", trace,
+                         "n", static_cast<Py_ssize_t>(resultat->signal.taille()),
+                         "pas_acceptes", resultat->pasAcceptes,
+                         "pas_rejetes", resultat->pasRejetes,
+                         "duree_ns", resultat->dureeNs,
+                         "cache", nomOrigine(origine));
+}
+
+// --- besim.statistiques_cache() ---
+
+static PyObject* besimStatistiquesCache(PyObject*, PyObject*) {
+    CacheResultats::Statistiques stats = cacheResultats().statistiques();
+    return Py_BuildValue("{s:n,s:n,s:n,s:n}",
+                         "succes_memoire", static_cast<Py_ssize_t>(stats.succesMemoire),
+                         "succes_disque", static_cast<Py_ssize_t>(stats.succesDisque),
+                         "calculs", static_cast<Py_ssize_t>(stats.echecs),
+                         "octets_memoire", static_cast<Py_ssize_t>(stats.octetsMemoire));
+}
+
+static PyMethodDef methodes[] = {
+    {"simuler", reinterpret_cast<PyCFunction>(reinterpret_cast<void (*)(void)>(besimSimuler)),
+     METH_VARARGS | METH_KEYWORDS,
+     "simuler(**parametres) -> dict\n\n"
+     "Clés de be-sim --serveur (circuit, source, A, f, duty, offset, t0, R, R2,\n"
+     "C, L, methode, npas, tmax, rtol, atol, trace, lttb). Le résultat contient\n"
+     "'signal' et 'trace' (colonnes temps, Vin, Vout via le protocole buffer),\n"
+     "'n', 'pas_acceptes', 'pas_rejetes', 'duree_ns' et 'cache' (calcul,\n"
+     "memoire). cache=False : calcul sans passer par le cache."},
+    {"statistiques_cache", besimStatistiquesCache, METH_NOARGS,
+     "statistiques_cache() -> dict : succès mémoire et disque, calculs, octets en mémoire"},
+    {nullptr, nullptr, 0, nullptr}};
+
+static PyModuleDef module = {PyModuleDef_HEAD_INIT, "besim",
+                             "Simulateur de circuits RC/RLC (bibliothèque be-sim)", -1, methodes,
+                             nullptr, nullptr, nullptr, nullptr};
+
+PyMODINIT_FUNC PyInit_besim(void) {
+    TypeColonnes.tp_basicsize = sizeof(ObjetColonnes);
+    TypeColonnes.tp_flags = Py_TPFLAGS_DEFAULT;
+    TypeColonnes.tp_doc = "Colonnes temps, Vin, Vout (protocole buffer, forme (3, n))";
+    TypeColonnes.tp_dealloc = colonnesDetruire;
+    TypeColonnes.tp_as_buffer = &colonnesTampon;
+    TypeColonnes.tp_as_sequence = &colonnesSequence;
+    if (PyType_Ready(&TypeColonnes) < 0) return nullptr;
+
+    PyObject* m = PyModule_Create(&module);
+    if (!m) return nullptr;
+    Py_INCREF(&TypeColonnes);
+    if (PyModule_AddObject(m, "Colonnes", reinterpret_cast<PyObject*>(&TypeColonnes)) < 0) {
+        Py_DECREF(&TypeColonnes);
+        Py_DECREF(m);
+        return nullptr;
+    }
+    return m;
+}
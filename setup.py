@@ -0,0 +1,22 @@
+# Construction du module Python "besim" (python/besim_module.cpp) :
+#   python3 setup.py build_ext --inplace
+from glob import glob
+
+from setuptools import Extension, setup
+
+sources = ["python/besim_module.cpp"] + sorted(glob("src/*.cpp") + glob("src/*/*.cpp"))
+
+setup(
+    name="besim",
+    version="1.0",
+    ext_modules=[
+        Extension(
+            "besim",
+            sources,
+            include_dirs=["include"],
+            extra_compile_args=["-std=c++17", "-O2"],
+            extra_link_args=["-pthread"],
+            language="c++",
+        )
+    ],
+)
@@ -0,0 +1,263 @@
+#include "analyse_ac.hpp"
+#include "besim.hpp"
+#include "emetteur_csv.hpp"
+#include "fabrique.hpp"
+#include "noyaux_ac.hpp"
+#include "pool_taches.hpp"
+#include "sortie_binaire.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+// Fréquences par tâche (multiple de 8, largeur AVX-512) ; en dessous, pas de thread
+static const size_t POINTS_PAR_BLOC = 8192;
+
+FonctionTransfert fonctionTransfert(const Circuit& c, double R2, double polarisation) {
+    FonctionTransfert h;
+    // Entrée B : réponse des dérivées à ve. Circuit linéaire : écart unité
+    // depuis l'état nul (exact, comme Propagateur::construire) ; sinon
+    // différence centrée autour du point de fonctionnement.
+    const double v0 = c.lineaire() ? 0.0 : polarisation;
+    const double dv = c.lineaire() ? 0.5 : 1e-6 * (1.0 + fabs(v0));
+    if (c.order() == 1) {
+        // Point de fonctionnement : vs tel que dvs/dt = 0 sous ve = v0
+        // (Newton ; seul le circuit non linéaire B s'écarte de vs = 0)
+        double vs = 0.0;
+        if (!c.lineaire()) {
+            for (int k = 0; k < 100; ++k) {
+                const double j = c.jacobien1(0.0, vs, v0, R2);
+                if (!(j != 0.0)) break;
+                const double pas = c.deriv1(0.0, vs, v0, R2) / j;
+                vs -= pas;
+                if (fabs(pas) <= 1e-12 * (1.0 + fabs(vs))) break;
+            }
+        }
+        const double a = c.jacobien1(0.0, vs, v0, R2);
+        const double b = (c.deriv1(0.0, vs, v0 + dv, R2) - c.deriv1(0.0, vs, v0 - dv, R2)) / (2.0 * dv);
+        // H = b / (s - a)
+        h.n[0] = b;
+        h.d[0] = -a;
+        h.d[1] = 1.0;
+    } else {
+        double a11, a12, a21, a22, u1, u2, z1, z2;
+        c.jacobien2(0.0, 0.0, 0.0, v0, a11, a12, a21, a22);
+        c.deriv2(0.0, 0.0, 0.0, v0 + dv, u1, u2);
+        c.deriv2(0.0, 0.0, 0.0, v0 - dv, z1, z2);
+        const double b1 = (u1 - z1) / (2.0 * dv), b2 = (u2 - z2) / (2.0 * dv);
+        // H = [1 0] (sI - A)^-1 B : première ligne de l'adjointe sur det(sI - A)
+        h.n[0] = a12 * b2 - a22 * b1;
+        h.n[1] = b1;
+        h.d[0] = a11 * a22 - a12 * a21;
+        h.d[1] = -(a11 + a22);
+        h.d[2] = 1.0;
+    }
+    return h;
+}
+
+// Gain (dB) de H en f, même formule que noyauReponse (noyaux_ac.hpp)
+static double gainDb(const FonctionTransfert& h, double f) {
+    const double w = 2.0 * M_PI * f, w2 = w * w;
+    const double nr = h.n[0] - h.n[2] * w2, ni = h.n[1] * w;
+    const double dr = h.d[0] - h.d[2] * w2, di = h.d[1] * w;
+    return 10.0 * log10((nr * nr + ni * ni) / (dr * dr + di * di));
+}
+
+static JeuInstructions choisirJeu(JeuInstructions demande) {
+    if (demande != JeuInstructions::Auto && jeuDisponible(demande)) return demande;
+    if (jeuDisponible(JeuInstructions::AVX512)) return JeuInstructions::AVX512;
+    if (jeuDisponible(JeuInstructions::AVX2)) return JeuInstructions::AVX2;
+    return JeuInstructions::Scalaire;
+}
+
+bool analyseAC(const FonctionTransfert& h, const OptionsAC& opt, ReponseFrequentielle& r,
+               string& erreur) {
+    const size_t n = opt.points;
+    if (n < 1 || !(opt.fmin > 0.0) || !(opt.fmax >= opt.fmin) || !isfinite(opt.fmax)) {
+        erreur = "balayage invalide (0 < fmin <= fmax, points >= 1)";
+        return false;
+    }
+    r.jeu = choisirJeu(opt.jeu);
+    r.frequence.resize(n);
+    r.gainDb.resize(n);
+    r.phaseDeg.resize(n);
+    // Tableaux de travail complétés au multiple de 8 : le noyau ne traite
+    // que des registres pleins
+    const size_t nVoies = (n + 7) / 8 * 8;
+    vector<double> omega(nVoies), re(nVoies), im(nVoies);
+    const double pasLog = (n > 1) ? log(opt.fmax / opt.fmin) / static_cast<double>(n - 1) : 0.0;
+
+    auto bloc = [&](size_t k0, size_t k1) {
+        for (size_t k = k0; k < k1; ++k) {
+            double f = (k == n - 1) ? opt.fmax : opt.fmin * exp(static_cast<double>(min(k, n - 1)) * pasLog);
+            if (k < n) r.frequence[k] = f;
+            omega[k] = 2.0 * M_PI * f;
+        }
+        switch (r.jeu) {
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+            case JeuInstructions::AVX512:
+                reponseLotAvx512(h.n, h.d, omega.data() + k0, k1 - k0, re.data() + k0, im.data() + k0);
+                break;
+            case JeuInstructions::AVX2:
+                reponseLotAvx2(h.n, h.d, omega.data() + k0, k1 - k0, re.data() + k0, im.data() + k0);
+                break;
+#endif
+            default:
+                reponseLotScalaire(h.n, h.d, omega.data() + k0, k1 - k0, re.data() + k0, im.data() + k0);
+                break;
+        }
+        for (size_t k = k0; k < min(k1, n); ++k) {
+            r.gainDb[k] = 10.0 * log10(re[k] * re[k] + im[k] * im[k]);
+            r.phaseDeg[k] = atan2(im[k], re[k]) * (180.0 / M_PI);
+        }
+    };
+
+    if (nVoies <= POINTS_PAR_BLOC) {
+        bloc(0, nVoies);
+    } else {
+        PoolTaches pool(opt.threads);
+        for (size_t k0 = 0; k0 < nVoies; k0 += POINTS_PAR_BLOC) {
+            const size_t k1 = min(nVoies, k0 + POINTS_PAR_BLOC);
+            pool.soumettre([&bloc, k0, k1] { bloc(k0, k1); });
+        }
+        pool.attendre();
+    }
+
+    // Phase déroulée : pas de saut de 360° entre deux fréquences voisines
+    double decalage = 0.0;
+    for (size_t k = 1; k < n; ++k) {
+        double p = r.phaseDeg[k] + decalage;
+        while (p - r.phaseDeg[k - 1] > 180.0) { p -= 360.0; decalage -= 360.0; }
+        while (p - r.phaseDeg[k - 1] < -180.0) { p += 360.0; decalage += 360.0; }
+        r.phaseDeg[k] = p;
+    }
+    return true;
+}
+
+// --- Mode AC ---
+
+int lancerAC(int argc, char** argv) {
+    ParametresSimulation p;
+    OptionsAC opt;
+    string sortie;
+    bool binaire = false;
+    string erreur;
+    for (int i = 0; i < argc; ++i) {
+        string arg = argv[i];
+        size_t eg = arg.find('=');
+        if (eg == string::npos) {
+            cerr << "AC : argument sans '=' : " << arg << endl;
+            return 1;
+        }
+        string cle = arg.substr(0, eg), valeur = arg.substr(eg + 1);
+        if (cle == "sortie") sortie = valeur;
+        else if (cle == "fmin") opt.fmin = atof(valeur.c_str());
+        else if (cle == "fmax") opt.fmax = atof(valeur.c_str());
+        else if (cle == "points") opt.points = strtoull(valeur.c_str(), nullptr, 10);
+        else if (cle == "threads") opt.threads = static_cast<unsigned>(atoi(valeur.c_str()));
+        else if (cle == "format" && (valeur == "csv" || valeur == "binaire")) binaire = valeur == "binaire";
+        else if (cle == "jeu" && valeur == "auto") opt.jeu = JeuInstructions::Auto;
+        else if (cle == "jeu" && valeur == "scalaire") opt.jeu = JeuInstructions::Scalaire;
+        else if (cle == "jeu" && valeur == "avx2") opt.jeu = JeuInstructions::AVX2;
+        else if (cle == "jeu" && valeur == "avx512") opt.jeu = JeuInstructions::AVX512;
+        else if (cle == "format" || cle == "jeu") {
+            cerr << "AC : valeur invalide pour " << cle << " : " << valeur << endl;
+            return 1;
+        } else if (!fixerParametre(cle, valeur, p, erreur)) {
+            cerr << "AC : " << erreur << endl;
+            return 1;
+        }
+    }
+    if (!verifierParametres(p, erreur)) {
+        cerr << "AC : " << erreur << endl;
+        return 1;
+    }
+    if (sortie.empty()) sortie = binaire ? "resultats/ac/bode.bin" : "resultats/ac/bode.csv";
+
+    unique_ptr<Circuit> circuit = creerCircuit(p.circuit, p.R, p.R2, p.C, p.L, p.f, false, p.diode);
+    const FonctionTransfert h = fonctionTransfert(*circuit, p.R2, p.offset);
+
+    ReponseFrequentielle r;
+    auto debut = chrono::steady_clock::now();
+    if (!analyseAC(h, opt, r, erreur)) {
+        cerr << "AC : " << erreur << endl;
+        return 1;
+    }
+    const double duree = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+
+    filesystem::path parent = filesystem::path(sortie).parent_path();
+    if (!parent.empty()) filesystem::create_directories(parent);
+    if (binaire) {
+        auto texte = [](double v) {
+            ostringstream os;
+            os.precision(17);
+            os << v;
+            return os.str();
+        };
+        SortieBinaire fichier;
+        fichier.nommerColonnes("frequence", "gain_db", "phase_deg");
+        if (!fichier.ouvrir(sortie, r.frequence.size(),
+                            {{"analyse", "ac"},
+                             {"circuit", string(1, p.circuit)},
+                             {"R", texte(p.R)}, {"R2", texte(p.R2)},
+                             {"C", texte(p.C)}, {"L", texte(p.L)},
+                             {"polarisation", texte(p.offset)}})) {
+            return 1;
+        }
+        for (size_t k = 0; k < r.frequence.size(); ++k) {
+            fichier.ajouter(r.frequence[k], r.gainDb[k], r.phaseDeg[k]);
+        }
+        fichier.fermer();
+    } else {
+        ofstream fichier(sortie);
+        if (!fichier) {
+            cerr << "AC : impossible d'écrire " << sortie << endl;
+            return 1;
+        }
+        fichier << "frequence,gain_db,phase_deg\n";
+        EmetteurCsv format;
+        for (size_t k = 0; k < r.frequence.size(); ++k) {
+            format.ligne(r.frequence[k], r.gainDb[k], r.phaseDeg[k]);
+            if (format.taille() >= (1u << 16)) {
+                fichier.write(format.donnees(), static_cast<streamsize>(format.taille()));
+                format.vider();
+            }
+        }
+        fichier.write(format.donnees(), static_cast<streamsize>(format.taille()));
+    }
+
+    size_t kMax = 0;
+    for (size_t k = 1; k < r.frequence.size(); ++k) {
+        if (r.gainDb[k] > r.gainDb[kMax]) kMax = k;
+    }
+    cout << "=== Analyse AC ===" << endl;
+    cout << "  Circuit " << p.circuit << " : H(s) = (" << h.n[0] << " + " << h.n[1] << " s + " << h.n[2]
+         << " s²) / (" << h.d[0] << " + " << h.d[1] << " s + " << h.d[2] << " s²)" << endl;
+    cout << "  " << r.frequence.size() << " fréquences de " << opt.fmin << " à " << opt.fmax
+         << " Hz, noyau " << LotCircuits::nomJeuInstructions(r.jeu) << ", calcul en " << duree * 1e3
+         << " ms" << endl;
+    cout << "  Gain max " << r.gainDb[kMax] << " dB à " << r.frequence[kMax] << " Hz" << endl;
+    // Premier passage sous -3 dB : encadré par deux fréquences du balayage,
+    // puis localisé en log f sur H elle-même (indépendant du nombre de points)
+    const double seuil = r.gainDb[0] - 3.0;
+    for (size_t k = 1; k < r.frequence.size(); ++k) {
+        if (r.gainDb[k] < seuil && r.gainDb[k - 1] >= seuil) {
+            double a = log(r.frequence[k - 1]), b = log(r.frequence[k]);
+            for (int i = 0; i < 60; ++i) {
+                const double m = 0.5 * (a + b);
+                if (gainDb(h, exp(m)) >= seuil) a = m;
+                else b = m;
+            }
+            const double coupure = exp(0.5 * (a + b));
+            cout << "  Coupure à -3 dB (par rapport à fmin) vers " << coupure << " Hz" << endl;
+            break;
+        }
+    }
+    cout << " Fichier '" << sortie << "' : colonnes frequence, gain_db, phase_deg" << endl;
+    return 0;
+}
@@ -0,0 +1,311 @@
+#include "balayage.hpp"
+#include "fabrique.hpp"
+#include "pool_taches.hpp"
+#include "rk45.hpp"
+#include "simulation.hpp"
+#include "solver_static.hpp"
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace std;
+
+// --- Lecture de la configuration ---
+
+static string nettoyer(const string& s) {
+    size_t a = s.find_first_not_of(" \t\r");
+    size_t b = s.find_last_not_of(" \t\r");
+    return (a == string::npos) ? string() : s.substr(a, b - a + 1);
+}
+
+// "100,220,470" | "100:1000:10" | "1e-9:1e-6:4:log"
+static bool lireValeurs(const string& texte, vector<double>& valeurs) {
+    valeurs.clear();
+    try {
+        if (texte.find(':') != string::npos) {
+            vector<string> champs;
+            stringstream ss(texte);
+            string champ;
+            while (getline(ss, champ, ':')) champs.push_back(nettoyer(champ));
+            if (champs.size() < 3 || champs.size() > 4) return false;
+            double debut = stod(champs[0]), fin = stod(champs[1]);
+            int n = stoi(champs[2]);
+            bool logarithmique = (champs.size() == 4 && champs[3] == "log");
+            if (n < 1 || (logarithmique && (debut <= 0.0 || fin <= 0.0))) return false;
+            for (int k = 0; k < n; ++k) {
+                double u = (n == 1) ? 0.0 : static_cast<double>(k) / (n - 1);
+                valeurs.push_back(logarithmique ? debut * pow(fin / debut, u)
+                                                : debut + (fin - debut) * u);
+            }
+        } else {
+            stringstream ss(texte);
+            string champ;
+            while (getline(ss, champ, ',')) valeurs.push_back(stod(nettoyer(champ)));
+        }
+    } catch (const exception&) {
+        return false;
+    }
+    return !valeurs.empty();
+}
+
+static bool appliquer(const string& cle, const string& valeur, ConfigBalayage& cfg, string& erreur) {
+    vector<double> v;
+    bool ok = true;
+    try {
+        if (cle == "circuit") {
+            ok = valeur.size() == 1;
+            if (ok) cfg.circuit = valeur[0];
+        }
+        else if (cle == "source") cfg.typeSource = stoi(valeur);
+        else if (cle == "A") cfg.amplitude = stod(valeur);
+        else if (cle == "duty") cfg.dutyCycle = stod(valeur);
+        else if (cle == "offset") cfg.offset = stod(valeur);
+        else if (cle == "t0") cfg.startTime = stod(valeur);
+        else if (cle == "diode") {
+            ok = valeur == "shockley" || valeur == "seuil";
+            cfg.diode.shockley = valeur == "shockley";
+        }
+        else if (cle == "Is") cfg.diode.Is = stod(valeur);
+        else if (cle == "n") cfg.diode.n = stod(valeur);
+        else if (cle == "Vt") cfg.diode.Vt = stod(valeur);
+        else if (cle == "npas") cfg.npas = stoi(valeur);
+        else if (cle == "tmax") cfg.tmax = stod(valeur);
+        else if (cle == "rtol") cfg.rtol = stod(valeur);
+        else if (cle == "atol") cfg.atol = stod(valeur);
+        else if (cle == "threads") cfg.threads = static_cast<unsigned>(stoul(valeur));
+        else if (cle == "echelle") cfg.echelle = (valeur == "1" || valeur == "oui" || valeur == "y");
+        else if (cle == "sortie") cfg.sortie = valeur;
+        else if (cle == "R") { ok = lireValeurs(valeur, v); cfg.R = v; }
+        else if (cle == "C") { ok = lireValeurs(valeur, v); cfg.C = v; }
+        else if (cle == "L") { ok = lireValeurs(valeur, v); cfg.L = v; }
+        else if (cle == "R2") { ok = lireValeurs(valeur, v); cfg.R2 = v; }
+        else if (cle == "f") { ok = lireValeurs(valeur, v); cfg.f = v; }
+        else if (cle == "methode") {
+            ok = lireValeurs(valeur, v);
+            cfg.methodes.clear();
+            for (double m : v) {
+                ok = ok && m == floor(m);   // 2.5 n'est pas une méthode
+                cfg.methodes.push_back(static_cast<int>(m));
+            }
+        } else {
+            erreur = "clé inconnue : " + cle;
+            return false;
+        }
+    } catch (const exception&) {
+        ok = false;
+    }
+    if (!ok) erreur = "valeur invalide pour " + cle + " : " + valeur;
+    return ok;
+}
+
+static bool lireLigne(const string& ligne, ConfigBalayage& cfg, string& erreur) {
+    string l = nettoyer(ligne.substr(0, ligne.find('#')));
+    if (l.empty()) return true;
+    size_t eg = l.find('=');
+    if (eg == string::npos) {
+        erreur = "ligne sans '=' : " + l;
+        return false;
+    }
+    return appliquer(nettoyer(l.substr(0, eg)), nettoyer(l.substr(eg + 1)), cfg, erreur);
+}
+
+bool lireConfigBalayage(int argc, char** argv, ConfigBalayage& cfg, string& erreur) {
+    for (int i = 0; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.find('=') != string::npos) {
+            if (!lireLigne(arg, cfg, erreur)) return false;
+            continue;
+        }
+        ifstream fichier(arg);
+        if (!fichier) {
+            erreur = "fichier de balayage introuvable : " + arg;
+            return false;
+        }
+        string ligne;
+        while (getline(fichier, ligne)) {
+            if (!lireLigne(ligne, cfg, erreur)) return false;
+        }
+    }
+    // Chaque point doit désigner exactement ce qui sera simulé (pas de
+    // circuit, source ou méthode inconnus ramenés au défaut)
+    const vector<PointBalayage> points = pointsBalayage(cfg);
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (!verifierParametres(parametresPoint(cfg, points[i]), erreur)) {
+            erreur = "point " + to_string(i) + " : " + erreur;
+            return false;
+        }
+    }
+    return true;
+}
+
+vector<PointBalayage> pointsBalayage(const ConfigBalayage& cfg) {
+    vector<PointBalayage> points;
+    points.reserve(cfg.R.size() * cfg.C.size() * cfg.L.size() * cfg.R2.size()
+                   * cfg.f.size() * cfg.methodes.size());
+    for (double R : cfg.R)
+        for (double C : cfg.C)
+            for (double L : cfg.L)
+                for (double R2 : cfg.R2)
+                    for (double f : cfg.f)
+                        for (int m : cfg.methodes)
+                            points.push_back({R, C, L, R2, f, m});
+    return points;
+}
+
+ParametresSimulation parametresPoint(const ConfigBalayage& cfg, const PointBalayage& p) {
+    ParametresSimulation s;
+    s.circuit = cfg.circuit;
+    s.typeSource = cfg.typeSource;
+    s.amplitude = cfg.amplitude;
+    s.f = p.f;
+    s.dutyCycle = cfg.dutyCycle;
+    s.offset = cfg.offset;
+    s.startTime = cfg.startTime;
+    s.R = p.R;
+    s.R2 = p.R2;
+    s.C = p.C;
+    s.L = p.L;
+    s.diode = cfg.diode;
+    s.methode = p.methode;
+    s.npas = cfg.npas;
+    s.tmax = cfg.tmax;
+    s.rtol = cfg.rtol;
+    s.atol = cfg.atol;
+    return s;
+}
+
+// --- Simulation d'un point ---
+
+static void simulerPoint(const ConfigBalayage& cfg, const PointBalayage& p, ResultatBalayage& r) {
+    auto debut = chrono::steady_clock::now();
+
+    unique_ptr<Circuit> circuit = creerCircuit(cfg.circuit, p.R, p.R2, p.C, p.L, p.f, false, cfg.diode);
+    unique_ptr<Source> source = creerSource(cfg.typeSource, cfg.amplitude, p.f,
+                                            cfg.dutyCycle, cfg.offset, cfg.startTime);
+    Simulation sim(cfg.npas, cfg.tmax);
+
+    double x1 = 0.0, x2 = 0.0;
+    double somme2 = 0.0;
+    long echantillons = 0;
+    auto statistiques = [&](double, double, double v) {
+        if (echantillons++ == 0) r.vMin = r.vMax = v;
+        if (v < r.vMin) r.vMin = v;
+        if (v > r.vMax) r.vMax = v;
+        somme2 += v * v;
+        r.vFinal = v;
+    };
+    if (p.methode == 5) {
+        // Pas adaptatif, échantillonné sur la même grille uniforme
+        OptionsRK45 opt;
+        opt.rtol = cfg.rtol;
+        opt.atol = cfg.atol;
+        simulerRK45(*circuit, *source, p.R2, sim.getNpas(), sim.getTmax(), opt, x1, x2,
+                    statistiques);
+    } else {
+        statique::aiguiller(*circuit, *source, p.methode,
+            [&](const auto& c, const auto& s, auto meth) {
+                statique::boucle<decltype(meth)::value>(c, s, p.R2, sim.getNpas(), sim.getDt(),
+                                                        x1, x2, statistiques);
+            });
+    }
+    r.vEff = echantillons > 0 ? sqrt(somme2 / echantillons) : 0.0;
+
+    r.dureeNs = chrono::duration<double, nano>(chrono::steady_clock::now() - debut).count();
+}
+
+double executerBalayage(const ConfigBalayage& cfg, const vector<PointBalayage>& points,
+                        unsigned nThreads, vector<ResultatBalayage>& resultats, size_t* vols) {
+    // Une case par point, écrite par un seul thread : pas de verrou de collecte
+    resultats.assign(points.size(), ResultatBalayage());
+
+    auto debut = chrono::steady_clock::now();
+    PoolTaches pool(nThreads);
+    for (size_t i = 0; i < points.size(); ++i) {
+        pool.soumettre([&cfg, &points, &resultats, i] {
+            simulerPoint(cfg, points[i], resultats[i]);
+        });
+    }
+    pool.attendre();
+    double duree = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+
+    if (vols) *vols = pool.nombreVols();
+    return duree;
+}
+
+// --- Mode balayage (ligne de commande) ---
+
+static bool ecrireResultats(const ConfigBalayage& cfg, const vector<PointBalayage>& points,
+                            const vector<ResultatBalayage>& resultats) {
+    filesystem::path chemin(cfg.sortie);
+    if (chemin.has_parent_path()) filesystem::create_directories(chemin.parent_path());
+    ofstream fichier(chemin);
+    if (!fichier) return false;
+
+    fichier << setprecision(10);
+    fichier << "indice,circuit,R,C,L,R2,f,methode,Vout_final,Vout_min,Vout_max,Vout_eff,duree_ns\n";
+    for (size_t i = 0; i < points.size(); ++i) {
+        const PointBalayage& p = points[i];
+        const ResultatBalayage& r = resultats[i];
+        fichier << i << "," << cfg.circuit << "," << p.R << "," << p.C << "," << p.L << ","
+                << p.R2 << "," << p.f << "," << p.methode << "," << r.vFinal << ","
+                << r.vMin << "," << r.vMax << "," << r.vEff << "," << r.dureeNs << "\n";
+    }
+    return true;
+}
+
+int lancerBalayage(int argc, char** argv) {
+    ConfigBalayage cfg;
+    string erreur;
+    if (!lireConfigBalayage(argc, argv, cfg, erreur)) {
+        cerr << "Balayage : " << erreur << endl;
+        return 1;
+    }
+
+    vector<PointBalayage> points = pointsBalayage(cfg);
+    unsigned nMax = cfg.threads ? cfg.threads : max(1u, thread::hardware_concurrency());
+    double pasParPoint = static_cast<double>(cfg.npas) + 1.0;
+
+    cout << "=== Balayage de paramètres ===" << endl;
+    cout << "  Circuit " << cfg.circuit << ", " << points.size() << " points, npas="
+         << cfg.npas << ", tmax=" << cfg.tmax << " s, " << nMax << " threads" << endl;
+
+    vector<ResultatBalayage> resultats;
+
+    if (cfg.echelle) {
+        // Même balayage avec 1, 2, 4, ... N threads ; efficacité = T1 / (p * Tp)
+        vector<unsigned> nombres;
+        for (unsigned p = 1; p < nMax; p *= 2) nombres.push_back(p);
+        nombres.push_back(nMax);
+
+        double t1 = 0.0;
+        cout << "  threads   durée (s)   points/s    Mpas/s   efficacité   vols" << endl;
+        for (unsigned p : nombres) {
+            size_t vols = 0;
+            double duree = executerBalayage(cfg, points, p, resultats, &vols);
+            if (p == 1) t1 = duree;
+            cout << "  " << setw(7) << p << "  " << setw(10) << fixed << setprecision(4) << duree
+                 << "  " << setw(9) << setprecision(1) << points.size() / duree
+                 << "  " << setw(8) << setprecision(2) << points.size() * pasParPoint / duree / 1e6
+                 << "  " << setw(10) << setprecision(1) << 100.0 * t1 / (p * duree) << " %"
+                 << "  " << setw(5) << vols << endl;
+            cout.unsetf(ios::floatfield);
+        }
+    } else {
+        size_t vols = 0;
+        double duree = executerBalayage(cfg, points, nMax, resultats, &vols);
+        cout << "  Durée : " << duree << " s, " << points.size() / duree << " points/s, "
+             << points.size() * pasParPoint / duree / 1e6 << " Mpas/s (" << vols << " vols)" << endl;
+    }
+
+    if (!ecrireResultats(cfg, points, resultats)) {
+        cerr << "Balayage : impossible d'écrire " << cfg.sortie << endl;
+        return 1;
+    }
+    cout << " Fichier '" << cfg.sortie << "' généré avec succès !" << endl;
+    return 0;
+}
@@ -0,0 +1,437 @@
+#include "banc.hpp"
+#include "besim.hpp"
+#include "ecrivain.hpp"
+#include "emetteur_csv.hpp"
+#include "fabrique.hpp"
+#include "lot_circuits.hpp"
+#include "solver_static.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <type_traits>
+
+using namespace std;
+
+// Résultat de chaque boucle mesurée, pour qu'elle ne soit pas éliminée
+static volatile double puits;
+
+// Noms des sources, même numérotation que creerSource()
+static const char* const NOMS_SOURCES[] = {"sinus", "echelon", "triangulaire", "creneau",
+                                           "rectangulaire"};
+
+// Noyaux de solver_static.hpp, dans l'ordre de boucleNoyau<K>
+struct Noyau {
+    const char* nom;
+    int ordre;
+};
+static const Noyau NOYAUX[] = {
+    {"euler1", 1}, {"rk4_order1", 1}, {"heun_order1", 1},
+    {"euler2", 2}, {"rk4", 2},        {"heun", 2},
+};
+
+// Circuit qui compte ses évaluations de dérivées : même interface que les
+// circuits concrets pour les noyaux et statique::boucle (méthodes 1 à 4)
+template <class Circ>
+struct Compteur {
+    const Circ& c;
+    mutable long evaluations = 0;
+
+    int order() const { return c.order(); }
+    double deriv1(double t, double x1, double ve, double extra) const {
+        ++evaluations;
+        return c.deriv1(t, x1, ve, extra);
+    }
+    void deriv2(double t, double x1, double x2, double ve, double& dx1, double& dx2) const {
+        ++evaluations;
+        c.deriv2(t, x1, x2, ve, dx1, dx2);
+    }
+};
+
+// npas pas du noyau K depuis l'état nul, sans sortie
+template <int K, class Circ, class Src>
+static double boucleNoyau(const Circ& c, const Src& s, double extra, int npas, double dt) {
+    double x1 = 0.0, x2 = 0.0;
+    for (int i = 0; i < npas; ++i) {
+        const double t = i * dt;
+        if constexpr (K == 0) statique::euler1(x1, dt, t, c, s, extra);
+        else if constexpr (K == 1) statique::rk4_order1(x1, dt, t, c, s, extra);
+        else if constexpr (K == 2) statique::heun_order1(x1, dt, t, c, s, extra);
+        else if constexpr (K == 3) statique::euler2(x1, x2, dt, t, c, s);
+        else if constexpr (K == 4) statique::rk4(x1, x2, dt, t, c, s);
+        else statique::heun(x1, x2, dt, t, c, s);
+    }
+    return x1 + x2;
+}
+
+template <class Circ, class Src>
+static double executerNoyau(int k, const Circ& c, const Src& s, double extra, int npas, double dt) {
+    switch (k) {
+        case 0: return boucleNoyau<0>(c, s, extra, npas, dt);
+        case 1: return boucleNoyau<1>(c, s, extra, npas, dt);
+        case 2: return boucleNoyau<2>(c, s, extra, npas, dt);
+        case 3: return boucleNoyau<3>(c, s, extra, npas, dt);
+        case 4: return boucleNoyau<4>(c, s, extra, npas, dt);
+        default: return boucleNoyau<5>(c, s, extra, npas, dt);
+    }
+}
+
+// Méthodes du moteur lot : nom et numéro (menu de main.cpp) selon l'ordre
+struct MethodeLot {
+    const char* nom;
+    int ordre1, ordre2;
+    int etages;         // évaluations des dérivées par pas
+};
+static const MethodeLot METHODES_LOT[] = {{"euler", 1, 2, 1}, {"heun", 4, 4, 2}, {"rk4", 3, 3, 4}};
+
+// Jeux d'instructions du moteur lot, mesurés s'ils sont disponibles
+struct JeuLot {
+    const char* nom;
+    JeuInstructions jeu;
+};
+static const JeuLot JEUX_LOT[] = {{"scalaire", JeuInstructions::Scalaire},
+                                  {"avx2", JeuInstructions::AVX2},
+                                  {"avx512", JeuInstructions::AVX512}};
+
+// Valeurs de l'instance i d'un lot : R réparti de R/2 à 3R/2
+static double resistanceInstance(double R, size_t i, size_t n) {
+    return R * (0.5 + static_cast<double>(i) / n);
+}
+
+// Compare l'état final du lot à celui de chaque instance intégrée seule
+// (avancerStatique, mêmes npas pas) ; écart maximal relatif à la plus grande
+// valeur de chaque composante
+static double ecartLot(const LotCircuits& lot, const vector<double>& x1, const vector<double>& x2) {
+    double echelle1 = 0.0, echelle2 = 0.0, ecart1 = 0.0, ecart2 = 0.0;
+    for (size_t i = 0; i < lot.taille(); ++i) {
+        echelle1 = max(echelle1, fabs(x1[i]));
+        echelle2 = max(echelle2, fabs(x2[i]));
+        ecart1 = max(ecart1, fabs(lot.x1(i) - x1[i]));
+        ecart2 = max(ecart2, fabs(lot.x2(i) - x2[i]));
+    }
+    return max(echelle1 > 0.0 ? ecart1 / echelle1 : ecart1, echelle2 > 0.0 ? ecart2 / echelle2 : ecart2);
+}
+
+// Boucle de statique::boucle sans sortie, méthode 1 à 4 ; sert à compter les
+// évaluations du chemin CSV (sous-pas des fronts compris)
+template <class Circ, class Src>
+static double executerBoucle(int methode, const Circ& c, const Src& s, double extra, int npas,
+                             double dt) {
+    double x1 = 0.0, x2 = 0.0;
+    auto ignorer = [](double, double, double) {};
+    switch (methode) {
+        case 2: statique::boucle<2>(c, s, extra, npas, dt, x1, x2, ignorer); break;
+        case 3: statique::boucle<3>(c, s, extra, npas, dt, x1, x2, ignorer); break;
+        case 4: statique::boucle<4>(c, s, extra, npas, dt, x1, x2, ignorer); break;
+        default: statique::boucle<1>(c, s, extra, npas, dt, x1, x2, ignorer); break;
+    }
+    return x1 + x2;
+}
+
+// Médiane, minimum et dispersion des durées (s) ramenées au pas (ns)
+static void statistiques(vector<double> durees, long pas, ResultatBanc& r) {
+    for (double& d : durees) d *= 1e9 / pas;
+    sort(durees.begin(), durees.end());
+    auto mediane = [](const vector<double>& v) {
+        const size_t n = v.size();
+        return n % 2 ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+    };
+    r.nsMedian = mediane(durees);
+    r.nsMin = durees.front();
+    vector<double> ecarts;
+    for (double d : durees) ecarts.push_back(fabs(d - r.nsMedian));
+    sort(ecarts.begin(), ecarts.end());
+    r.dispersion = r.nsMedian > 0.0 ? mediane(ecarts) / r.nsMedian : 0.0;
+}
+
+template <class F>
+static vector<double> chronometrer(int repetitions, F&& f) {
+    vector<double> durees;
+    for (int k = 0; k < repetitions; ++k) {
+        auto debut = chrono::steady_clock::now();
+        f();
+        durees.push_back(chrono::duration<double>(chrono::steady_clock::now() - debut).count());
+    }
+    return durees;
+}
+
+static string echapper(const string& s) {
+    string r;
+    for (char ch : s) {
+        if (ch == '"' || ch == '\\') r += '\\';
+        r += ch;
+    }
+    return r;
+}
+
+bool ecrireJsonBanc(const string& chemin, const vector<ResultatBanc>& resultats, int npas,
+                    int repetitions, double dt) {
+    filesystem::path parent = filesystem::path(chemin).parent_path();
+    if (!parent.empty()) filesystem::create_directories(parent);
+    ofstream f(chemin);
+    if (!f) return false;
+    f.precision(17);
+    f << "{\n  \"banc\": \"be-sim\",\n  \"version\": 1,\n";
+#ifdef __VERSION__
+    f << "  \"compilateur\": \"" << echapper(__VERSION__) << "\",\n";
+#endif
+    f << "  \"npas\": " << npas << ",\n  \"repetitions\": " << repetitions << ",\n  \"dt\": " << dt
+      << ",\n  \"cas\": [";
+    for (size_t i = 0; i < resultats.size(); ++i) {
+        const ResultatBanc& r = resultats[i];
+        f << (i ? ",\n" : "\n") << "    {\"cas\": \"" << echapper(r.cas) << "\", \"famille\": \""
+          << r.famille << "\", \"methode\": \"" << r.methode << "\", \"circuit\": \"" << r.circuit
+          << "\", \"source\": \"" << r.source << "\", \"pas\": " << r.pas
+          << ", \"ns_par_pas\": " << r.nsMedian << ", \"ns_par_pas_min\": " << r.nsMin
+          << ", \"dispersion\": " << r.dispersion
+          << ", \"evaluations_par_pas\": " << r.evaluationsParPas
+          << ", \"evaluations_par_s\": " << r.evaluationsParSeconde() << ", \"lignes_par_s\": ";
+        if (r.lignes > 0) f << r.lignesParSeconde();
+        else f << "null";
+        f << "}";
+    }
+    f << "\n  ]\n}\n";
+    return static_cast<bool>(f);
+}
+
+static void afficher(const ResultatBanc& r) {
+    char ligne[200];
+    if (r.lignes > 0) {
+        snprintf(ligne, sizeof ligne, "  %-34s %9.2f %9.2f %6.1f %8.2f %10.1f %10.2f",
+                 r.cas.c_str(), r.nsMedian, r.nsMin, 100.0 * r.dispersion, r.evaluationsParPas,
+                 r.evaluationsParSeconde() * 1e-6, r.lignesParSeconde() * 1e-6);
+    } else {
+        snprintf(ligne, sizeof ligne, "  %-34s %9.2f %9.2f %6.1f %8.2f %10.1f %10s",
+                 r.cas.c_str(), r.nsMedian, r.nsMin, 100.0 * r.dispersion, r.evaluationsParPas,
+                 r.evaluationsParSeconde() * 1e-6, "-");
+    }
+    cout << ligne << endl;
+}
+
+int lancerBanc(int argc, char** argv) {
+    ParametresSimulation p;
+    p.tmax = 2e-2;
+    p.npas = 200000;
+    p.methode = 3;
+    int repetitions = 7;
+    int instances = 64;
+    bool csv = true;
+    string fichier = "resultats/banc/sortie.csv", filtre, json;
+    string erreur;
+    for (int i = 0; i < argc; ++i) {
+        string arg = argv[i];
+        size_t eg = arg.find('=');
+        if (eg == string::npos) {
+            cerr << "Banc : argument sans '=' : " << arg << endl;
+            return 1;
+        }
+        string cle = arg.substr(0, eg), valeur = arg.substr(eg + 1);
+        if (cle == "repetitions") repetitions = atoi(valeur.c_str());
+        else if (cle == "lot") instances = atoi(valeur.c_str());
+        else if (cle == "csv" && (valeur == "oui" || valeur == "non")) csv = valeur == "oui";
+        else if (cle == "csv") {
+            cerr << "Banc : csv=oui ou csv=non" << endl;
+            return 1;
+        } else if (cle == "fichier") fichier = valeur;
+        else if (cle == "filtre") filtre = valeur;
+        else if (cle == "json") json = valeur;
+        else if (cle == "circuit" || cle == "source") {
+            cerr << "Banc : tous les circuits et sources sont mesurés (filtre=texte pour en "
+                    "retenir)" << endl;
+            return 1;
+        } else if (!fixerParametre(cle, valeur, p, erreur)) {
+            cerr << "Banc : " << erreur << endl;
+            return 1;
+        }
+    }
+    if (!verifierParametres(p, erreur)) {
+        cerr << "Banc : " << erreur << endl;
+        return 1;
+    }
+    if (repetitions < 1 || instances < 0 || p.methode < 1 || p.methode > 4) {
+        cerr << "Banc : repetitions >= 1, lot >= 0, methode du chemin CSV de 1 à 4" << endl;
+        return 1;
+    }
+    const int npas = p.npas;
+    const double dt = p.tmax / npas;
+    auto retenu = [&](const string& cas) { return filtre.empty() || cas.find(filtre) != string::npos; };
+
+    cout << "=== Banc d'essai ===" << endl;
+    cout << "  " << npas << " pas de " << dt << " s, " << repetitions
+         << " répétitions par cas (médiane)" << endl;
+    char entete[200];
+    snprintf(entete, sizeof entete, "  %-34s %9s %9s %6s %8s %10s %10s", "cas", "ns/pas", "min",
+             "disp%", "eval/pas", "Meval/s", "Mlignes/s");
+    cout << entete << endl;
+
+    vector<ResultatBanc> resultats;
+    for (char type : {'A', 'B', 'C', 'D'}) {
+        unique_ptr<Circuit> circuit = creerCircuit(type, p.R, p.R2, p.C, p.L, p.f, false, p.diode);
+        for (int typeSource = 1; typeSource <= 5; ++typeSource) {
+            unique_ptr<Source> source = creerSource(typeSource, p.amplitude, p.f, p.dutyCycle,
+                                                    p.offset, p.startTime);
+            const string nomSource = NOMS_SOURCES[typeSource - 1];
+            statique::aiguillerTypes(*circuit, *source, [&](const auto& c, const auto& s) {
+                for (int k = 0; k < 6; ++k) {
+                    if (NOYAUX[k].ordre != c.order()) continue;
+                    ResultatBanc r;
+                    r.famille = "noyau";
+                    r.methode = NOYAUX[k].nom;
+                    r.circuit = type;
+                    r.source = nomSource;
+                    r.cas = "noyau/" + r.methode + "/" + string(1, type) + "/" + nomSource;
+                    if (!retenu(r.cas)) continue;
+                    r.pas = npas;
+                    // Passe de calibration (et de chauffe) : évaluations comptées
+                    using Circ = remove_cv_t<remove_reference_t<decltype(c)>>;
+                    Compteur<Circ> compteur{c};
+                    puits = executerNoyau(k, compteur, s, p.R2, npas, dt);
+                    r.evaluationsParPas = static_cast<double>(compteur.evaluations) / npas;
+                    statistiques(chronometrer(repetitions, [&] {
+                        puits = executerNoyau(k, c, s, p.R2, npas, dt);
+                    }), r.pas, r);
+                    afficher(r);
+                    resultats.push_back(r);
+                }
+            });
+        }
+
+        // Chemin CSV du mode interactif, source sinus
+        unique_ptr<Source> sinus = creerSource(1, p.amplitude, p.f, p.dutyCycle, p.offset,
+                                               p.startTime);
+        const int typesVerifies[2] = {1, 4};        // sinus, créneau
+        unique_ptr<Source> verifiees[2];
+        for (int k = 0; k < 2; ++k)
+            verifiees[k] = creerSource(typesVerifies[k], p.amplitude, p.f, p.dutyCycle, p.offset,
+                                       p.startTime);
+        ResultatBanc r;
+        r.famille = "csv";
+        r.methode = to_string(p.methode);
+        r.circuit = type;
+        r.source = NOMS_SOURCES[0];
+        r.cas = "csv/" + r.methode + "/" + string(1, type) + "/" + r.source;
+        if (!csv || !retenu(r.cas)) continue;
+        r.pas = npas + 1;       // échantillons 0..npas, un pas chacun
+        r.lignes = npas + 1;
+        statique::aiguillerTypes(*circuit, *sinus, [&](const auto& c, const auto& s) {
+            using Circ = remove_cv_t<remove_reference_t<decltype(c)>>;
+            Compteur<Circ> compteur{c};
+            puits = executerBoucle(p.methode, compteur, s, p.R2, npas, dt);
+            r.evaluationsParPas = static_cast<double>(compteur.evaluations) / r.pas;
+        });
+        filesystem::path parent = filesystem::path(fichier).parent_path();
+        if (!parent.empty()) filesystem::create_directories(parent);
+        bool ecrit = true;
+        auto ecrire = [&] {
+            ofstream sortie(fichier);
+            sortie << "temps,Vin,Vout\n";
+            EmetteurCsv format;
+            format.fixerPas(dt);
+            EcrivainAsynchrone ecrivain(sortie, format);
+            double x1 = 0.0, x2 = 0.0;
+            simulerStatique(*circuit, *sinus, p.R2, p.methode, npas, dt, x1, x2, ecrivain);
+            ecrivain.terminer();
+            ecrit = ecrit && static_cast<bool>(sortie);
+        };
+        ecrire();       // chauffe (cache disque, allocation des paquets)
+        if (!ecrit) {
+            cerr << "Banc : impossible d'écrire " << fichier << endl;
+            return 1;
+        }
+        statistiques(chronometrer(repetitions, ecrire), r.pas, r);
+        afficher(r);
+        resultats.push_back(r);
+    }
+
+    // Moteur lot : instances pas après pas sur tout l'horizon, source sinus ;
+    // chaque cas est d'abord comparé à l'intégration de chaque instance seule,
+    // sur la sinusoïde et sur un créneau (pas coupés sur les fronts)
+    for (char type : {'A', 'B', 'C', 'D'}) {
+        if (instances == 0) break;
+        if (!LotCircuits::accepte(type, p.diode, erreur)) {
+            bool demande = false;
+            for (const MethodeLot& m : METHODES_LOT)
+                for (const JeuLot& j : JEUX_LOT)
+                    demande = demande || retenu(string("lot/") + j.nom + "/" + m.nom + "/" + type);
+            if (demande) cout << "  lot/*/" << type << " non mesuré : " << erreur << endl;
+            continue;
+        }
+        unique_ptr<Source> sinus = creerSource(1, p.amplitude, p.f, p.dutyCycle, p.offset,
+                                               p.startTime);
+        const int typesVerifies[2] = {1, 4};        // sinus, créneau
+        unique_ptr<Source> verifiees[2];
+        for (int k = 0; k < 2; ++k)
+            verifiees[k] = creerSource(typesVerifies[k], p.amplitude, p.f, p.dutyCycle, p.offset,
+                                       p.startTime);
+        LotCircuits lot(type, static_cast<size_t>(instances));
+        for (size_t i = 0; i < lot.taille(); ++i) {
+            lot.definirInstance(i, resistanceInstance(p.R, i, lot.taille()), p.C, p.L, p.R2);
+        }
+        for (const MethodeLot& m : METHODES_LOT) {
+            const int methode = lot.order() == 1 ? m.ordre1 : m.ordre2;
+            vector<double> x1[2], x2[2];
+            bool referenceFaite = false;
+            for (const JeuLot& j : JEUX_LOT) {
+                ResultatBanc r;
+                r.famille = "lot";
+                r.methode = m.nom;
+                r.circuit = type;
+                r.source = NOMS_SOURCES[0];
+                r.cas = string("lot/") + j.nom + "/" + r.methode + "/" + string(1, type);
+                if (!retenu(r.cas) || !jeuDisponible(j.jeu)) continue;
+                if (!referenceFaite) {
+                    for (int k = 0; k < 2; ++k) {
+                        x1[k].assign(lot.taille(), 0.0);
+                        x2[k].assign(lot.taille(), 0.0);
+                        for (size_t i = 0; i < lot.taille(); ++i) {
+                            unique_ptr<Circuit> seul = creerCircuit(type, resistanceInstance(p.R, i, lot.taille()),
+                                                                    p.R2, p.C, p.L, p.f, false, p.diode);
+                            EtatBoucle e;
+                            avancerStatique(*seul, *verifiees[k], p.R2, methode, npas - 1, dt,
+                                            x1[k][i], x2[k][i], e);
+                        }
+                    }
+                    referenceFaite = true;
+                }
+                lot.choisirJeuInstructions(j.jeu);
+                for (int k = 0; k < 2; ++k) {
+                    lot.reinitialiser();
+                    lot.avancer(*verifiees[k], methode, dt, npas);
+                    const double ecart = ecartLot(lot, x1[k], x2[k]);
+                    if (!(ecart <= 1e-9)) {
+                        cerr << "Banc : " << r.cas << " diffère de l'intégration instance par instance"
+                             << " (source " << NOMS_SOURCES[typesVerifies[k] - 1] << ", écart relatif " << ecart << ")"
+                             << endl;
+                        return 1;
+                    }
+                }
+                r.pas = static_cast<long>(npas) * instances;       // pas d'instance
+                r.evaluationsParPas = m.etages;
+                statistiques(chronometrer(repetitions, [&] {
+                    lot.reinitialiser();
+                    lot.avancer(*sinus, methode, dt, npas);
+                    puits = lot.x1(0);
+                }), r.pas, r);
+                afficher(r);
+                resultats.push_back(r);
+            }
+        }
+    }
+
+    if (resultats.empty()) {
+        cerr << "Banc : aucun cas ne correspond au filtre " << filtre << endl;
+        return 1;
+    }
+    if (!json.empty()) {
+        if (!ecrireJsonBanc(json, resultats, npas, repetitions, dt)) {
+            cerr << "Banc : impossible d'écrire " << json << endl;
+            return 1;
+        }
+        cout << "  Résultats exportés dans " << json << endl;
+    }
+    return 0;
+}
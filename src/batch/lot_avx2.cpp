@@ -0,0 +1,41 @@
+// Version AVX2 (4 voies double précision).
+// Toute l'unité est compilée pour AVX2/FMA ; elle n'est appelée qu'après
+// vérification du processeur (LotCircuits, lot_circuits.cpp).
+#if defined(__x86_64__) || defined(__i386__)
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2,fma"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC target("avx2,fma")
+#endif
+
+#include <immintrin.h>
+#include "noyaux_ac.hpp"
+#include "noyaux_lot.hpp"
+
+namespace {
+
+struct Avx2 {
+    using V = __m256d;
+    static constexpr std::size_t L = 4;
+    static V charger(const double* p) { return _mm256_loadu_pd(p); }
+    static void ranger(double* p, V v) { _mm256_storeu_pd(p, v); }
+    static V diffuser(double a) { return _mm256_set1_pd(a); }
+    static V siSup(V a, V b, V x) { return _mm256_and_pd(_mm256_cmp_pd(a, b, _CMP_GT_OQ), x); }
+};
+
+} // namespace
+
+void avancerLotAvx2(const VueLot& v, NoyauLot noyau, int etages,
+                    const double* ve, std::size_t nPas, double dt) {
+    avancerLot<Avx2>(v, noyau, etages, ve, nPas, dt);
+}
+
+void reponseLotAvx2(const double num[3], const double den[3], const double* omega,
+                    std::size_t n, double* re, double* im) {
+    noyauReponse<Avx2>(num, den, omega, n, re, im);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+#endif
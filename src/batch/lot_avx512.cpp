@@ -0,0 +1,41 @@
+// Version AVX-512 (8 voies double précision).
+// Toute l'unité est compilée pour AVX-512F ; elle n'est appelée qu'après
+// vérification du processeur (LotCircuits, lot_circuits.cpp).
+#if defined(__x86_64__) || defined(__i386__)
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx512f"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC target("avx512f")
+#endif
+
+#include <immintrin.h>
+#include "noyaux_ac.hpp"
+#include "noyaux_lot.hpp"
+
+namespace {
+
+struct Avx512 {
+    using V = __m512d;
+    static constexpr std::size_t L = 8;
+    static V charger(const double* p) { return _mm512_loadu_pd(p); }
+    static void ranger(double* p, V v) { _mm512_storeu_pd(p, v); }
+    static V diffuser(double a) { return _mm512_set1_pd(a); }
+    static V siSup(V a, V b, V x) { return _mm512_maskz_mov_pd(_mm512_cmp_pd_mask(a, b, _CMP_GT_OQ), x); }
+};
+
+} // namespace
+
+void avancerLotAvx512(const VueLot& v, NoyauLot noyau, int etages,
+                      const double* ve, std::size_t nPas, double dt) {
+    avancerLot<Avx512>(v, noyau, etages, ve, nPas, dt);
+}
+
+void reponseLotAvx512(const double num[3], const double den[3], const double* omega,
+                      std::size_t n, double* re, double* im) {
+    noyauReponse<Avx512>(num, den, omega, n, re, im);
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+#endif
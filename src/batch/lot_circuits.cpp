@@ -0,0 +1,221 @@
+#include "lot_circuits.hpp"
+#include "solver_static.hpp"
+#include <algorithm>
+#include <limits>
+
+// Nombre de pas par bloc : les valeurs de la source d'un bloc (3 par pas)
+// restent en cache L1 pendant que tous les blocs de voies les relisent.
+static const std::size_t PAS_PAR_BLOC = 256;
+
+bool jeuDisponible(JeuInstructions jeu) {
+    switch (jeu) {
+        case JeuInstructions::Scalaire:
+            return true;
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+        case JeuInstructions::AVX2:
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        case JeuInstructions::AVX512:
+            return __builtin_cpu_supports("avx512f");
+#endif
+        default:
+            return false;
+    }
+}
+
+LotCircuits::LotCircuits(char typeCircuit, std::size_t nInstances)
+    : type_(typeCircuit), n_(nInstances), nVoies_((nInstances + 7) / 8 * 8),
+      jeu_(JeuInstructions::Scalaire), t_(0.0),
+      x1_(nVoies_, 0.0), x2_(nVoies_, 0.0),
+      a11_(nVoies_, 0.0), a12_(nVoies_, 0.0), a21_(nVoies_, 0.0), a22_(nVoies_, 0.0),
+      b1_(nVoies_, 0.0), b2_(nVoies_, 0.0), g1_(nVoies_, 0.0), g2_(nVoies_, 0.0),
+      ve_(3 * PAS_PAR_BLOC, 0.0), demiPas_(2 * PAS_PAR_BLOC + 1, 0.0) {
+    if (type_ != 'A' && type_ != 'B' && type_ != 'C' && type_ != 'D') {
+        type_ = 'A';
+    }
+    for (std::size_t i = 0; i < n_; ++i) {
+        definirInstance(i, 1000.0, 1e-6, 1e-3, 1000.0);
+    }
+    choisirJeuInstructions(JeuInstructions::Auto);
+}
+
+bool LotCircuits::accepte(char typeCircuit, const ParametresDiode& diode, std::string& erreur) {
+    if (typeCircuit == 'B' && diode.shockley) {
+        erreur = "circuit B : le lot n'intègre que la diode à seuil (diode=seuil)";
+        return false;
+    }
+    return true;
+}
+
+// Conversion (R, C, L, R2) -> coefficients des équations (mêmes équations que
+// CircuitA..D::deriv1/deriv2, y compris les protections contre la division par 0)
+void LotCircuits::definirInstance(std::size_t i, double R, double C, double L, double R2) {
+    a11_[i] = a12_[i] = a21_[i] = a22_[i] = b1_[i] = b2_[i] = g1_[i] = g2_[i] = 0.0;
+
+    switch (type_) {
+        case 'A':   // dv_s/dt = (ve - v_s) / (R*C)
+            a11_[i] = -1.0 / (R * C);
+            b1_[i] = 1.0 / (R * C);
+            break;
+        case 'B':   // RC + diode : conductances g1 = 1/(R1*C), g2 = 1/(R2*C)
+            g1_[i] = 1.0 / (R * C);
+            g2_[i] = 1.0 / (R2 * C);
+            break;
+        case 'C':   // RLC série : dvc/dt = i/C ; di/dt = (ve - R*i - vc)/L
+            if (C == 0.0 || L == 0.0) break;
+            a12_[i] = 1.0 / C;
+            a21_[i] = -1.0 / L;
+            a22_[i] = -R / L;
+            b2_[i] = 1.0 / L;
+            break;
+        case 'D':   // RLC parallèle : dvc/dt = (i - vc/R)/C ; di/dt = (ve - vc)/L
+            if (C == 0.0 || L == 0.0 || R == 0.0) break;
+            a11_[i] = -1.0 / (R * C);
+            a12_[i] = 1.0 / C;
+            a21_[i] = -1.0 / L;
+            b2_[i] = 1.0 / L;
+            break;
+    }
+}
+
+void LotCircuits::reinitialiser() {
+    std::fill(x1_.begin(), x1_.end(), 0.0);
+    std::fill(x2_.begin(), x2_.end(), 0.0);
+    t_ = 0.0;
+    segmentConnu_ = false;
+}
+
+void LotCircuits::choisirJeuInstructions(JeuInstructions jeu) {
+    if (jeu != JeuInstructions::Auto && jeuDisponible(jeu)) {
+        jeu_ = jeu;
+    } else if (jeuDisponible(JeuInstructions::AVX512)) {
+        jeu_ = JeuInstructions::AVX512;
+    } else if (jeuDisponible(JeuInstructions::AVX2)) {
+        jeu_ = JeuInstructions::AVX2;
+    } else {
+        jeu_ = JeuInstructions::Scalaire;
+    }
+}
+
+const char* LotCircuits::nomJeuInstructions(JeuInstructions jeu) {
+    switch (jeu) {
+        case JeuInstructions::AVX512: return "AVX-512";
+        case JeuInstructions::AVX2: return "AVX2";
+        case JeuInstructions::Scalaire: return "scalaire";
+        default: return "auto";
+    }
+}
+
+VueLot LotCircuits::vue() {
+    VueLot v;
+    v.x1 = x1_.data(); v.x2 = x2_.data();
+    v.a11 = a11_.data(); v.a12 = a12_.data(); v.a21 = a21_.data(); v.a22 = a22_.data();
+    v.b1 = b1_.data(); v.b2 = b2_.data();
+    v.g1 = g1_.data(); v.g2 = g2_.data();
+    v.vSeuil = 0.6;     // tension de seuil de la diode (modèle diode=seuil de CircuitB)
+    v.n = nVoies_;
+    return v;
+}
+
+void LotCircuits::executer(const VueLot& v, NoyauLot noyau, int etages, const double* ve,
+                           std::size_t nPas, double dt) {
+    switch (jeu_) {
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+        case JeuInstructions::AVX512:
+            avancerLotAvx512(v, noyau, etages, ve, nPas, dt);
+            break;
+        case JeuInstructions::AVX2:
+            avancerLotAvx2(v, noyau, etages, ve, nPas, dt);
+            break;
+#endif
+        default:
+            avancerLotScalaire(v, noyau, etages, ve, nPas, dt);
+            break;
+    }
+}
+
+// Même découpage que statique::pasCoupe : sous-pas arrêtés sur chaque front,
+// source vue depuis l'intervalle courant (limite à gauche en fin de sous-pas)
+void LotCircuits::pasCoupe(const Source& source, const VueLot& v, NoyauLot noyau, int etages,
+                           double t, double dt) {
+    const double marge = 1e-7 * dt;
+    const double tFin = t + dt;
+    double tc = t;
+    for (int sousPas = 1;; ++sousPas) {
+        const bool force = sousPas > statique::SOUS_PAS_MAX;
+        const bool front = !force && finSeg_ < tFin + marge;
+        const double fin = (!force && finSeg_ < tFin - marge) ? finSeg_ : tFin;
+        if (fin - tc > marge) {
+            const double h = fin - tc;
+            const double debut = debutSeg_ + marge, finSeg = finSeg_ - marge;
+            auto ve = [&](double tv) {
+                if (!source.estContinue() && !force) tv = tv < debut ? debut : (tv > finSeg ? finSeg : tv);
+                return source.ve(tv);
+            };
+            const double valeurs[3] = {ve(tc), ve(tc + h / 2), ve(tc + h)};
+            executer(v, noyau, etages, valeurs, 1, h);
+        }
+        if (force) {
+            debutSeg_ = tFin;
+            finSeg_ = source.prochaineDiscontinuite(tFin);
+            break;
+        }
+        if (!front) break;
+        tc = fin;
+        debutSeg_ = finSeg_;
+        finSeg_ = source.prochaineDiscontinuite(finSeg_);
+        if (tFin - tc <= marge) break;
+    }
+}
+
+void LotCircuits::avancer(const Source& source, int choixMeth, double dt, int npas) {
+    // Méthode -> nombre d'étages, avec les mêmes défauts que main.cpp
+    int etages;
+    if (order() == 1) {
+        etages = (choixMeth == 3) ? 4 : (choixMeth == 4) ? 2 : 1;
+    } else {
+        etages = (choixMeth == 2) ? 1 : (choixMeth == 4) ? 2 : 4;
+    }
+
+    NoyauLot noyau = (type_ == 'B') ? NoyauLot::Diode
+                   : (type_ == 'A') ? NoyauLot::Lineaire1 : NoyauLot::Lineaire2;
+    VueLot v = vue();
+    double t0 = t_;
+    const double marge = 1e-7 * dt;
+    if (!segmentConnu_) {
+        debutSeg_ = -std::numeric_limits<double>::infinity();
+        finSeg_ = source.prochaineDiscontinuite(t0);
+        segmentConnu_ = true;
+    }
+
+    for (int i0 = 0; i0 < npas; i0 += static_cast<int>(PAS_PAR_BLOC)) {
+        std::size_t nPas = std::min<std::size_t>(PAS_PAR_BLOC, static_cast<std::size_t>(npas - i0));
+
+        // Source évaluée une seule fois par étage pour tout le lot, par blocs
+        // (t, t+dt/2, t+dt d'un pas sont trois points consécutifs de la grille
+        // à dt/2)
+        source.remplir(t0 + i0 * dt, dt / 2, 2 * nPas + 1, demiPas_.data());
+        for (std::size_t k = 0; k < nPas; ++k) {
+            ve_[3 * k] = demiPas_[2 * k];
+            ve_[3 * k + 1] = (etages == 4) ? demiPas_[2 * k + 1] : 0.0;
+            ve_[3 * k + 2] = (etages >= 2) ? demiPas_[2 * k + 2] : 0.0;
+        }
+
+        // Bloc entièrement dans l'intervalle régulier : un seul appel au noyau ;
+        // sinon pas par pas, ceux qui touchent un front étant coupés
+        const double debutBloc = t0 + i0 * dt;
+        if (debutBloc > debutSeg_ + marge && finSeg_ > debutBloc + nPas * dt + marge) {
+            executer(v, noyau, etages, ve_.data(), nPas, dt);
+            continue;
+        }
+        for (std::size_t k = 0; k < nPas; ++k) {
+            const double t = t0 + (i0 + static_cast<int>(k)) * dt;
+            if (t > debutSeg_ + marge && finSeg_ > t + dt + marge) {
+                executer(v, noyau, etages, ve_.data() + 3 * k, 1, dt);
+            } else {
+                pasCoupe(source, v, noyau, etages, t, dt);
+            }
+        }
+    }
+
+    t_ = t0 + npas * dt;
+}
@@ -0,0 +1,28 @@
+#include "noyaux_ac.hpp"
+#include "noyaux_lot.hpp"
+
+// Version scalaire (une voie par "registre") : repli portable utilisé quand
+// ni AVX2 ni AVX-512 ne sont disponibles (ARM, anciens x86).
+
+namespace {
+
+struct Scalaire {
+    using V = double;
+    static constexpr std::size_t L = 1;
+    static V charger(const double* p) { return *p; }
+    static void ranger(double* p, V v) { *p = v; }
+    static V diffuser(double a) { return a; }
+    static V siSup(V a, V b, V x) { return a > b ? x : 0.0; }
+};
+
+} // namespace
+
+void avancerLotScalaire(const VueLot& v, NoyauLot noyau, int etages,
+                        const double* ve, std::size_t nPas, double dt) {
+    avancerLot<Scalaire>(v, noyau, etages, ve, nPas, dt);
+}
+
+void reponseLotScalaire(const double num[3], const double den[3], const double* omega,
+                        std::size_t n, double* re, double* im) {
+    noyauReponse<Scalaire>(num, den, omega, n, re, im);
+}
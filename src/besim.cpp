@@ -0,0 +1,167 @@
+#include "besim.hpp"
+#include "decimateur.hpp"
+#include "fabrique.hpp"
+#include "rk45.hpp"
+#include "simulation.hpp"
+#include "solver_static.hpp"
+#include <chrono>
+#include <cmath>
+
+using namespace std;
+
+bool fixerParametre(const string& cle, const string& valeur, ParametresSimulation& p,
+                    string& erreur) {
+    try {
+        if (cle == "circuit") p.circuit = valeur.empty() ? 'A' : valeur[0];
+        else if (cle == "source") p.typeSource = stoi(valeur);
+        else if (cle == "A") p.amplitude = stod(valeur);
+        else if (cle == "f") p.f = stod(valeur);
+        else if (cle == "duty") p.dutyCycle = stod(valeur);
+        else if (cle == "offset") p.offset = stod(valeur);
+        else if (cle == "t0") p.startTime = stod(valeur);
+        else if (cle == "R") p.R = stod(valeur);
+        else if (cle == "R2") p.R2 = stod(valeur);
+        else if (cle == "C") p.C = stod(valeur);
+        else if (cle == "L") p.L = stod(valeur);
+        else if (cle == "diode") {
+            if (valeur != "shockley" && valeur != "seuil") {
+                erreur = "diode=shockley|seuil";
+                return false;
+            }
+            p.diode.shockley = valeur == "shockley";
+        }
+        else if (cle == "Is") p.diode.Is = stod(valeur);
+        else if (cle == "n") p.diode.n = stod(valeur);
+        else if (cle == "Vt") p.diode.Vt = stod(valeur);
+        else if (cle == "methode") p.methode = stoi(valeur);
+        else if (cle == "npas") p.npas = stoi(valeur);
+        else if (cle == "tmax") p.tmax = stod(valeur);
+        else if (cle == "rtol") p.rtol = stod(valeur);
+        else if (cle == "atol") p.atol = stod(valeur);
+        else if (cle == "trace") p.trace = static_cast<size_t>(stoul(valeur));
+        else if (cle == "lttb") p.lttb = (valeur == "1" || valeur == "oui" || valeur == "y"
+                                          || valeur == "True");
+        else {
+            erreur = "clé inconnue : " + cle;
+            return false;
+        }
+    } catch (const exception&) {
+        erreur = "valeur invalide pour " + cle + " : " + valeur;
+        return false;
+    }
+    return true;
+}
+
+// x > 0 et fini (faux pour NaN)
+static bool positif(double x) {
+    return x > 0.0 && isfinite(x);
+}
+
+bool verifierParametres(const ParametresSimulation& p, string& erreur, int npasMax) {
+    if (p.circuit < 'A' || p.circuit > 'D') {
+        erreur = string("circuit inconnu : ") + p.circuit;
+        return false;
+    }
+    if (p.typeSource < 1 || p.typeSource > 5 || p.methode < 1 || p.methode > 10) {
+        erreur = "source (1..5) ou méthode (1..10) invalide";
+        return false;
+    }
+    if (p.npas <= 0 || !positif(p.tmax)) {
+        erreur = "npas et tmax doivent être positifs";
+        return false;
+    }
+    if (p.npas > npasMax) {
+        erreur = "npas trop grand (au plus " + to_string(npasMax) + ")";
+        return false;
+    }
+    if (!positif(p.R) || !positif(p.R2) || !positif(p.C) || !positif(p.L)) {
+        erreur = "R, R2, C et L doivent être positifs";
+        return false;
+    }
+    // Une fréquence nulle, négative ou dont la période déborde ne donne aucun
+    // front exploitable (Source::prochaineDiscontinuite) ni période (spectre,
+    // régime périodique)
+    if (!positif(p.f) || !isfinite(1.0 / p.f)) {
+        erreur = "f doit être positive et finie";
+        return false;
+    }
+    if (!(p.dutyCycle >= 0.0 && p.dutyCycle <= 1.0)) {
+        erreur = "duty doit être compris entre 0 et 1";
+        return false;
+    }
+    if (!isfinite(p.startTime) || !isfinite(p.amplitude) || !isfinite(p.offset)) {
+        erreur = "A, offset et t0 doivent être finis";
+        return false;
+    }
+    if (!positif(p.rtol) || !positif(p.atol)) {
+        erreur = "rtol et atol doivent être positifs";
+        return false;
+    }
+    if (!positif(p.diode.Is) || !positif(p.diode.n) || !positif(p.diode.Vt)) {
+        erreur = "Is, n et Vt doivent être positifs";
+        return false;
+    }
+    return true;
+}
+
+void Colonnes::allouer(size_t capacite) {
+    if (capacite != capacite_ || !donnees_) {
+        donnees_.reset(new double[3 * capacite]);
+        capacite_ = capacite;
+    }
+    n_ = 0;
+}
+
+void reduire(const Colonnes& signal, size_t points, bool lttb, Colonnes& trace) {
+    Decimateur d(signal.taille(), points, lttb ? Decimateur::Mode::Lttb : Decimateur::Mode::MinMax);
+    for (size_t i = 0; i < signal.taille(); ++i) {
+        d.ajouter(signal.temps()[i], signal.vin()[i], signal.vout()[i]);
+    }
+    d.terminer();
+    const auto& retenus = d.points();
+    trace.allouer(retenus.size());
+    for (size_t k = 0; k < retenus.size(); ++k) {
+        trace.temps()[k] = retenus[k].t;
+        trace.vin()[k] = retenus[k].vin;
+        trace.vout()[k] = retenus[k].vout;
+    }
+    trace.fixerTaille(retenus.size());
+}
+
+bool simuler(const ParametresSimulation& p, ResultatSimulation& r, string& erreur) {
+    if (!verifierParametres(p, erreur)) return false;
+    auto debut = chrono::steady_clock::now();
+
+    unique_ptr<Circuit> circuit = creerCircuit(p.circuit, p.R, p.R2, p.C, p.L, p.f, false, p.diode);
+    unique_ptr<Source> source = creerSource(p.typeSource, p.amplitude, p.f, p.dutyCycle,
+                                            p.offset, p.startTime);
+    Simulation sim(p.npas, p.tmax);
+    const size_t n = static_cast<size_t>(sim.getNpas()) + 1;
+
+    Colonnes& c = r.signal;
+    c.allouer(n);
+    double x1 = 0.0, x2 = 0.0;
+    r.pasAcceptes = r.pasRejetes = 0;
+    if (p.methode == 5) {
+        OptionsRK45 opt;
+        opt.rtol = p.rtol;
+        opt.atol = p.atol;
+        size_t nombre = 0;
+        StatsRK45 stats = simulerRK45(*circuit, *source, p.R2, sim.getNpas(), sim.getTmax(), opt,
+                                      x1, x2, c.temps(), c.vin(), c.vout(), nombre);
+        r.pasAcceptes = stats.pasAcceptes;
+        r.pasRejetes = stats.pasRejetes;
+        c.fixerTaille(nombre);
+    } else {
+        // Types fournis par la fabrique : toujours connus de l'aiguillage
+        simulerStatique(*circuit, *source, p.R2, p.methode, sim.getNpas(), sim.getDt(),
+                        x1, x2, c.temps(), c.vin(), c.vout());
+        c.fixerTaille(n);
+    }
+
+    r.trace.fixerTaille(0);
+    if (p.trace > 0) reduire(c, p.trace, p.lttb, r.trace);
+
+    r.dureeNs = chrono::duration<double, nano>(chrono::steady_clock::now() - debut).count();
+    return true;
+}
@@ -0,0 +1,373 @@
+#include "cache_resultats.hpp"
+#include "sortie_binaire.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <fcntl.h>
+#include <filesystem>
+#include <functional>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace std;
+
+// Change quand l'intégration change : les anciens fichiers deviennent des échecs
+static const char* const VERSION_CACHE = "v3";
+
+// --- Clé canonique ---
+
+static void champ(string& cle, const char* nom, double v) {
+    char tampon[32];
+    if (v == 0.0) v = 0.0;      // -0 et 0 : même trajectoire, même clé
+    auto r = to_chars(tampon, tampon + sizeof tampon, v);
+    cle += ';';
+    cle += nom;
+    cle += '=';
+    cle.append(tampon, r.ptr);
+}
+
+static void champ(string& cle, const char* nom, long v) {
+    cle += ';';
+    cle += nom;
+    cle += '=';
+    cle += to_string(v);
+}
+
+string identiteTrajectoire(const ParametresSimulation& p) {
+    string cle = VERSION_CACHE;
+    cle += ";circuit=";
+    cle += p.circuit;
+    champ(cle, "R", p.R);
+    champ(cle, "C", p.C);
+    if (p.circuit == 'B') {
+        champ(cle, "R2", p.R2);
+        if (p.diode.shockley) {
+            champ(cle, "Is", p.diode.Is);
+            champ(cle, "n", p.diode.n);
+            champ(cle, "Vt", p.diode.Vt);
+        } else {
+            cle += ";diode=seuil";
+        }
+    }
+    if (p.circuit == 'C' || p.circuit == 'D') champ(cle, "L", p.L);
+
+    // Mêmes paramètres que ceux que creerSource() transmet à chaque source
+    champ(cle, "source", static_cast<long>(p.typeSource));
+    champ(cle, "A", p.amplitude);
+    if (p.typeSource == 2) {
+        champ(cle, "t0", p.startTime);
+    } else {
+        champ(cle, "f", p.f);
+        if (p.typeSource == 4 || p.typeSource == 5) champ(cle, "duty", p.dutyCycle);
+        champ(cle, "offset", p.offset);
+    }
+
+    champ(cle, "methode", static_cast<long>(p.methode));
+    if (p.methode == 5) {
+        champ(cle, "rtol", p.rtol);
+        champ(cle, "atol", p.atol);
+    }
+    return cle;
+}
+
+string cleCanonique(const ParametresSimulation& p) {
+    string cle = identiteTrajectoire(p);
+    champ(cle, "npas", static_cast<long>(p.npas));
+    champ(cle, "tmax", p.tmax);
+    return cle;
+}
+
+uint64_t empreinteFnv1a(const string& texte) {
+    uint64_t h = 14695981039346656037ULL;
+    for (unsigned char c : texte) {
+        h ^= c;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+const char* nomOrigine(OrigineResultat origine) {
+    switch (origine) {
+        case OrigineResultat::Memoire: return "memoire";
+        case OrigineResultat::Disque: return "disque";
+        default: return "calcul";
+    }
+}
+
+// --- Niveau mémoire ---
+
+CacheResultats::CacheResultats(const OptionsCache& options) : options_(options) {
+    // La limite a pu baisser depuis la dernière exécution
+    if (!options_.dossier.empty()) {
+        lock_guard<mutex> verrou(mDisque_);
+        elaguerDisque();
+    }
+}
+
+shared_ptr<const ResultatSimulation> CacheResultats::chercher(const string& cle,
+                                                              OrigineResultat& origine,
+                                                              Reservation& reservation) {
+    reservation.liberer();
+    {
+        unique_lock<mutex> verrou(m_);
+        while (true) {
+            auto it = entrees_.find(cle);
+            if (it != entrees_.end()) {
+                lru_.splice(lru_.begin(), lru_, it->second.position);
+                ++stats_.succesMemoire;
+                origine = OrigineResultat::Memoire;
+                return it->second.resultat;
+            }
+            if (enCours_.count(cle) == 0) break;
+            cvEnCours_.wait(verrou);
+        }
+        // Réservée dès maintenant : une exception de la lecture disque la libère
+        enCours_.insert(cle);
+        reservation.cache_ = this;
+        reservation.cle_ = cle;
+    }
+    // Lecture disque hors du verrou : les appelants d'autres clés ne l'attendent pas
+    shared_ptr<const ResultatSimulation> r;
+    if (!options_.dossier.empty()) r = lireDisque(cle);
+    {
+        lock_guard<mutex> verrou(m_);
+        if (!r) {
+            ++stats_.echecs;
+            return nullptr;
+        }
+        ++stats_.succesDisque;
+        garderEnMemoire(cle, r);
+    }
+    reservation.liberer();
+    origine = OrigineResultat::Disque;
+    return r;
+}
+
+bool CacheResultats::gardable(size_t n) const {
+    return 3 * n * sizeof(double) <= options_.limiteMemoire;
+}
+
+// Mémoire d'abord, et clé libérée aussitôt : les demandeurs en attente
+// n'attendent pas l'écriture du fichier
+void CacheResultats::ranger(const string& cle, const shared_ptr<const ResultatSimulation>& r) {
+    {
+        lock_guard<mutex> verrou(m_);
+        garderEnMemoire(cle, r);
+        enCours_.erase(cle);
+    }
+    cvEnCours_.notify_all();
+    if (!options_.dossier.empty()) ecrireDisque(cle, *r);
+}
+
+void CacheResultats::liberer(const string& cle) {
+    {
+        lock_guard<mutex> verrou(m_);
+        enCours_.erase(cle);
+    }
+    cvEnCours_.notify_all();
+}
+
+void CacheResultats::Reservation::ranger(const shared_ptr<const ResultatSimulation>& r) {
+    if (!cache_) return;
+    CacheResultats* cache = cache_;
+    cache_ = nullptr;
+    cache->ranger(cle_, r);
+}
+
+void CacheResultats::Reservation::liberer() {
+    if (!cache_) return;
+    CacheResultats* cache = cache_;
+    cache_ = nullptr;
+    cache->liberer(cle_);
+}
+
+CacheResultats::Statistiques CacheResultats::statistiques() const {
+    lock_guard<mutex> verrou(m_);
+    return stats_;
+}
+
+// Appelée sous m_
+void CacheResultats::garderEnMemoire(const string& cle, const shared_ptr<const ResultatSimulation>& r) {
+    const size_t octets = 3 * r->signal.capacite() * sizeof(double);
+    if (octets > options_.limiteMemoire) return;
+    auto it = entrees_.find(cle);
+    if (it != entrees_.end()) {
+        stats_.octetsMemoire -= it->second.octets;
+        lru_.erase(it->second.position);
+        entrees_.erase(it);
+    }
+    lru_.push_front(cle);
+    entrees_.emplace(cle, Entree{r, octets, lru_.begin()});
+    stats_.octetsMemoire += octets;
+    // Les résultats évincés restent valides pour les appelants qui les tiennent
+    while (stats_.octetsMemoire > options_.limiteMemoire) {
+        auto dernier = entrees_.find(lru_.back());
+        stats_.octetsMemoire -= dernier->second.octets;
+        entrees_.erase(dernier);
+        lru_.pop_back();
+    }
+}
+
+// --- Niveau disque ---
+
+string CacheResultats::cheminDisque(const string& cle) const {
+    char hex[17];
+    const uint64_t h = empreinteFnv1a(cle);
+    for (int i = 0; i < 16; ++i) {
+        hex[i] = "0123456789abcdef"[(h >> (60 - 4 * i)) & 0xF];
+    }
+    hex[16] = '\0';
+    return options_.dossier + "/" + hex + ".bin";
+}
+
+// Valeur de "nom=" dans l'en-tête ; vide si absente
+static string valeurEntete(const string& entete, const string& nom) {
+    const string motif = "\n" + nom + "=";
+    size_t debut = entete.find(motif);
+    if (debut == string::npos) return string();
+    debut += motif.size();
+    return entete.substr(debut, entete.find('\n', debut) - debut);
+}
+
+shared_ptr<const ResultatSimulation> CacheResultats::lireDisque(const string& cle) {
+    const string chemin = cheminDisque(cle);
+    int fd = ::open(chemin.c_str(), O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    string entete(SortieBinaire::TAILLE_ENTETE, '\0');
+    shared_ptr<ResultatSimulation> r;
+    struct stat infos{};
+    if (::pread(fd, &entete[0], entete.size(), 0) == static_cast<ssize_t>(entete.size())
+        && entete.rfind("BESIM-COLONNES\n", 0) == 0 && valeurEntete(entete, "cle") == cle
+        && ::fstat(fd, &infos) == 0) {
+        const size_t n = strtoull(valeurEntete(entete, "n").c_str(), nullptr, 10);
+        const size_t valides = strtoull(valeurEntete(entete, "valides").c_str(), nullptr, 10);
+        const size_t octetsColonne = valides * sizeof(double);
+        if (valides > 0 && valides <= n
+            && static_cast<size_t>(infos.st_size) == SortieBinaire::TAILLE_ENTETE + 3 * n * sizeof(double)) {
+            auto lu = make_shared<ResultatSimulation>();
+            lu->signal.allouer(valides);
+            double* colonnes[3] = {lu->signal.temps(), lu->signal.vin(), lu->signal.vout()};
+            bool complet = true;
+            for (size_t k = 0; k < 3 && complet; ++k) {
+                const off_t position = static_cast<off_t>(SortieBinaire::TAILLE_ENTETE + k * n * sizeof(double));
+                complet = ::pread(fd, colonnes[k], octetsColonne, position)
+                          == static_cast<ssize_t>(octetsColonne);
+            }
+            if (complet) {
+                lu->signal.fixerTaille(valides);
+                lu->pasAcceptes = atol(valeurEntete(entete, "pas_acceptes").c_str());
+                lu->pasRejetes = atol(valeurEntete(entete, "pas_rejetes").c_str());
+                lu->dureeNs = atof(valeurEntete(entete, "duree_ns").c_str());
+                r = lu;
+                ::futimens(fd, nullptr);    // utilisé maintenant : dernier évincé
+            }
+        }
+    }
+    ::close(fd);
+    return r;
+}
+
+void CacheResultats::ecrireDisque(const string& cle, const ResultatSimulation& r) {
+    lock_guard<mutex> verrou(mDisque_);
+    error_code ec;
+    filesystem::create_directories(options_.dossier, ec);
+
+    // Écriture sous un nom temporaire puis renommage : un lecteur (autre
+    // thread, autre processus) ne voit jamais de fichier incomplet
+    const string chemin = cheminDisque(cle);
+    const string temporaire = chemin + ".tmp" + to_string(::getpid()) + "-"
+                              + to_string(hash<thread::id>()(this_thread::get_id()));
+    const Colonnes& s = r.signal;
+    SortieBinaire sortie;
+    if (!sortie.ouvrir(temporaire, s.taille(),
+                       {{"cle", cle},
+                        {"pas_acceptes", to_string(r.pasAcceptes)},
+                        {"pas_rejetes", to_string(r.pasRejetes)},
+                        {"duree_ns", to_string(r.dureeNs)}})) {
+        return;
+    }
+    for (size_t i = 0; i < s.taille(); ++i) {
+        sortie.ajouter(s.temps()[i], s.vin()[i], s.vout()[i]);
+    }
+    sortie.fermer();
+    if (::rename(temporaire.c_str(), chemin.c_str()) != 0) {
+        ::unlink(temporaire.c_str());
+        return;
+    }
+    elaguerDisque();
+}
+
+// Appelée sous mDisque_ : supprime les fichiers les moins récemment utilisés
+// jusqu'à repasser sous la limite
+void CacheResultats::elaguerDisque() {
+    struct Fichier {
+        filesystem::file_time_type date;
+        uintmax_t octets;
+        filesystem::path chemin;
+    };
+    vector<Fichier> fichiers;
+    uintmax_t total = 0;
+    error_code ec;
+    for (filesystem::directory_iterator it(options_.dossier, ec), fin; !ec && it != fin;
+         it.increment(ec)) {
+        if (it->path().extension() != ".bin") continue;
+        error_code e1, e2;
+        Fichier f{filesystem::last_write_time(it->path(), e1), filesystem::file_size(it->path(), e2),
+                  it->path()};
+        if (e1 || e2) continue;
+        total += f.octets;
+        fichiers.push_back(move(f));
+    }
+    if (total <= options_.limiteDisque) return;
+    sort(fichiers.begin(), fichiers.end(),
+         [](const Fichier& a, const Fichier& b) { return a.date < b.date; });
+    for (const Fichier& f : fichiers) {
+        if (total <= options_.limiteDisque) break;
+        if (filesystem::remove(f.chemin, ec)) total -= f.octets;
+    }
+}
+
+// --- Cache du processus ---
+
+static mutex mCacheProcessus;
+static unique_ptr<CacheResultats> cacheProcessus;
+
+CacheResultats& cacheResultats() {
+    lock_guard<mutex> verrou(mCacheProcessus);
+    if (!cacheProcessus) cacheProcessus = make_unique<CacheResultats>();
+    return *cacheProcessus;
+}
+
+void configurerCache(const OptionsCache& options) {
+    lock_guard<mutex> verrou(mCacheProcessus);
+    cacheProcessus = make_unique<CacheResultats>(options);
+}
+
+bool simulerEnCache(const ParametresSimulation& p, shared_ptr<const ResultatSimulation>& r,
+                    Colonnes& trace, string& erreur, OrigineResultat* origine) {
+    if (!verifierParametres(p, erreur)) return false;
+    const string cle = cleCanonique(p);
+    CacheResultats& cache = cacheResultats();
+
+    OrigineResultat o = OrigineResultat::Calcul;
+    CacheResultats::Reservation reservation;
+    r = cache.chercher(cle, o, reservation);
+    if (!r) {
+        // Le cache ne garde que le signal : la trace dépend de la demande
+        ParametresSimulation sansTrace = p;
+        sansTrace.trace = 0;
+        auto calcul = make_shared<ResultatSimulation>();
+        if (!simuler(sansTrace, *calcul, erreur)) return false;
+        reservation.ranger(calcul);
+        r = calcul;
+        o = OrigineResultat::Calcul;
+    }
+
+    trace.fixerTaille(0);
+    if (p.trace > 0) reduire(r->signal, p.trace, p.lttb, trace);
+    if (origine) *origine = o;
+    return true;
+}
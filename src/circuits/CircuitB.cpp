@@ -1,22 +1,93 @@
 #include "circuit.hpp"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 using namespace std;
 
+// Itérations de Newton au-delà desquelles on garde la dernière valeur
+static const int NEWTON_MAX = 100;
+// Argument maximal de l'exponentielle (évite un débordement avant limitation)
+static const double EXPOSANT_MAX = 100.0;
+
 // Constructeur complet avec R1 et R2
-CircuitB::CircuitB(double R1, double R2, double C, double F) : Circuit(R1, C, 0.0, F), R2_(R2) {
-    cout << "CircuitB créé : R1=" << R1 << " Ω, R2=" << R2 << " Ω, C=" << C << "F, f=" << F << "Hz" << endl;
+CircuitB::CircuitB(double R1, double R2, double C, double F, bool afficher, const ParametresDiode& diode)
+    : Circuit(R1, C, 0.0, F, "B"), R2_(R2), diode_(diode) {
+    if (afficher) {
+        cout << "CircuitB créé : R1=" << R1 << " Ω, R2=" << R2 << " Ω, C=" << C << "F, f=" << F << "Hz";
+        if (diode_.shockley)
+            cout << ", diode Is=" << diode_.Is << " A, n=" << diode_.n << ", Vt=" << diode_.Vt << " V";
+        else
+            cout << ", diode idéale à seuil 0.6 V";
+        cout << endl;
+    }
 }
-int CircuitB::order() const { return 1; }
-
 // Équation différentielle du circuit RCD avec diode
-double CircuitB::deriv1(double /*t*/, double vs, double ve, double extra) const {
-    // extra used as R2
-    double R2 = extra;
-    double vBE = 0.6;
-    if (ve > vBE) {
-        return - (1.0/(R_ * C_) + 1.0/(R2 * C_)) * vs + (ve - vBE)/(R_ * C_);
-    } else {
-        return - vs/(R2 * C_);
+// (définie inline dans circuit.hpp)
+
+double limiterJonction(double v, double ancienne, double nvt, double is) {
+    const double critique = nvt * log(nvt / (sqrt(2.0) * is));
+    if (v > critique && fabs(v - ancienne) > 2.0 * nvt) {
+        if (ancienne > 0.0) {
+            const double arg = 1.0 + (v - ancienne) / nvt;
+            v = arg > 0.0 ? ancienne + nvt * log(arg) : critique;
+        } else {
+            v = nvt * log(v / nvt);
+        }
+    }
+    return v;
+}
+
+// f(v) = Is (exp(v/nVt) - 1) - (u - v)/R1, croissante et convexe. Départ
+// où f >= 0 : v = nVt ln(1 + u/(R1 Is)) (tout le courant u/R1 dans la
+// diode) si u > 0, v = 0 sinon ; Newton décroît alors jusqu'à la racine
+double CircuitB::tensionDiode(double u) const {
+    const double nvt = diode_.n * diode_.Vt, is = diode_.Is;
+    double v = u > 0.0 ? nvt * log1p(u / (R_ * is)) : 0.0;
+    for (int k = 0; k < NEWTON_MAX; ++k) {
+        const double e = exp(min(v / nvt, EXPOSANT_MAX));
+        const double f = is * expm1(min(v / nvt, EXPOSANT_MAX)) - (u - v) / R_;
+        const double dv = f / (is * e / nvt + 1.0 / R_);
+        v -= dv;
+        if (fabs(dv) <= 1e-12 * (1.0 + fabs(v))) break;
+    }
+    return v;
+}
+
+double CircuitB::courantDiode(double u, double& g) const {
+    const double nvt = diode_.n * diode_.Vt, is = diode_.Is;
+    const double v = tensionDiode(u);
+    const double x = min(v / nvt, EXPOSANT_MAX);
+    const double gd = is * exp(x) / nvt;
+    g = gd / (1.0 + R_ * gd);
+    return is * expm1(x);
+}
+
+// Résidus (R1 et la diode en série entre ve et vs, id courant de la diode) :
+//   r1 = vs - b - gh (id - vs/R2) / C
+//   r2 = vd + R1 id + vs - ve
+// Le déterminant du jacobien, (1 + gh/(R2 C)) (1 + R1 gd) + gh gd / C, est
+// toujours positif
+int CircuitB::resoudrePas(double& vs, double& vd, double b, double gh, double ve, double extra) const {
+    const double R2 = extra;
+    const double nvt = diode_.n * diode_.Vt, is = diode_.Is;
+    if (!isfinite(vd)) vd = tensionDiode(ve - vs);
+    const double j11 = 1.0 + gh / (R2 * C_);
+    for (int k = 1; k <= NEWTON_MAX; ++k) {
+        const double x = min(vd / nvt, EXPOSANT_MAX);
+        const double id = is * expm1(x), gd = is * exp(x) / nvt;
+        const double r1 = vs - b - gh * (id - vs / R2) / C_;
+        const double r2 = vd + R_ * id + vs - ve;
+        const double j12 = -gh * gd / C_, j22 = 1.0 + R_ * gd;
+        const double det = j11 * j22 - j12;
+        const double dvs = -(j22 * r1 - j12 * r2) / det;
+        const double dvd = -(j11 * r2 - r1) / det;
+        const double vdLimitee = limiterJonction(vd + dvd, vd, nvt, is);
+        const bool converge = vdLimitee == vd + dvd &&
+                              fabs(dvs) <= 1e-12 * (1.0 + fabs(vs)) &&
+                              fabs(dvd) <= 1e-12 * (1.0 + fabs(vd));
+        vs += dvs;
+        vd = vdLimitee;
+        if (converge) return k;
     }
+    return NEWTON_MAX;
 }
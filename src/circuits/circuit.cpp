@@ -1,5 +1,6 @@
 #include "circuit.hpp"
 #include <iostream>
+#include <limits>
 using namespace std;
 
 // Constructeur par défaut
@@ -111,6 +112,12 @@ Circuit::Circuit(double R, double C, double L, double F) : R_(R), C_(C), L_(L),
     calculerConstanteTemps();
 }
 
+// Constructeur des classes dérivées (type connu dès la construction)
+
+Circuit::Circuit(double R, double C, double L, double F, const string& type) : R_(R), C_(C), L_(L), type_(type), frequency_(F), timeConstant_(0.0) {
+    calculerConstanteTemps();
+}
+
 // Fonction pour lire les valeurs du circuit depuis l'utilisateur
 
 void Circuit::lireValeurs() {
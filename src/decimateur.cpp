@@ -0,0 +1,142 @@
+#include "decimateur.hpp"
+#include "emetteur_csv.hpp"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+
+Decimateur::Decimateur(std::size_t n, std::size_t cible, Mode mode)
+    : mode_(mode) {
+    // Les échantillons 1 .. n-2 sont répartis en seaux ; 0 et n-1 sont gardés.
+    // MinMax : 4 points par seau ; LTTB : un point par seau.
+    std::size_t seaux = 0;
+    if (cible > 2) {
+        seaux = (mode == Mode::MinMax) ? std::max<std::size_t>(1, (cible - 2) / 4) : cible - 2;
+    }
+    toutGarder_ = (n < 3 || seaux == 0 || n <= cible);
+    largeurSeau_ = toutGarder_ ? 1.0 : static_cast<double>(n - 2) / static_cast<double>(seaux);
+    finSeau_ = static_cast<std::size_t>(largeurSeau_) + 1;
+    if (!toutGarder_) {
+        points_.reserve(cible + 2);
+        if (mode == Mode::Lttb) {
+            candidats_.reserve(static_cast<std::size_t>(largeurSeau_) + 2);
+            courant_.reserve(static_cast<std::size_t>(largeurSeau_) + 2);
+        }
+    }
+}
+
+void Decimateur::ajouter(double t, double vin, double vout) {
+    Point p{suivant_++, t, vin, vout};
+    if (toutGarder_) {
+        points_.push_back(p);
+        return;
+    }
+    if (p.indice == 0) {
+        garder(p);
+        return;
+    }
+    // Le précédent n'est pas le dernier échantillon : il appartient à un seau
+    if (p.indice >= 2) classer(dernier_);
+    dernier_ = p;
+}
+
+// Points gardés par ordre croissant d'indice, sans doublon
+void Decimateur::garder(const Point& p) {
+    if (points_.empty() || points_.back().indice < p.indice) {
+        points_.push_back(p);
+    }
+}
+
+void Decimateur::classer(const Point& p) {
+    while (p.indice >= finSeau_) {
+        fermerSeau();
+    }
+    if (mode_ == Mode::Lttb) {
+        courant_.push_back(p);
+        return;
+    }
+    if (seauVide_) {
+        minVout_ = maxVout_ = minVin_ = maxVin_ = p;
+        seauVide_ = false;
+        return;
+    }
+    if (p.vout < minVout_.vout) minVout_ = p;
+    if (p.vout > maxVout_.vout) maxVout_ = p;
+    if (p.vin < minVin_.vin) minVin_ = p;
+    if (p.vin > maxVin_.vin) maxVin_ = p;
+}
+
+void Decimateur::avancerFinSeau() {
+    ++numeroSeau_;
+    finSeau_ = static_cast<std::size_t>(std::floor(static_cast<double>(numeroSeau_ + 1) * largeurSeau_)) + 1;
+}
+
+void Decimateur::fermerSeau() {
+    if (mode_ == Mode::MinMax) {
+        if (!seauVide_) {
+            Point extremes[4] = {minVout_, maxVout_, minVin_, maxVin_};
+            std::sort(extremes, extremes + 4,
+                      [](const Point& a, const Point& b) { return a.indice < b.indice; });
+            for (const Point& p : extremes) garder(p);
+            seauVide_ = true;
+        }
+    } else if (!courant_.empty()) {
+        if (!candidats_.empty()) {
+            double ts = 0.0, vs = 0.0;
+            for (const Point& p : courant_) {
+                ts += p.t;
+                vs += p.vout;
+            }
+            const double inv = 1.0 / static_cast<double>(courant_.size());
+            choisir(candidats_, ts * inv, vs * inv);
+        }
+        candidats_.swap(courant_);
+        courant_.clear();
+    }
+    avancerFinSeau();
+}
+
+// LTTB : point du seau formant le plus grand triangle avec le dernier point
+// gardé et le point (ts, vs) représentant le seau suivant
+void Decimateur::choisir(const std::vector<Point>& seau, double ts, double vs) {
+    const Point& a = points_.back();
+    const Point* meilleur = &seau.front();
+    double aireMax = -1.0;
+    for (const Point& p : seau) {
+        double aire = std::fabs((a.t - ts) * (p.vout - a.vout) - (a.t - p.t) * (vs - a.vout));
+        if (aire > aireMax) {
+            aireMax = aire;
+            meilleur = &p;
+        }
+    }
+    garder(*meilleur);
+}
+
+void Decimateur::terminer() {
+    if (termine_) return;
+    termine_ = true;
+    if (toutGarder_ || suivant_ < 2) return;
+
+    // dernier_ est le dernier échantillon : fermer les seaux restants avant lui
+    fermerSeau();
+    if (mode_ == Mode::Lttb && !candidats_.empty()) {
+        choisir(candidats_, dernier_.t, dernier_.vout);
+    }
+    garder(dernier_);
+}
+
+bool Decimateur::ecrire(const std::string& chemin, double dt) const {
+    std::ofstream fichier(chemin);
+    if (!fichier) return false;
+    fichier << "temps,Vin,Vout\n";
+    EmetteurCsv format;
+    format.fixerPas(dt);
+    for (const Point& p : points_) {
+        if (format.pasFixe()) {
+            format.ligneIndice(p.indice, p.vin, p.vout);
+        } else {
+            format.ligne(p.t, p.vin, p.vout);
+        }
+    }
+    fichier.write(format.donnees(), static_cast<std::streamsize>(format.taille()));
+    return static_cast<bool>(fichier);
+}
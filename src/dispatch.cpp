@@ -0,0 +1,78 @@
+#include "solver_static.hpp"
+
+// Aiguillage (circuit, source, méthode) fait une seule fois avant la boucle.
+// Chaque combinaison instancie sa propre boucle statique::boucle<> où les
+// dérivées du circuit et ve(t) de la source sont inlinées.
+
+bool simulerStatique(const Circuit& circuit, const Source& source, double R2,
+                     int choixMeth, int npas, double dt,
+                     double& x1, double& x2, EcrivainAsynchrone& ecrivain) {
+    auto ecrire = [&ecrivain](double t, double Vin, double Vout) {
+        ecrivain.ajouter(t, Vin, Vout);
+    };
+    return statique::aiguiller(circuit, source, choixMeth,
+        [&](const auto& c, const auto& s, auto meth) {
+            statique::boucle<decltype(meth)::value>(c, s, R2, npas, dt, x1, x2, ecrire);
+        });
+}
+
+bool simulerStatique(const Circuit& circuit, const Source& source, double R2,
+                     int choixMeth, int npas, double dt,
+                     double& x1, double& x2, EtatBoucle& etat, EcrivainAsynchrone& ecrivain,
+                     int intervalle,
+                     const std::function<void(const EtatBoucle&, double, double)>& jalon) {
+    auto ecrire = [&ecrivain](double t, double Vin, double Vout) {
+        ecrivain.ajouter(t, Vin, Vout);
+    };
+    return statique::aiguiller(circuit, source, choixMeth,
+        [&](const auto& c, const auto& s, auto meth) {
+            statique::boucle<decltype(meth)::value>(c, s, R2, npas, dt, x1, x2, etat, ecrire,
+                                                    intervalle, jalon);
+        });
+}
+
+bool simulerStatique(const Circuit& circuit, const Source& source, double R2,
+                     int choixMeth, int npas, double dt,
+                     double& x1, double& x2, double* temps, double* vin, double* vout) {
+    std::size_t i = 0;
+    auto ranger = [&](double t, double Vin, double Vout) {
+        temps[i] = t;
+        vin[i] = Vin;
+        vout[i] = Vout;
+        ++i;
+    };
+    return statique::aiguiller(circuit, source, choixMeth,
+        [&](const auto& c, const auto& s, auto meth) {
+            statique::boucle<decltype(meth)::value>(c, s, R2, npas, dt, x1, x2, ranger);
+        });
+}
+
+
+bool simulerStatique(const Circuit& circuit, const Source& source, double R2,
+                     int choixMeth, int npas, double dt,
+                     double& x1, double& x2, EtatBoucle& etat,
+                     double* temps, double* vin, double* vout) {
+    std::size_t i = 0;
+    auto ranger = [&](double t, double Vin, double Vout) {
+        temps[i] = t;
+        vin[i] = Vin;
+        vout[i] = Vout;
+        ++i;
+    };
+    return statique::aiguiller(circuit, source, choixMeth,
+        [&](const auto& c, const auto& s, auto meth) {
+            statique::boucle<decltype(meth)::value>(c, s, R2, npas, dt, x1, x2, etat, ranger, 0,
+                                                    [](const EtatBoucle&, double, double) {});
+        });
+}
+
+bool avancerStatique(const Circuit& circuit, const Source& source, double R2,
+                     int choixMeth, int npas, double dt,
+                     double& x1, double& x2, EtatBoucle& etat) {
+    auto ignorer = [](double, double, double) {};
+    return statique::aiguiller(circuit, source, choixMeth,
+        [&](const auto& c, const auto& s, auto meth) {
+            statique::boucle<decltype(meth)::value>(c, s, R2, npas, dt, x1, x2, etat, ignorer, 0,
+                                                    [](const EtatBoucle&, double, double) {});
+        });
+}
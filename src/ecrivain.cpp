@@ -0,0 +1,161 @@
+#include "ecrivain.hpp"
+#include "besim.hpp"
+#include "decimateur.hpp"
+#include "flux_trames.hpp"
+#include "sortie_binaire.hpp"
+#include <algorithm>
+#include <chrono>
+
+EcrivainAsynchrone::EcrivainAsynchrone(std::ostream& sortie, const EmetteurCsv& format,
+                                       std::size_t echantillonsParPaquet, std::size_t nombrePaquets)
+    : texte_(&sortie),
+      format_(format),
+      capacite_(echantillonsParPaquet ? echantillonsParPaquet : 1) {
+    demarrer(nombrePaquets);
+}
+
+EcrivainAsynchrone::EcrivainAsynchrone(SortieBinaire& sortie, std::size_t echantillonsParPaquet,
+                                       std::size_t nombrePaquets)
+    : binaire_(&sortie),
+      capacite_(echantillonsParPaquet ? echantillonsParPaquet : 1) {
+    demarrer(nombrePaquets);
+}
+
+EcrivainAsynchrone::EcrivainAsynchrone(FluxTrames& sortie, std::size_t echantillonsParPaquet,
+                                       std::size_t nombrePaquets)
+    : flux_(&sortie),
+      capacite_(echantillonsParPaquet ? echantillonsParPaquet : 1) {
+    demarrer(nombrePaquets);
+}
+
+void EcrivainAsynchrone::demarrer(std::size_t nombrePaquets) {
+    if (nombrePaquets < 2) nombrePaquets = 2;   // un rempli, un en écriture
+    for (std::size_t i = 0; i < nombrePaquets; ++i) {
+        paquets_.push_back(std::make_unique<Paquet>());
+        paquets_.back()->donnees.resize(capacite_);
+        libres_.push_back(paquets_.back().get());
+    }
+    courant_ = libres_.front();
+    libres_.pop_front();
+    thread_ = std::thread(&EcrivainAsynchrone::boucleEcriture, this);
+}
+
+EcrivainAsynchrone::~EcrivainAsynchrone() {
+    terminer();
+}
+
+// Paquet plein : le confier au thread d'écriture et en prendre un libre
+void EcrivainAsynchrone::envoyer() {
+    std::unique_lock<std::mutex> verrou(m_);
+    pleins_.push_back(courant_);
+    cvPlein_.notify_one();
+    if (libres_.empty()) {
+        // Contre-pression : l'écriture est en retard, on attend un paquet
+        auto debut = std::chrono::steady_clock::now();
+        cvLibre_.wait(verrou, [this] { return !libres_.empty(); });
+        attente_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - debut).count();
+    }
+    courant_ = libres_.front();
+    libres_.pop_front();
+    courant_->n = 0;
+}
+
+void EcrivainAsynchrone::fixerCopie(Colonnes& copie) {
+    copie.fixerTaille(0);
+    copie_ = &copie;
+}
+
+void EcrivainAsynchrone::jalon(std::function<void()> action) {
+    courant_->apres = std::move(action);
+    envoyer();
+}
+
+void EcrivainAsynchrone::boucleEcriture() {
+    while (true) {
+        Paquet* p;
+        {
+            std::unique_lock<std::mutex> verrou(m_);
+            cvPlein_.wait(verrou, [this] { return fin_ || !pleins_.empty(); });
+            if (pleins_.empty()) {
+                break;      // fin_ et plus rien à écrire
+            }
+            p = pleins_.front();
+            pleins_.pop_front();
+        }
+
+        auto debut = std::chrono::steady_clock::now();
+        if (trace_) {
+            for (std::size_t i = 0; i < p->n; ++i) {
+                const Echantillon& e = p->donnees[i];
+                trace_->ajouter(e.t, e.vin, e.vout);
+            }
+        }
+        if (copie_) {
+            const std::size_t debutCopie = copie_->taille();
+            const std::size_t m = std::min(p->n, copie_->capacite() - debutCopie);
+            for (std::size_t i = 0; i < m; ++i) {
+                const Echantillon& e = p->donnees[i];
+                copie_->temps()[debutCopie + i] = e.t;
+                copie_->vin()[debutCopie + i] = e.vin;
+                copie_->vout()[debutCopie + i] = e.vout;
+            }
+            copie_->fixerTaille(debutCopie + m);
+        }
+        if (binaire_) {
+            for (std::size_t i = 0; i < p->n; ++i) {
+                const Echantillon& e = p->donnees[i];
+                binaire_->ajouter(e.t, e.vin, e.vout);
+            }
+            octets_ += p->n * 3 * sizeof(double);
+        } else if (flux_) {
+            // Un paquet = une trame "ECHA"
+            for (std::size_t i = 0; i < p->n; ++i) {
+                const Echantillon& e = p->donnees[i];
+                flux_->ajouter(e.t, e.vin, e.vout);
+            }
+            const std::size_t avant = flux_->octets();
+            flux_->envoyerBloc();
+            octets_ += flux_->octets() - avant;
+        } else {
+            format_.vider();
+            for (std::size_t i = 0; i < p->n; ++i) {
+                const Echantillon& e = p->donnees[i];
+                if (format_.pasFixe()) {
+                    format_.ligneIndice(lignes_++, e.vin, e.vout);
+                } else {
+                    format_.ligne(e.t, e.vin, e.vout);
+                }
+            }
+            texte_->write(format_.donnees(), static_cast<std::streamsize>(format_.taille()));
+            octets_ += format_.taille();
+        }
+        ecriture_ += std::chrono::duration<double>(std::chrono::steady_clock::now() - debut).count();
+        ++paquetsEcrits_;
+        if (p->apres) {
+            p->apres();
+            p->apres = nullptr;
+        }
+
+        {
+            std::lock_guard<std::mutex> verrou(m_);
+            libres_.push_back(p);
+        }
+        cvLibre_.notify_one();
+    }
+    if (texte_) texte_->flush();
+}
+
+void EcrivainAsynchrone::terminer() {
+    if (termine_) return;
+    termine_ = true;
+    {
+        std::lock_guard<std::mutex> verrou(m_);
+        if (courant_->n > 0) {
+            pleins_.push_back(courant_);
+        }
+        courant_ = nullptr;
+        fin_ = true;
+    }
+    cvPlein_.notify_one();
+    thread_.join();
+}
@@ -0,0 +1,176 @@
+#include "emetteur_csv.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// Un nombre tient en 32 caractères ("-1.2345678901234567e-308" pour une
+// valeur, 23 au plus pour un temps exact), une ligne en 3 nombres + 3 séparateurs
+static const std::size_t MAX_NOMBRE = 32;
+static const std::size_t MAX_LIGNE = 3 * MAX_NOMBRE + 3;
+// Chiffres au plus de la mantisse décimale de dt (produit exact) et d'un temps
+static const int CHIFFRES_PAS = 9;
+static const int CHIFFRES_TEMPS = 17;
+
+EmetteurCsv::EmetteurCsv(Mode mode, int precision)
+    : mode_(mode), precision_(std::min(17, std::max(1, precision))) {
+    tampon_.resize(8192 * MAX_LIGNE);
+}
+
+void EmetteurCsv::fixerPas(double dt) {
+    pas_ = 0.0;
+    pasExact_ = false;
+    mantissePas_ = 0;
+    exposantPas_ = 0;
+    if (!(dt > 0.0) || !std::isfinite(dt)) return;
+    pas_ = dt;
+
+    // Décimal le plus court, d'au plus CHIFFRES_PAS chiffres, à quelques ulp
+    // de dt : tmax / npas arrondi en double retrouve le pas saisi (2.5e-11 et
+    // non 2.4999999999999998e-11)
+    char b[MAX_NOMBRE];
+    std::to_chars_result r{};
+    bool trouve = false;
+    for (int chiffres = 1; chiffres <= CHIFFRES_PAS && !trouve; ++chiffres) {
+        r = std::to_chars(b, b + MAX_NOMBRE, dt, std::chars_format::scientific, chiffres - 1);
+        double relu = 0.0;
+        std::from_chars(b, r.ptr, relu);
+        trouve = std::fabs(relu - dt) <= 4.0 * std::numeric_limits<double>::epsilon() * dt;
+    }
+    if (!trouve) return;
+    pasExact_ = true;
+
+    // "d.ddde-07" -> mantisse entière et exposant
+    const char* e = std::find(b, r.ptr, 'e');
+    int chiffres = 0;
+    for (const char* c = b; c < e; ++c) {
+        if (*c >= '0' && *c <= '9') {
+            mantissePas_ = mantissePas_ * 10 + static_cast<std::uint64_t>(*c - '0');
+            ++chiffres;
+        }
+    }
+    int exposant = 0;
+    const char* debutExp = e + 1;
+    if (debutExp < r.ptr && *debutExp == '+') ++debutExp;    // from_chars refuse le '+'
+    std::from_chars(debutExp, r.ptr, exposant);
+    exposantPas_ = exposant - (chiffres - 1);
+}
+
+char* EmetteurCsv::reserver() {
+    if (tampon_.size() - taille_ < MAX_LIGNE) {
+        tampon_.resize(std::max(2 * tampon_.size(), taille_ + MAX_LIGNE));
+    }
+    return tampon_.data() + taille_;
+}
+
+char* EmetteurCsv::valeur(char* p, double v) const {
+    if (mode_ == Mode::Court) {
+        return std::to_chars(p, p + MAX_NOMBRE, v).ptr;
+    }
+    return std::to_chars(p, p + MAX_NOMBRE, v, std::chars_format::general, precision_).ptr;
+}
+
+// Écrit i * dt : produit entier des mantisses arrondi à CHIFFRES_TEMPS
+// chiffres, puis placement de la virgule (notation fixe) ou exposant si le
+// nombre est très petit ou très grand. Sans entiers de 128 bits, i * dt
+// calculé en double, comme pour un pas non décimal
+char* EmetteurCsv::temps(char* p, std::size_t i) const {
+#ifndef __SIZEOF_INT128__
+    return valeur(p, static_cast<double>(i) * pas_);
+#else
+    if (mode_ == Mode::Fixe || !pasExact_) {
+        return valeur(p, static_cast<double>(i) * pas_);
+    }
+    if (i == 0) {
+        *p++ = '0';
+        return p;
+    }
+    // indice < 2^64 et mantisse < 10^9 : le produit tient sur 128 bits
+    using Entier128 = unsigned __int128;
+    Entier128 exact = static_cast<Entier128>(i) * mantissePas_;
+    int e = exposantPas_;
+    const Entier128 limite = 100000000000000000ULL;     // 10^CHIFFRES_TEMPS
+    if (exact >= limite) {
+        // Arrondi au plus proche (égalité vers le pair) à CHIFFRES_TEMPS chiffres
+        Entier128 diviseur = 1;
+        while (exact / diviseur >= limite) {
+            diviseur *= 10;
+            ++e;
+        }
+        const Entier128 reste = exact % diviseur;
+        exact /= diviseur;
+        if (2 * reste > diviseur || (2 * reste == diviseur && exact % 2 == 1)) ++exact;
+        if (exact == limite) {
+            exact /= 10;
+            ++e;
+        }
+    }
+    std::uint64_t produit = static_cast<std::uint64_t>(exact);
+    while (produit % 10 == 0) {
+        produit /= 10;
+        ++e;
+    }
+    char chiffres[24] = {};
+    const int n = static_cast<int>(std::to_chars(chiffres, chiffres + sizeof chiffres, produit).ptr - chiffres);
+    const int e10 = e + n - 1;  // exposant en notation scientifique
+
+    if (e10 < -4 || e10 >= 21) {
+        *p++ = chiffres[0];
+        if (n > 1) {
+            *p++ = '.';
+            std::memcpy(p, chiffres + 1, static_cast<std::size_t>(n - 1));
+            p += n - 1;
+        }
+        *p++ = 'e';
+        *p++ = (e10 < 0) ? '-' : '+';
+        const int a = (e10 < 0) ? -e10 : e10;
+        if (a < 10) *p++ = '0';
+        return std::to_chars(p, p + 4, a).ptr;
+    }
+    if (e >= 0) {
+        std::memcpy(p, chiffres, static_cast<std::size_t>(n));
+        p += n;
+        std::memset(p, '0', static_cast<std::size_t>(e));
+        return p + e;
+    }
+    const int entiers = n + e;
+    if (entiers > 0) {
+        std::memcpy(p, chiffres, static_cast<std::size_t>(entiers));
+        p += entiers;
+        *p++ = '.';
+        std::memcpy(p, chiffres + entiers, static_cast<std::size_t>(-e));
+        return p - e;
+    }
+    *p++ = '0';
+    *p++ = '.';
+    std::memset(p, '0', static_cast<std::size_t>(-entiers));
+    p += -entiers;
+    std::memcpy(p, chiffres, static_cast<std::size_t>(n));
+    return p + n;
+#endif
+}
+
+void EmetteurCsv::ligne(double t, double vin, double vout) {
+    char* p = reserver();
+    char* debut = p;
+    p = valeur(p, t);
+    *p++ = ',';
+    p = valeur(p, vin);
+    *p++ = ',';
+    p = valeur(p, vout);
+    *p++ = '\n';
+    taille_ += static_cast<std::size_t>(p - debut);
+}
+
+void EmetteurCsv::ligneIndice(std::size_t i, double vin, double vout) {
+    char* p = reserver();
+    char* debut = p;
+    p = temps(p, i);
+    *p++ = ',';
+    p = valeur(p, vin);
+    *p++ = ',';
+    p = valeur(p, vout);
+    *p++ = '\n';
+    taille_ += static_cast<std::size_t>(p - debut);
+}
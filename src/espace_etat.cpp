@@ -0,0 +1,686 @@
+#include "espace_etat.hpp"
+#include "besim.hpp"
+#include "emetteur_csv.hpp"
+#include "fabrique.hpp"
+#include "noyaux_etat.hpp"
+#include "propagateur.hpp"
+#include "solver_static.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+using namespace std;
+
+bool CircuitEtat::definir(int n, const vector<double>& a, const vector<double>& b,
+                          const vector<double>& c, double d, string& erreur) {
+    if (n <= 0) {
+        erreur = "au moins un état requis";
+        return false;
+    }
+    const size_t taille = static_cast<size_t>(n);
+    if (a.size() != taille * taille || b.size() != taille || c.size() != taille) {
+        ostringstream os;
+        os << n << " états : A doit compter " << taille * taille << " valeurs, B et C " << n
+           << " (lu " << a.size() << ", " << b.size() << ", " << c.size() << ")";
+        erreur = os.str();
+        return false;
+    }
+    n_ = n;
+    h_ = etat::hauteur(n);
+    a_.assign(taille * h_, 0.0);
+    b_.assign(h_, 0.0);
+    c_.assign(h_, 0.0);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) a_[static_cast<size_t>(j) * h_ + i] = a[i * taille + j];
+        b_[i] = b[i];
+        c_[i] = c[i];
+    }
+    d_ = d;
+    return true;
+}
+
+// --- Modèles ---
+
+bool modeleCircuit(const Circuit& circuit, double R2, CircuitEtat& e, string& erreur) {
+    if (!circuit.lineaire()) {
+        erreur = "circuit non linéaire : pas de modèle d'état (circuits A, C, D)";
+        return false;
+    }
+    if (circuit.order() == 1) {
+        const double a = circuit.jacobien1(0.0, 0.0, 0.0, R2);
+        const double b = circuit.deriv1(0.0, 0.0, 1.0, R2) - circuit.deriv1(0.0, 0.0, 0.0, R2);
+        return e.definir(1, {a}, {b}, {1.0}, 0.0, erreur);
+    }
+    vector<double> a(4);
+    double u1, u2, z1, z2;
+    circuit.jacobien2(0.0, 0.0, 0.0, 0.0, a[0], a[1], a[2], a[3]);
+    circuit.deriv2(0.0, 0.0, 0.0, 1.0, u1, u2);
+    circuit.deriv2(0.0, 0.0, 0.0, 0.0, z1, z2);
+    return e.definir(2, a, {u1 - z1, u2 - z2}, {1.0, 0.0}, 0.0, erreur);
+}
+
+// C dvk/dt = (v(k-1) - vk) / R - (vk - v(k+1)) / R, v0 = ve, pas de courant
+// au-delà de la dernière cellule
+void modeleEchelle(int sections, double R, double C, CircuitEtat& e) {
+    const int n = sections;
+    const double g = 1.0 / (R * C);
+    vector<double> a(static_cast<size_t>(n) * n, 0.0), b(n, 0.0), c(n, 0.0);
+    for (int k = 0; k < n; ++k) {
+        a[k * n + k] = (k + 1 < n) ? -2.0 * g : -g;
+        if (k > 0) a[k * n + k - 1] = g;
+        if (k + 1 < n) a[k * n + k + 1] = g;
+    }
+    b[0] = g;
+    c[n - 1] = 1.0;
+    string erreur;
+    e.definir(n, a, b, c, 0.0, erreur);
+}
+
+// État (v1, i1, v2, i2, ...) :
+//   L dik/dt = v(k-1) - R ik - vk        (v0 = ve)
+//   C dvk/dt = ik - i(k+1)               (courant nul après la dernière cellule)
+void modeleRLC(int sections, double R, double L, double C, CircuitEtat& e) {
+    const int n = 2 * sections;
+    vector<double> a(static_cast<size_t>(n) * n, 0.0), b(n, 0.0), c(n, 0.0);
+    for (int k = 0; k < sections; ++k) {
+        const int v = 2 * k, i = 2 * k + 1;
+        a[v * n + i] = 1.0 / C;
+        if (k + 1 < sections) a[v * n + i + 2] = -1.0 / C;
+        a[i * n + v] = -1.0 / L;
+        a[i * n + i] = -R / L;
+        if (k > 0) a[i * n + v - 2] = 1.0 / L;
+    }
+    b[1] = 1.0 / L;
+    c[n - 2] = 1.0;
+    string erreur;
+    e.definir(n, a, b, c, 0.0, erreur);
+}
+
+bool lireCircuitEtat(istream& entree, const string& nom, CircuitEtat& e, string& erreur) {
+    vector<double> valeurs[4];      // A, B, C, D
+    int courant = -1;
+    string ligne;
+    int numero = 0;
+    while (getline(entree, ligne)) {
+        ++numero;
+        ligne = ligne.substr(0, ligne.find('#'));
+        replace(ligne.begin(), ligne.end(), ',', ' ');
+        istringstream mots(ligne);
+        string mot;
+        while (mots >> mot) {
+            if (mot.size() == 1 && string("AaBbCcDd").find(mot[0]) != string::npos) {
+                courant = toupper(static_cast<unsigned char>(mot[0])) - 'A';
+                continue;
+            }
+            char* fin = nullptr;
+            const double v = strtod(mot.c_str(), &fin);
+            if (fin == mot.c_str() || *fin != '\0' || !isfinite(v)) {
+                erreur = nom + ":" + to_string(numero) + " : valeur invalide '" + mot + "'";
+                return false;
+            }
+            if (courant < 0) {
+                erreur = nom + ":" + to_string(numero) + " : valeur avant le premier mot-clé (A, B, C, D)";
+                return false;
+            }
+            valeurs[courant].push_back(v);
+        }
+    }
+    if (valeurs[3].size() > 1) {
+        erreur = nom + " : D doit compter une seule valeur";
+        return false;
+    }
+    if (!e.definir(static_cast<int>(valeurs[1].size()), valeurs[0], valeurs[1], valeurs[2],
+                   valeurs[3].empty() ? 0.0 : valeurs[3][0], erreur)) {
+        erreur = nom + " : " + erreur;
+        return false;
+    }
+    return true;
+}
+
+// --- Applications affines des méthodes implicites et exacte ---
+
+// Vecteur z d'un pas : x (n valeurs), deux valeurs de la source, puis l'état
+// au début du pas précédent (BDF2). Colonnes de M dans le même ordre.
+//   6 Euler implicite : x+ = (I - hA)⁻¹ (x + h B u1)                z_n = u1
+//   7 trapèzes : x+ = (I - h/2 A)⁻¹ ((I + h/2 A) x + h/2 B (u0 + u1))  z_n = u0 + u1
+//   8 BDF2 : x+ = (I - ghA)⁻¹ (a x - b x- + gh B u1)                z_n = u1
+//   10 exacte : x+ = Φ x + Γ0 u0 + Γ1 (u1 - u0) / h               z_n = u0, z_n+1 = pente
+struct Application {
+    int methode = 0;
+    double h = 0.0, w = 0.0;        // longueur du pas, rapport au pas précédent (BDF2)
+    int colonnes = 0;
+    vector<double> m;
+};
+
+// Inverse d'une matrice n x n (ligne par ligne), pivot partiel ; false si
+// elle est singulière
+static bool inverser(int n, vector<double> a, vector<double>& inverse) {
+    inverse.assign(static_cast<size_t>(n) * n, 0.0);
+    for (int i = 0; i < n; ++i) inverse[i * n + i] = 1.0;
+    for (int k = 0; k < n; ++k) {
+        int p = k;
+        for (int i = k + 1; i < n; ++i) {
+            if (fabs(a[i * n + k]) > fabs(a[p * n + k])) p = i;
+        }
+        if (!(fabs(a[p * n + k]) > 0.0)) return false;
+        if (p != k) {
+            for (int j = 0; j < n; ++j) {
+                swap(a[k * n + j], a[p * n + j]);
+                swap(inverse[k * n + j], inverse[p * n + j]);
+            }
+        }
+        const double pivot = a[k * n + k];
+        for (int j = 0; j < n; ++j) {
+            a[k * n + j] /= pivot;
+            inverse[k * n + j] /= pivot;
+        }
+        for (int i = 0; i < n; ++i) {
+            const double f = a[i * n + k];
+            if (i == k || f == 0.0) continue;
+            for (int j = 0; j < n; ++j) {
+                a[i * n + j] -= f * a[k * n + j];
+                inverse[i * n + j] -= f * inverse[k * n + j];
+            }
+        }
+    }
+    return true;
+}
+
+static bool construireApplication(const CircuitEtat& c, int methode, double h, double w,
+                                  Application& app) {
+    const int n = c.ordre(), hc = c.hauteur();
+    app.methode = methode;
+    app.h = h;
+    app.w = w;
+    app.colonnes = (methode == 8) ? 2 * n + 2 : (methode == 10 ? n + 2 : n + 1);
+    app.m.assign(static_cast<size_t>(app.colonnes) * hc, 0.0);
+    auto colonne = [&app, hc](int j) { return app.m.data() + static_cast<size_t>(j) * hc; };
+
+    if (methode == 10) {
+        // exp de la matrice augmentée [[A h, B h, 0], [0, 0, h], [0, 0, 0]]
+        const int m = n + 2;
+        vector<double> aug(static_cast<size_t>(m) * m, 0.0), e(aug.size());
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) aug[i * m + j] = c.a(i, j) * h;
+            aug[i * m + n] = c.b()[i] * h;
+        }
+        aug[n * m + n + 1] = h;
+        exponentielleMatrice(m, aug.data(), e.data());
+        for (int j = 0; j < n + 2; ++j) {
+            for (int i = 0; i < n; ++i) colonne(j)[i] = e[i * m + j];
+        }
+        return true;
+    }
+
+    // (I - gamma A)⁻¹, gamma = h, h/2 ou g h
+    double gamma = h, coefX = 1.0, coefPasse = 0.0;
+    if (methode == 7) {
+        gamma = 0.5 * h;
+    } else if (methode == 8) {
+        gamma = (1.0 + w) / (1.0 + 2.0 * w) * h;
+        coefX = (1.0 + w) * (1.0 + w) / (1.0 + 2.0 * w);
+        coefPasse = -w * w / (1.0 + 2.0 * w);
+    }
+    vector<double> ia(static_cast<size_t>(n) * n), inverse;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) ia[i * n + j] = (i == j ? 1.0 : 0.0) - gamma * c.a(i, j);
+    }
+    if (!inverser(n, ia, inverse)) return false;
+
+    for (int i = 0; i < n; ++i) {
+        double mb = 0.0;
+        for (int l = 0; l < n; ++l) mb += inverse[i * n + l] * c.b()[l];
+        colonne(n)[i] = gamma * mb;
+        for (int j = 0; j < n; ++j) {
+            if (methode == 7) {
+                // (I - h/2 A)⁻¹ (I + h/2 A)
+                double v = inverse[i * n + j];
+                for (int l = 0; l < n; ++l) v += inverse[i * n + l] * gamma * c.a(l, j);
+                colonne(j)[i] = v;
+            } else {
+                colonne(j)[i] = coefX * inverse[i * n + j];
+                if (methode == 8) colonne(n + 2 + j)[i] = coefPasse * inverse[i * n + j];
+            }
+        }
+    }
+    return true;
+}
+
+// Rayon spectral de A (mode automatique) : ||A^(2^k)||^(1/2^k), par
+// élévations au carré successives, chaque puissance ramenée à norme 1
+static double rayonSpectral(const CircuitEtat& c) {
+    const int n = c.ordre();
+    vector<double> p(static_cast<size_t>(n) * n), q(p.size());
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) p[i * n + j] = c.a(i, j);
+    }
+    auto normer = [n](vector<double>& m) {
+        double norme = 0.0;
+        for (int i = 0; i < n; ++i) {
+            double ligne = 0.0;
+            for (int j = 0; j < n; ++j) ligne += fabs(m[i * n + j]);
+            norme = max(norme, ligne);
+        }
+        if (norme > 0.0) {
+            for (double& v : m) v /= norme;
+        }
+        return norme;
+    };
+    double norme = normer(p);
+    if (!(norme > 0.0)) return 0.0;
+    double logRayon = log(norme), poids = 1.0;
+    for (int k = 0; k < 12; ++k) {
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                double v = 0.0;
+                for (int l = 0; l < n; ++l) v += p[i * n + l] * p[l * n + j];
+                q[i * n + j] = v;
+            }
+        }
+        p.swap(q);
+        norme = normer(p);
+        if (!(norme > 0.0)) return 0.0;     // A nilpotente
+        poids *= 0.5;
+        logRayon += poids * log(norme);
+    }
+    return exp(logRayon);
+}
+
+// --- Intégration ---
+
+namespace {
+
+// N : nombre d'états connu à la compilation (0 : lu à l'exécution).
+// z_ contient l'état courant puis les autres entrées des applications
+// affines (voir Application)
+template <int N>
+class Integrateur {
+public:
+    explicit Integrateur(const CircuitEtat& c)
+        : c_(c), n_(c.ordre()), h_(c.hauteur()),
+          z_(2 * h_ + 2, 0.0), k1_(h_), k2_(h_), k3_(h_), k4_(h_), y_(h_), entree_(h_) {}
+
+    // Un pas de longueur dt, source u0 = ve(t), um = ve(t + dt/2), u1 = ve(t + dt).
+    // false si la matrice d'un pas implicite est singulière
+    template <int choixMeth>
+    bool pas(double dt, double u0, double um, double u1) {
+        const int n = N > 0 ? N : n_;
+        double* x = z_.data();
+        if constexpr (choixMeth >= 6) {
+            copy(x, x + n, entree_.begin());
+            bool ok = true;
+            if constexpr (choixMeth == 9) {
+                if (rayon_ < 0.0) rayon_ = rayonSpectral(c_);
+                const double rho = dt * rayon_;
+                raide_ = raide_ ? (rho > statique::SEUIL_NON_RAIDE) : (rho > statique::SEUIL_RAIDE);
+                if (raide_) ok = bdf2(dt, u1);
+                else rk4(dt, u0, um, u1);
+            } else if constexpr (choixMeth == 8) {
+                ok = bdf2(dt, u1);
+            } else {
+                ok = affine(choixMeth, dt, 0.0, u0, u1);
+            }
+            // État au début de ce pas : passé du suivant
+            copy(entree_.begin(), entree_.begin() + n, x + n + 2);
+            hPasse_ = dt;
+            passeValide_ = true;
+            return ok;
+        } else if constexpr (choixMeth == 3) {
+            rk4(dt, u0, um, u1);
+        } else if constexpr (choixMeth == 4) {
+            derivee(x, u0, k1_.data());
+            for (int i = 0; i < n; ++i) k2_[i] = x[i] + dt * k1_[i];
+            derivee(k2_.data(), u1, k3_.data());
+            for (int i = 0; i < n; ++i) x[i] += dt * (k1_[i] + k3_[i]) / 2.0;
+        } else {
+            derivee(x, u0, k1_.data());
+            for (int i = 0; i < n; ++i) x[i] += dt * k1_[i];
+        }
+        return true;
+    }
+
+    // Front de la source : plus de passé pour BDF2
+    void oublierPasse() { passeValide_ = false; }
+
+    double sortie(double u) const {
+        const int n = N > 0 ? N : n_;
+        double y = c_.d() * u;
+        for (int i = 0; i < n; ++i) y += c_.c()[i] * z_[i];
+        return y;
+    }
+
+private:
+    const CircuitEtat& c_;
+    const int n_, h_;
+    vector<double> z_, k1_, k2_, k3_, k4_, y_;
+    vector<double> entree_;         // état au début du pas en cours
+    double hPasse_ = 0.0;
+    bool passeValide_ = false;
+    bool raide_ = false;
+    double rayon_ = -1.0;
+    // Applications affines déjà calculées (pas nominal, sous-pas des fronts,
+    // démarrage de BDF2), remplacées à tour de rôle
+    vector<Application> applications_;
+    size_t suivante_ = 0;
+
+    void combiner(const double* m, int colonnes, const double* z, double* y) const {
+        if constexpr (N > 0) etat::combiner<etat::hauteur(N)>(m, colonnes, z, y);
+        else etat::combiner(m, h_, colonnes, z, y);
+    }
+
+    // d = A x + B u
+    void derivee(const double* x, double u, double* d) const {
+        const int n = N > 0 ? N : n_;
+        combiner(c_.a(), n, x, d);
+        for (int i = 0; i < n; ++i) d[i] += c_.b()[i] * u;
+    }
+
+    // RK4, même écriture que statique::rk4
+    void rk4(double dt, double u0, double um, double u1) {
+        const int n = N > 0 ? N : n_;
+        double* x = z_.data();
+        derivee(x, u0, k1_.data());
+        for (int i = 0; i < n; ++i) {
+            k1_[i] *= dt;
+            y_[i] = x[i] + k1_[i] / 2;
+        }
+        derivee(y_.data(), um, k2_.data());
+        for (int i = 0; i < n; ++i) {
+            k2_[i] *= dt;
+            y_[i] = x[i] + k2_[i] / 2;
+        }
+        derivee(y_.data(), um, k3_.data());
+        for (int i = 0; i < n; ++i) {
+            k3_[i] *= dt;
+            y_[i] = x[i] + k3_[i];
+        }
+        derivee(y_.data(), u1, k4_.data());
+        for (int i = 0; i < n; ++i) {
+            x[i] += (k1_[i] + 2 * k2_[i] + 2 * k3_[i] + dt * k4_[i]) / 6;
+        }
+    }
+
+    bool bdf2(double dt, double u1) {
+        if (!passeValide_ || hPasse_ <= 0.0) return affine(6, dt, 0.0, 0.0, u1);
+        return affine(8, dt, dt / hPasse_, 0.0, u1);
+    }
+
+    bool affine(int methode, double dt, double w, double u0, double u1) {
+        const int n = N > 0 ? N : n_;
+        const Application* app = nullptr;
+        for (const Application& a : applications_) {
+            if (a.methode == methode && fabs(dt - a.h) <= 1e-9 * dt && fabs(w - a.w) <= 1e-9 * w) {
+                app = &a;
+                break;
+            }
+        }
+        if (!app) {
+            if (applications_.size() < 8) applications_.emplace_back();
+            Application& a = applications_[suivante_];
+            suivante_ = (suivante_ + 1) % 8;
+            if (!construireApplication(c_, methode, dt, w, a)) {
+                a.methode = 0;
+                return false;
+            }
+            app = &a;
+        }
+        double* z = z_.data();
+        if (methode == 7) {
+            z[n] = u0 + u1;
+        } else if (methode == 10) {
+            z[n] = u0;
+            z[n + 1] = (u1 - u0) / dt;
+        } else {
+            z[n] = u1;
+        }
+        combiner(app->m.data(), app->colonnes, z, y_.data());
+        copy(y_.begin(), y_.begin() + n, z);
+        return true;
+    }
+};
+
+// Boucle à pas fixe, même découpage que statique::boucle (source tabulée
+// par blocs, pas coupés sur les fronts). sortie(t, Vin, Vout)
+template <int N, int choixMeth, class Sortie>
+bool boucleEtat(const CircuitEtat& c, const Source& s, int npas, double dt, Sortie&& sortie,
+                string& erreur) {
+    Integrateur<N> integrateur(c);
+    const double marge = 1e-7 * dt;
+    double debutSeg = -numeric_limits<double>::infinity();
+    double finSeg = s.prochaineDiscontinuite(0.0);
+    constexpr int P = statique::PAS_PAR_BLOC_SOURCE;
+    double tampon[2 * P + 1];
+
+    for (int i0 = 0; i0 <= npas; i0 += P) {
+        const int i1 = min(npas + 1, i0 + P);
+        s.remplir(i0 * dt, 0.5 * dt, 2 * P + 1, tampon);
+        for (int i = i0; i < i1; ++i) {
+            const double t = i * dt;
+            double vin, uFin;
+            bool ok = true;
+            if (t > debutSeg + marge && finSeg > t + dt + marge) {
+                const double* u = tampon + 2 * (i - i0);
+                vin = u[0];
+                uFin = u[2];
+                ok = integrateur.template pas<choixMeth>(dt, u[0], u[1], u[2]);
+            } else {
+                // Pas coupé sur les fronts (statique::pasCoupe)
+                const double tFin = t + dt;
+                double tc = t;
+                vin = uFin = s.ve(t);
+                bool premier = true;
+                for (int sousPas = 1; ok; ++sousPas) {
+                    const bool force = sousPas > statique::SOUS_PAS_MAX;
+                    const bool front = !force && finSeg < tFin + marge;
+                    const double fin = (!force && finSeg < tFin - marge) ? finSeg : tFin;
+                    if (fin - tc > marge) {
+                        const double h = fin - tc;
+                        const statique::SourceSegment<Source> seg{s, debutSeg + marge, finSeg - marge};
+                        auto ve = [&](double tv) {
+                            return (s.estContinue() || force) ? s.ve(tv) : seg.ve(tv);
+                        };
+                        const double u0 = ve(tc);
+                        uFin = ve(tc + h);
+                        ok = integrateur.template pas<choixMeth>(h, u0, ve(tc + h / 2), uFin);
+                        if (premier) {
+                            vin = u0;
+                            premier = false;
+                        }
+                    }
+                    if (force) {
+                        debutSeg = tFin;
+                        finSeg = s.prochaineDiscontinuite(tFin);
+                        integrateur.oublierPasse();
+                        break;
+                    }
+                    if (!front) break;
+                    tc = fin;
+                    debutSeg = finSeg;
+                    finSeg = s.prochaineDiscontinuite(finSeg);
+                    integrateur.oublierPasse();
+                    if (tFin - tc <= marge) break;
+                }
+            }
+            if (!ok) {
+                ostringstream os;
+                os << "matrice I - h A singulière à t = " << t;
+                erreur = os.str();
+                return false;
+            }
+            double vout = integrateur.sortie(uFin);
+            // pour avoir des sorties propres (éviter les -0.000000)
+            if (fabs(vout) < 1e-12) vout = 0.0;
+            sortie(t, vin, vout);
+        }
+    }
+    return true;
+}
+
+// Aiguillage (ordre, méthode) : visiteur(integral_constant<N>, integral_constant<méthode>)
+template <int N, class Visiteur>
+bool aiguillerMethode(int choixMeth, Visiteur&& v) {
+    switch (choixMeth) {
+        case 1: case 2: return v(integral_constant<int, N>{}, integral_constant<int, 1>{});
+        case 3: return v(integral_constant<int, N>{}, integral_constant<int, 3>{});
+        case 4: return v(integral_constant<int, N>{}, integral_constant<int, 4>{});
+        case 6: return v(integral_constant<int, N>{}, integral_constant<int, 6>{});
+        case 7: return v(integral_constant<int, N>{}, integral_constant<int, 7>{});
+        case 8: return v(integral_constant<int, N>{}, integral_constant<int, 8>{});
+        case 9: return v(integral_constant<int, N>{}, integral_constant<int, 9>{});
+        default: return v(integral_constant<int, N>{}, integral_constant<int, 10>{});
+    }
+}
+
+template <class Visiteur>
+bool aiguillerEtat(int ordre, int choixMeth, Visiteur&& v) {
+    static_assert(etat::ORDRE_MAX_SPECIALISE == 8, "aiguillage à compléter");
+    // Comme statique::pas : le choix 1 (Euler d'ordre 1) donne RK4 dès
+    // l'ordre 2, seul le choix 2 y est Euler
+    if (choixMeth == 1 && ordre >= 2) choixMeth = 3;
+    switch (ordre) {
+        case 1: return aiguillerMethode<1>(choixMeth, v);
+        case 2: return aiguillerMethode<2>(choixMeth, v);
+        case 3: return aiguillerMethode<3>(choixMeth, v);
+        case 4: return aiguillerMethode<4>(choixMeth, v);
+        case 5: return aiguillerMethode<5>(choixMeth, v);
+        case 6: return aiguillerMethode<6>(choixMeth, v);
+        case 7: return aiguillerMethode<7>(choixMeth, v);
+        case 8: return aiguillerMethode<8>(choixMeth, v);
+        default: return aiguillerMethode<0>(choixMeth, v);
+    }
+}
+
+bool methodeValide(int choixMeth, string& erreur) {
+    if (choixMeth >= 1 && choixMeth <= 10 && choixMeth != 5) return true;
+    erreur = "méthode à pas fixe requise (1 à 4, 6 à 10)";
+    return false;
+}
+
+} // namespace
+
+bool simulerEtat(const CircuitEtat& circuit, const Source& source, int choixMeth, int npas,
+                 double dt, EcrivainAsynchrone& ecrivain, string& erreur) {
+    if (!methodeValide(choixMeth, erreur)) return false;
+    auto ecrire = [&ecrivain](double t, double Vin, double Vout) { ecrivain.ajouter(t, Vin, Vout); };
+    return aiguillerEtat(circuit.ordre(), choixMeth, [&](auto n, auto meth) {
+        return boucleEtat<decltype(n)::value, decltype(meth)::value>(circuit, source, npas, dt, ecrire,
+                                                                   erreur);
+    });
+}
+
+bool simulerEtat(const CircuitEtat& circuit, const Source& source, int choixMeth, int npas,
+                 double dt, double* temps, double* vin, double* vout, string& erreur) {
+    if (!methodeValide(choixMeth, erreur)) return false;
+    size_t i = 0;
+    auto ranger = [&](double t, double Vin, double Vout) {
+        temps[i] = t;
+        vin[i] = Vin;
+        vout[i] = Vout;
+        ++i;
+    };
+    return aiguillerEtat(circuit.ordre(), choixMeth, [&](auto n, auto meth) {
+        return boucleEtat<decltype(n)::value, decltype(meth)::value>(circuit, source, npas, dt, ranger,
+                                                                   erreur);
+    });
+}
+
+// --- Mode modèle d'état ---
+
+int lancerEtat(int argc, char** argv) {
+    ParametresSimulation p;
+    string modele = "circuit", fichierModele, sortie = "resultats/etat/etat.csv";
+    int sections = 4;
+    string erreur;
+    for (int i = 0; i < argc; ++i) {
+        string arg = argv[i];
+        size_t eg = arg.find('=');
+        if (eg == string::npos) {
+            cerr << "Modèle d'état : argument sans '=' : " << arg << endl;
+            return 1;
+        }
+        string cle = arg.substr(0, eg), valeur = arg.substr(eg + 1);
+        if (cle == "modele") modele = valeur;
+        else if (cle == "sections") sections = atoi(valeur.c_str());
+        else if (cle == "fichier") fichierModele = valeur;
+        else if (cle == "sortie") sortie = valeur;
+        else if (!fixerParametre(cle, valeur, p, erreur)) {
+            cerr << "Modèle d'état : " << erreur << endl;
+            return 1;
+        }
+    }
+    if (!verifierParametres(p, erreur) || !methodeValide(p.methode, erreur)) {
+        cerr << "Modèle d'état : " << erreur << endl;
+        return 1;
+    }
+
+    CircuitEtat circuit;
+    string description;
+    if (!fichierModele.empty()) {
+        ifstream entree(fichierModele);
+        if (!entree) {
+            cerr << "Modèle d'état : impossible de lire " << fichierModele << endl;
+            return 1;
+        }
+        if (!lireCircuitEtat(entree, fichierModele, circuit, erreur)) {
+            cerr << "Modèle d'état : " << erreur << endl;
+            return 1;
+        }
+        description = fichierModele;
+    } else if (modele == "echelle" || modele == "rlc") {
+        if (sections <= 0) {
+            cerr << "Modèle d'état : sections doit être positif" << endl;
+            return 1;
+        }
+        if (modele == "echelle") modeleEchelle(sections, p.R, p.C, circuit);
+        else modeleRLC(sections, p.R, p.L, p.C, circuit);
+        description = modele + " de " + to_string(sections) + " cellule(s)";
+    } else if (modele == "circuit") {
+        auto c = creerCircuit(p.circuit, p.R, p.R2, p.C, p.L, p.f, false, p.diode);
+        if (!modeleCircuit(*c, p.R2, circuit, erreur)) {
+            cerr << "Modèle d'état : " << erreur << endl;
+            return 1;
+        }
+        description = string("circuit ") + p.circuit;
+    } else {
+        cerr << "Modèle d'état : modele=circuit|echelle|rlc" << endl;
+        return 1;
+    }
+    auto source = creerSource(p.typeSource, p.amplitude, p.f, p.dutyCycle, p.offset, p.startTime);
+    const double dt = p.tmax / p.npas;
+
+    filesystem::path parent = filesystem::path(sortie).parent_path();
+    if (!parent.empty()) filesystem::create_directories(parent);
+    ofstream fichier(sortie);
+    if (!fichier) {
+        cerr << "Modèle d'état : impossible d'écrire " << sortie << endl;
+        return 1;
+    }
+    fichier << "temps,Vin,Vout\n";
+    EmetteurCsv format;
+    format.fixerPas(dt);
+    EcrivainAsynchrone ecrivain(fichier, format);
+
+    cout << "=== Modèle d'état ===" << endl;
+    cout << "  " << description << " : " << circuit.ordre() << " état(s)"
+         << (circuit.ordre() <= etat::ORDRE_MAX_SPECIALISE ? " (noyau spécialisé)" : "")
+         << ", méthode " << p.methode << ", npas=" << p.npas << ", dt=" << dt << " s" << endl;
+
+    auto debut = chrono::steady_clock::now();
+    const bool ok = simulerEtat(circuit, *source, p.methode, p.npas, dt, ecrivain, erreur);
+    ecrivain.terminer();
+    const double duree = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+    if (!ok) {
+        cerr << "Modèle d'état : " << erreur << endl;
+        return 1;
+    }
+    cout << " Fichier '" << sortie << "' : " << p.npas + 1 << " points, calcul en " << duree << " s ("
+         << (p.npas + 1) / duree / 1e6 << " Mpas/s)" << endl;
+    return 0;
+}
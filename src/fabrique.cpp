@@ -0,0 +1,24 @@
+#include "fabrique.hpp"
+
+using namespace std;
+
+unique_ptr<Circuit> creerCircuit(char type, double R, double R2, double C, double L,
+                                 double f, bool afficher, const ParametresDiode& diode) {
+    switch (type) {
+        case 'B': return make_unique<CircuitB>(R, R2, C, f, afficher, diode);
+        case 'C': return make_unique<CircuitC>(R, C, L, f, afficher);
+        case 'D': return make_unique<CircuitD>(R, C, L, f, afficher);
+        default:  return make_unique<CircuitA>(R, C, f, afficher);
+    }
+}
+
+unique_ptr<Source> creerSource(int typeSource, double A, double f, double dutyCycle,
+                               double offset, double startTime) {
+    switch (typeSource) {
+        case 2: return make_unique<EchelonSource>(A, startTime);
+        case 3: return make_unique<TriangulaireSource>(A, f, offset);
+        case 4: return make_unique<CreneauSource>(A, f, dutyCycle, offset);
+        case 5: return make_unique<RectangulaireSource>(A, f, dutyCycle, offset);
+        default: return make_unique<SinusSource>(A, f, offset);
+    }
+}
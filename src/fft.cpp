@@ -0,0 +1,181 @@
+#include "fft.hpp"
+#include <cmath>
+
+using namespace std;
+using cplx = complex<double>;
+
+// Produit complexe sans le traitement des infinis/NaN de l'opérateur * de
+// std::complex (appel de bibliothèque à chaque multiplication sinon)
+static inline cplx mul(cplx a, cplx b) {
+    return cplx(a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real());
+}
+
+PlanFFT::PlanFFT(size_t n) : n_(n == 0 ? 1 : n), racines_(n_) {
+    for (size_t k = 0; k < n_; ++k) {
+        const double angle = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(n_);
+        racines_[k] = cplx(cos(angle), sin(angle));
+    }
+    // Bases 4 d'abord (papillon le moins coûteux par point), puis 2, 3, 5, ...
+    size_t reste = n_, p = 4;
+    while (reste > 1) {
+        while (reste % p != 0) {
+            p = (p == 4) ? 2 : (p == 2) ? 3 : p + 2;
+            if (p * p > reste) p = reste;
+        }
+        reste /= p;
+        facteurs_.push_back(p);
+        facteurs_.push_back(reste);
+    }
+    if (facteurs_.empty()) {
+        facteurs_.push_back(1);
+        facteurs_.push_back(1);
+    }
+}
+
+void PlanFFT::transformer(const cplx* entree, cplx* sortie) const {
+    etape(sortie, entree, 1, facteurs_.data());
+}
+
+// Sous-transformées de longueur m sur les entrées espacées de pas * p, puis
+// papillons de base p qui les combinent
+void PlanFFT::etape(cplx* sortie, const cplx* entree, size_t pas, const size_t* facteur) const {
+    const size_t p = facteur[0], m = facteur[1];
+    cplx* const fin = sortie + p * m;
+    if (m == 1) {
+        for (cplx* f = sortie; f != fin; ++f) {
+            *f = *entree;
+            entree += pas;
+        }
+    } else {
+        for (cplx* f = sortie; f != fin; f += m) {
+            etape(f, entree, pas * p, facteur + 2);
+            entree += pas;
+        }
+    }
+    switch (p) {
+        case 1: break;
+        case 2: papillon2(sortie, pas, m); break;
+        case 3: papillon3(sortie, pas, m); break;
+        case 4: papillon4(sortie, pas, m); break;
+        case 5: papillon5(sortie, pas, m); break;
+        default: papillonGenerique(sortie, pas, m, p); break;
+    }
+}
+
+void PlanFFT::papillon2(cplx* f, size_t pas, size_t m) const {
+    for (size_t u = 0; u < m; ++u) {
+        const cplx t = mul(f[u + m], racines_[u * pas]);
+        f[u + m] = f[u] - t;
+        f[u] += t;
+    }
+}
+
+void PlanFFT::papillon3(cplx* f, size_t pas, size_t m) const {
+    const double sin3 = racines_[pas * m].imag();      // sin(-2π/3)
+    for (size_t u = 0; u < m; ++u) {
+        const cplx s1 = mul(f[u + m], racines_[u * pas]);
+        const cplx s2 = mul(f[u + 2 * m], racines_[2 * u * pas]);
+        const cplx s3 = s1 + s2;
+        const cplx s0 = (s1 - s2) * sin3;
+        const cplx milieu = f[u] - s3 * 0.5;
+        f[u] += s3;
+        f[u + m] = cplx(milieu.real() - s0.imag(), milieu.imag() + s0.real());
+        f[u + 2 * m] = cplx(milieu.real() + s0.imag(), milieu.imag() - s0.real());
+    }
+}
+
+void PlanFFT::papillon4(cplx* f, size_t pas, size_t m) const {
+    for (size_t u = 0; u < m; ++u) {
+        const cplx s0 = mul(f[u + m], racines_[u * pas]);
+        const cplx s1 = mul(f[u + 2 * m], racines_[2 * u * pas]);
+        const cplx s2 = mul(f[u + 3 * m], racines_[3 * u * pas]);
+        const cplx s5 = f[u] - s1;
+        const cplx a = f[u] + s1;
+        const cplx s3 = s0 + s2, s4 = s0 - s2;
+        f[u] = a + s3;
+        f[u + 2 * m] = a - s3;
+        // -i * s4 et +i * s4 (sens direct)
+        f[u + m] = cplx(s5.real() + s4.imag(), s5.imag() - s4.real());
+        f[u + 3 * m] = cplx(s5.real() - s4.imag(), s5.imag() + s4.real());
+    }
+}
+
+void PlanFFT::papillon5(cplx* f, size_t pas, size_t m) const {
+    const cplx ya = racines_[pas * m], yb = racines_[2 * pas * m];   // exp(-2iπ/5), exp(-4iπ/5)
+    for (size_t u = 0; u < m; ++u) {
+        const cplx s0 = f[u];
+        const cplx s1 = mul(f[u + m], racines_[u * pas]);
+        const cplx s2 = mul(f[u + 2 * m], racines_[2 * u * pas]);
+        const cplx s3 = mul(f[u + 3 * m], racines_[3 * u * pas]);
+        const cplx s4 = mul(f[u + 4 * m], racines_[4 * u * pas]);
+        const cplx s7 = s1 + s4, s10 = s1 - s4, s8 = s2 + s3, s9 = s2 - s3;
+
+        f[u] = s0 + s7 + s8;
+        const cplx s5(s0.real() + s7.real() * ya.real() + s8.real() * yb.real(),
+                      s0.imag() + s7.imag() * ya.real() + s8.imag() * yb.real());
+        const cplx s6(s10.imag() * ya.imag() + s9.imag() * yb.imag(),
+                      -s10.real() * ya.imag() - s9.real() * yb.imag());
+        f[u + m] = s5 - s6;
+        f[u + 4 * m] = s5 + s6;
+
+        const cplx s11(s0.real() + s7.real() * yb.real() + s8.real() * ya.real(),
+                       s0.imag() + s7.imag() * yb.real() + s8.imag() * ya.real());
+        const cplx s12(-s10.imag() * yb.imag() + s9.imag() * ya.imag(),
+                       s10.real() * yb.imag() - s9.real() * ya.imag());
+        f[u + 2 * m] = s11 + s12;
+        f[u + 3 * m] = s11 - s12;
+    }
+}
+
+// Base p quelconque : DFT directe des p points de chaque papillon
+void PlanFFT::papillonGenerique(cplx* f, size_t pas, size_t m, size_t p) const {
+    vector<cplx> points(p);
+    for (size_t u = 0; u < m; ++u) {
+        for (size_t q = 0; q < p; ++q) points[q] = f[u + q * m];
+        for (size_t q1 = 0; q1 < p; ++q1) {
+            const size_t k = u + q1 * m;
+            size_t indice = 0;
+            cplx somme = points[0];
+            for (size_t q = 1; q < p; ++q) {
+                indice += pas * k;
+                indice %= n_;
+                somme += mul(points[q], racines_[indice]);
+            }
+            f[k] = somme;
+        }
+    }
+}
+
+// --- Signal réel ---
+
+PlanFFTReelle::PlanFFTReelle(size_t n)
+    : n_(n == 0 ? 1 : n), plan_(n_ % 2 == 0 ? n_ / 2 : n_), separation_(n_ / 2 + 1) {
+    for (size_t k = 0; k <= n_ / 2; ++k) {
+        const double angle = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(n_);
+        separation_[k] = cplx(cos(angle), sin(angle));
+    }
+}
+
+void PlanFFTReelle::transformer(const double* entree, cplx* sortie) const {
+    if (n_ % 2 != 0) {
+        vector<cplx> z(n_), spectre(n_);
+        for (size_t j = 0; j < n_; ++j) z[j] = entree[j];
+        plan_.transformer(z.data(), spectre.data());
+        for (size_t k = 0; k <= n_ / 2; ++k) sortie[k] = spectre[k];
+        return;
+    }
+    // z[j] = x[2j] + i x[2j+1] : Z = E + i O, E et O spectres des échantillons
+    // pairs et impairs, puis X[k] = E[k] + exp(-2iπ k/n) O[k]
+    const size_t demi = n_ / 2;
+    vector<cplx> z(demi), spectre(demi);
+    for (size_t j = 0; j < demi; ++j) z[j] = cplx(entree[2 * j], entree[2 * j + 1]);
+    plan_.transformer(z.data(), spectre.data());
+    for (size_t k = 0; k <= demi; ++k) {
+        const cplx a = spectre[k % demi];
+        const cplx b = conj(spectre[(demi - k) % demi]);
+        const cplx pair = (a + b) * 0.5;
+        const cplx d = (a - b) * 0.5;
+        const cplx impair(d.imag(), -d.real());         // (a - b) / 2i
+        sortie[k] = pair + mul(separation_[k], impair);
+    }
+}
@@ -0,0 +1,82 @@
+#include "flux_trames.hpp"
+#include "decimateur.hpp"
+#include <iostream>
+
+bool FluxTrames::ouvrir(std::size_t n, const Parametres& parametres) {
+    // Entiers et float64 écrits tels quels : le format annonce du little-endian
+    const std::uint16_t un = 1;
+    if (*reinterpret_cast<const unsigned char*>(&un) != 1) {
+        std::cerr << "Flux binaire : machine big-endian non prise en charge" << std::endl;
+        return false;
+    }
+    std::string e = "BESIM-FLUX\n";
+    e += "version=1\n";
+    e += "n=" + std::to_string(n) + "\n";
+    e += "colonnes=temps:<f8,Vin:<f8,Vout:<f8\n";
+    for (const auto& p : parametres) {
+        e += p.first + "=" + p.second + "\n";
+    }
+    trameTexte("ENTE", e);
+    return true;
+}
+
+void FluxTrames::trame(const char* type, const std::vector<std::pair<const void*, std::size_t>>& morceaux) {
+    std::size_t taille = 0;
+    for (const auto& m : morceaux) taille += m.second;
+    const std::uint32_t taille32 = static_cast<std::uint32_t>(taille);
+    std::fwrite(type, 1, 4, sortie_);
+    std::fwrite(&taille32, sizeof taille32, 1, sortie_);
+    for (const auto& m : morceaux) {
+        std::fwrite(m.first, 1, m.second, sortie_);
+    }
+    // Une trame complète est visible du lecteur dès qu'elle est écrite
+    std::fflush(sortie_);
+    ++trames_;
+    octets_ += 8 + taille;
+}
+
+void FluxTrames::trameColonnes(const char* type, std::uint64_t premier, const std::vector<double>& t,
+                               const std::vector<double>& vin, const std::vector<double>& vout) {
+    const std::uint64_t nombre = t.size();
+    const std::size_t octetsColonne = t.size() * sizeof(double);
+    trame(type, {{&premier, sizeof premier},
+                 {&nombre, sizeof nombre},
+                 {t.data(), octetsColonne},
+                 {vin.data(), octetsColonne},
+                 {vout.data(), octetsColonne}});
+}
+
+void FluxTrames::trameTexte(const char* type, const std::string& texte) {
+    trame(type, {{texte.data(), texte.size()}});
+}
+
+void FluxTrames::envoyerBloc() {
+    if (t_.empty()) return;
+    trameColonnes("ECHA", premier_, t_, vin_, vout_);
+    premier_ += t_.size();
+    t_.clear();
+    vin_.clear();
+    vout_.clear();
+}
+
+void FluxTrames::envoyerTrace(const Decimateur& trace) {
+    std::vector<double> t, vin, vout;
+    t.reserve(trace.points().size());
+    vin.reserve(trace.points().size());
+    vout.reserve(trace.points().size());
+    for (const auto& p : trace.points()) {
+        t.push_back(p.t);
+        vin.push_back(p.vin);
+        vout.push_back(p.vout);
+    }
+    trameColonnes("TRAC", 0, t, vin, vout);
+}
+
+void FluxTrames::terminer(const Parametres& resume) {
+    envoyerBloc();
+    std::string r = "echantillons=" + std::to_string(premier_) + "\n";
+    for (const auto& p : resume) {
+        r += p.first + "=" + p.second + "\n";
+    }
+    trameTexte("RESU", r);
+}
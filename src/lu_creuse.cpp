@@ -0,0 +1,262 @@
+#include "lu_creuse.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+using namespace std;
+
+// Pivot diagonal gardé s'il vaut au moins ce rapport du plus grand candidat
+// (les pivots diagonaux préservent l'ordre choisi par analyser())
+static const double SEUIL_DIAGONALE = 0.1;
+// Refactorisation refusée si un pivot tombe sous ce rapport de sa colonne
+static const double SEUIL_REFACTORISATION = 1e-3;
+
+void MatriceCreuse::construireMotif(int taille, vector<pair<int, int>> entrees) {
+    n = taille;
+    sort(entrees.begin(), entrees.end(), [](const pair<int, int>& a, const pair<int, int>& b) {
+        return a.second != b.second ? a.second < b.second : a.first < b.first;
+    });
+    entrees.erase(unique(entrees.begin(), entrees.end()), entrees.end());
+    debut.assign(n + 1, 0);
+    lignes.resize(entrees.size());
+    for (size_t p = 0; p < entrees.size(); ++p) {
+        lignes[p] = entrees[p].first;
+        ++debut[entrees[p].second + 1];
+    }
+    for (int j = 0; j < n; ++j) debut[j + 1] += debut[j];
+    valeurs.assign(entrees.size(), 0.0);
+}
+
+int MatriceCreuse::position(int i, int j) const {
+    auto premier = lignes.begin() + debut[j], dernier = lignes.begin() + debut[j + 1];
+    auto p = lower_bound(premier, dernier, i);
+    return (p != dernier && *p == i) ? static_cast<int>(p - lignes.begin()) : -1;
+}
+
+// --- Ordre des colonnes ---
+
+// Degré minimum sur le graphe de A + Aᵀ : à chaque étape, le nœud de plus
+// petit degré est éliminé et ses voisins forment une clique (le remplissage
+// qu'il crée). Graphe d'élimination explicite, listes d'adjacence triées.
+void LUCreuse::analyser(const MatriceCreuse& a) {
+    n_ = a.n;
+    vector<vector<int>> voisins(n_);
+    for (int j = 0; j < n_; ++j) {
+        for (int p = a.debut[j]; p < a.debut[j + 1]; ++p) {
+            const int i = a.lignes[p];
+            if (i == j) continue;
+            voisins[i].push_back(j);
+            voisins[j].push_back(i);
+        }
+    }
+    using Entree = pair<size_t, int>;
+    priority_queue<Entree, vector<Entree>, greater<Entree>> file;
+    for (int i = 0; i < n_; ++i) {
+        sort(voisins[i].begin(), voisins[i].end());
+        voisins[i].erase(unique(voisins[i].begin(), voisins[i].end()), voisins[i].end());
+        file.push({voisins[i].size(), i});
+    }
+
+    q_.clear();
+    vector<char> elimine(n_, 0);
+    vector<int> fusion;
+    while (!file.empty()) {
+        const auto [degre, v] = file.top();
+        file.pop();
+        if (elimine[v] || degre != voisins[v].size()) continue;   // entrée périmée
+        elimine[v] = 1;
+        q_.push_back(v);
+        const vector<int> clique = move(voisins[v]);
+        voisins[v].clear();
+        for (int u : clique) {
+            fusion.clear();
+            set_union(voisins[u].begin(), voisins[u].end(), clique.begin(), clique.end(),
+                      back_inserter(fusion));
+            fusion.erase(remove_if(fusion.begin(), fusion.end(), [u, v](int w) { return w == u || w == v; }),
+                         fusion.end());
+            voisins[u].swap(fusion);
+            file.push({voisins[u].size(), u});
+        }
+    }
+    factorisee_ = false;
+}
+
+// --- Factorisation ---
+
+bool LUCreuse::factoriser(const MatriceCreuse& a) {
+    if (static_cast<int>(q_.size()) != a.n) analyser(a);
+    const int n = n_;
+    factorisee_ = false;
+    lp_.assign(n + 1, 0);
+    up_.assign(n + 1, 0);
+    li_.clear();
+    lx_.clear();
+    ui_.clear();
+    ux_.clear();
+    li_.reserve(2 * a.nonNuls() + n);
+    lx_.reserve(2 * a.nonNuls() + n);
+    ui_.reserve(2 * a.nonNuls() + n);
+    ux_.reserve(2 * a.nonNuls() + n);
+    pinv_.assign(n, -1);
+
+    vector<double> x(n, 0.0);
+    vector<int> pile(n), suivant(n), atteints(n), marque(n, -1);
+    for (int k = 0; k < n; ++k) {
+        lp_[k] = static_cast<int>(li_.size());
+        up_[k] = static_cast<int>(ui_.size());
+        const int col = q_[k];
+
+        // Lignes atteintes depuis A(:, col) par les colonnes déjà calculées
+        // de L, en ordre topologique (parcours en profondeur) : motif de la
+        // solution de L x = A(:, col)
+        int haut = n;
+        for (int p = a.debut[col]; p < a.debut[col + 1]; ++p) {
+            int i0 = a.lignes[p];
+            if (marque[i0] == k) continue;
+            int tete = 0;
+            pile[0] = i0;
+            while (tete >= 0) {
+                const int j = pile[tete];
+                const int jp = pinv_[j];
+                if (marque[j] != k) {
+                    marque[j] = k;
+                    suivant[tete] = jp < 0 ? 0 : lp_[jp];
+                }
+                const int fin = jp < 0 ? 0 : lp_[jp + 1];
+                bool termine = true;
+                for (int q = suivant[tete]; q < fin; ++q) {
+                    const int i = li_[q];
+                    if (marque[i] == k) continue;
+                    suivant[tete] = q;
+                    pile[++tete] = i;
+                    termine = false;
+                    break;
+                }
+                if (termine) {
+                    --tete;
+                    atteints[--haut] = j;
+                }
+            }
+        }
+
+        // Résolution triangulaire creuse
+        for (int p = haut; p < n; ++p) x[atteints[p]] = 0.0;
+        for (int p = a.debut[col]; p < a.debut[col + 1]; ++p) x[a.lignes[p]] = a.valeurs[p];
+        for (int p = haut; p < n; ++p) {
+            const int j = atteints[p];
+            const int jp = pinv_[j];
+            if (jp < 0) continue;
+            const double xj = x[j];
+            for (int q = lp_[jp] + 1; q < lp_[jp + 1]; ++q) x[li_[q]] -= lx_[q] * xj;
+        }
+
+        // Pivot : plus grand candidat, ou la diagonale si elle est assez grande
+        int ipiv = -1;
+        double plusGrand = -1.0;
+        for (int p = haut; p < n; ++p) {
+            const int i = atteints[p];
+            if (pinv_[i] < 0) {
+                const double v = fabs(x[i]);
+                if (v > plusGrand) {
+                    plusGrand = v;
+                    ipiv = i;
+                }
+            } else {
+                ui_.push_back(pinv_[i]);
+                ux_.push_back(x[i]);
+            }
+        }
+        if (ipiv < 0 || !(plusGrand > 0.0) || !isfinite(plusGrand)) return false;   // singulière
+        if (pinv_[col] < 0 && marque[col] == k && fabs(x[col]) >= SEUIL_DIAGONALE * plusGrand) ipiv = col;
+
+        const double pivot = x[ipiv];
+        ui_.push_back(k);
+        ux_.push_back(pivot);
+        pinv_[ipiv] = k;
+        li_.push_back(ipiv);
+        lx_.push_back(1.0);
+        for (int p = haut; p < n; ++p) {
+            const int i = atteints[p];
+            if (pinv_[i] < 0) {
+                li_.push_back(i);
+                lx_.push_back(x[i] / pivot);
+            }
+            x[i] = 0.0;
+        }
+    }
+    lp_[n] = static_cast<int>(li_.size());
+    up_[n] = static_cast<int>(ui_.size());
+
+    // Lignes de L en numérotation des pivots ; lignes de U croissantes (hors
+    // diagonale) : ordre de calcul de refactoriser()
+    for (int& i : li_) i = pinv_[i];
+    vector<pair<int, double>> colonne;
+    for (int k = 0; k < n; ++k) {
+        const int debut = up_[k], fin = up_[k + 1] - 1;
+        colonne.clear();
+        for (int p = debut; p < fin; ++p) colonne.push_back({ui_[p], ux_[p]});
+        sort(colonne.begin(), colonne.end(),
+             [](const pair<int, double>& u, const pair<int, double>& v) { return u.first < v.first; });
+        for (int p = debut; p < fin; ++p) {
+            ui_[p] = colonne[p - debut].first;
+            ux_[p] = colonne[p - debut].second;
+        }
+    }
+    travail_.assign(n, 0.0);
+    factorisee_ = true;
+    return true;
+}
+
+bool LUCreuse::refactoriser(const MatriceCreuse& a) {
+    if (!factorisee_ || a.n != n_) return factoriser(a);
+    vector<double>& x = travail_;
+    for (int k = 0; k < n_; ++k) {
+        const int col = q_[k];
+        for (int p = a.debut[col]; p < a.debut[col + 1]; ++p) x[pinv_[a.lignes[p]]] = a.valeurs[p];
+
+        // U(:, k) dans l'ordre des pivots, chaque valeur finale retranchée
+        // des lignes suivantes par la colonne correspondante de L
+        const int finU = up_[k + 1] - 1;
+        for (int p = up_[k]; p < finU; ++p) {
+            const int j = ui_[p];
+            const double ujk = x[j];
+            x[j] = 0.0;
+            ux_[p] = ujk;
+            for (int q = lp_[j] + 1; q < lp_[j + 1]; ++q) x[li_[q]] -= lx_[q] * ujk;
+        }
+        const double pivot = x[k];
+        x[k] = 0.0;
+        ux_[finU] = pivot;
+
+        double plusGrand = 0.0;
+        for (int q = lp_[k] + 1; q < lp_[k + 1]; ++q) plusGrand = max(plusGrand, fabs(x[li_[q]]));
+        if (!(fabs(pivot) > 0.0) || !isfinite(pivot) || fabs(pivot) < SEUIL_REFACTORISATION * plusGrand) {
+            for (int q = lp_[k] + 1; q < lp_[k + 1]; ++q) x[li_[q]] = 0.0;
+            factorisee_ = false;
+            return false;
+        }
+        for (int q = lp_[k] + 1; q < lp_[k + 1]; ++q) {
+            lx_[q] = x[li_[q]] / pivot;
+            x[li_[q]] = 0.0;
+        }
+    }
+    return true;
+}
+
+void LUCreuse::resoudre(double* x) const {
+    vector<double>& y = solution_;
+    y.resize(n_);
+    for (int i = 0; i < n_; ++i) y[pinv_[i]] = x[i];
+    for (int j = 0; j < n_; ++j) {
+        const double yj = y[j];
+        for (int q = lp_[j] + 1; q < lp_[j + 1]; ++q) y[li_[q]] -= lx_[q] * yj;
+    }
+    for (int j = n_ - 1; j >= 0; --j) {
+        const int diagonale = up_[j + 1] - 1;
+        const double yj = y[j] / ux_[diagonale];
+        y[j] = yj;
+        for (int p = up_[j]; p < diagonale; ++p) y[ui_[p]] -= ux_[p] * yj;
+    }
+    for (int k = 0; k < n_; ++k) x[q_[k]] = y[k];
+}
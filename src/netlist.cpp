@@ -0,0 +1,629 @@
+#include "netlist.hpp"
+#include "besim.hpp"
+#include "ecrivain.hpp"
+#include "emetteur_csv.hpp"
+#include "fabrique.hpp"
+#include "solver_static.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+using namespace std;
+
+// Itérations de Newton par pas au-delà desquelles on abandonne
+static const int NEWTON_MAX = 100;
+// Convergence : |Δx| <= RELTOL * |x| + ABSTOL sur chaque inconnue
+static const double RELTOL = 1e-9;
+static const double ABSTOL = 1e-12;
+// Conductance en parallèle de chaque diode (évite une ligne nulle en blocage)
+static const double GMIN = 1e-12;
+
+static string minuscules(string s) {
+    for (char& c : s) c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+    return s;
+}
+
+// {nom} remplacé par la valeur du paramètre
+static bool substituer(const string& texte, const map<string, string>& parametres, string& valeur,
+                       string& erreur) {
+    if (texte.size() > 2 && texte.front() == '{' && texte.back() == '}') {
+        auto p = parametres.find(texte.substr(1, texte.size() - 2));
+        if (p == parametres.end()) {
+            erreur = "paramètre inconnu : " + texte;
+            return false;
+        }
+        valeur = p->second;
+    } else {
+        valeur = texte;
+    }
+    return true;
+}
+
+// Nombre avec suffixe SPICE (1k, 4.7u, 2meg) ; les lettres qui suivent le
+// suffixe sont une unité, ignorée (10uF, 5V)
+static bool lireValeur(const string& texte, const map<string, string>& parametres, double& v,
+                       string& erreur) {
+    string s;
+    if (!substituer(texte, parametres, s, erreur)) return false;
+    const char* debut = s.c_str();
+    char* fin = nullptr;
+    v = strtod(debut, &fin);
+    if (fin == debut || !isfinite(v)) {
+        erreur = "valeur invalide : " + texte;
+        return false;
+    }
+    const string suffixe = minuscules(fin);
+    if (suffixe.rfind("meg", 0) == 0) {
+        v *= 1e6;
+    } else if (!suffixe.empty()) {
+        switch (suffixe[0]) {
+            case 't': v *= 1e12; break;
+            case 'g': v *= 1e9; break;
+            case 'k': v *= 1e3; break;
+            case 'm': v *= 1e-3; break;
+            case 'u': v *= 1e-6; break;
+            case 'n': v *= 1e-9; break;
+            case 'p': v *= 1e-12; break;
+            case 'f': v *= 1e-15; break;
+            default:
+                if (!isalpha(static_cast<unsigned char>(suffixe[0]))) {
+                    erreur = "valeur invalide : " + texte;
+                    return false;
+                }
+        }
+    }
+    return true;
+}
+
+bool lireNetlist(istream& entree, const string& nom, const map<string, string>& parametres,
+                 Netlist& netlist, string& erreur) {
+    netlist = Netlist();
+    vector<vector<string>> lignes;
+    string ligne;
+    while (getline(entree, ligne)) {
+        ligne = ligne.substr(0, ligne.find(';'));
+        istringstream mots(ligne);
+        vector<string> jetons;
+        string mot;
+        while (mots >> mot) jetons.push_back(mot);
+        if (jetons.empty() || jetons[0][0] == '*') jetons.clear();
+        lignes.push_back(jetons);
+    }
+
+    // .param d'abord : un paramètre peut servir avant sa déclaration ;
+    // ceux de la ligne de commande l'emportent
+    map<string, string> valeurs;
+    for (const auto& jetons : lignes) {
+        if (jetons.empty() || minuscules(jetons[0]) != ".param") continue;
+        for (size_t k = 1; k < jetons.size(); ++k) {
+            size_t eg = jetons[k].find('=');
+            if (eg != string::npos) valeurs[jetons[k].substr(0, eg)] = jetons[k].substr(eg + 1);
+        }
+    }
+    for (const auto& p : parametres) valeurs[p.first] = p.second;
+
+    map<string, int> indices;
+    auto noeud = [&](const string& texte) {
+        const string cle = minuscules(texte);
+        if (cle == "0" || cle == "gnd") return -1;
+        auto p = indices.find(cle);
+        if (p != indices.end()) return p->second;
+        const int i = static_cast<int>(netlist.noeuds.size());
+        indices[cle] = i;
+        netlist.noeuds.push_back(texte);
+        return i;
+    };
+
+    for (size_t numero = 0; numero < lignes.size(); ++numero) {
+        const auto& jetons = lignes[numero];
+        if (jetons.empty()) continue;
+        const string position = nom + ":" + to_string(numero + 1) + " : ";
+        const string tete = minuscules(jetons[0]);
+        if (tete == ".end" || tete == ".fin") break;
+        if (tete == ".param") continue;
+        if (tete == ".tran") {
+            if (jetons.size() < 3 || !lireValeur(jetons[1], valeurs, netlist.pas, erreur) ||
+                !lireValeur(jetons[2], valeurs, netlist.fin, erreur) || !(netlist.pas > 0.0) ||
+                !(netlist.fin > 0.0)) {
+                erreur = position + ".tran pas fin (valeurs positives)";
+                return false;
+            }
+            continue;
+        }
+        if (tete == ".sortie") {
+            if (jetons.size() < 2) {
+                erreur = position + ".sortie nœud";
+                return false;
+            }
+            netlist.sortie = jetons[1];
+            continue;
+        }
+        if (tete[0] == '.') {
+            erreur = position + "directive inconnue : " + jetons[0];
+            return false;
+        }
+
+        ElementNetlist e;
+        e.type = static_cast<char>(toupper(static_cast<unsigned char>(jetons[0][0])));
+        e.nom = jetons[0];
+        if (string("RCLDV").find(e.type) == string::npos) {
+            erreur = position + "élément inconnu : " + jetons[0] + " (R, C, L, D ou V)";
+            return false;
+        }
+        const size_t minimum = (e.type == 'D') ? 3 : 4;
+        if (jetons.size() < minimum) {
+            erreur = position + "nœuds ou valeur manquants pour " + e.nom;
+            return false;
+        }
+        e.a = noeud(jetons[1]);
+        e.b = noeud(jetons[2]);
+
+        // Options cle=valeur en fin de ligne (D, V)
+        map<string, double> options;
+        const size_t premiereOption = (e.type == 'D') ? 3 : 4;
+        if (e.type == 'D' || e.type == 'V') {
+            for (size_t k = premiereOption; k < jetons.size(); ++k) {
+                size_t eg = jetons[k].find('=');
+                double v;
+                if (eg == string::npos || !lireValeur(jetons[k].substr(eg + 1), valeurs, v, erreur)) {
+                    erreur = position + "option invalide : " + jetons[k];
+                    return false;
+                }
+                options[minuscules(jetons[k].substr(0, eg))] = v;
+            }
+        }
+        auto option = [&options](const string& cle, double defaut) {
+            auto p = options.find(cle);
+            return p == options.end() ? defaut : p->second;
+        };
+
+        if (e.type == 'R' || e.type == 'C' || e.type == 'L') {
+            if (!lireValeur(jetons[3], valeurs, e.valeur, erreur) || !(e.valeur > 0.0)) {
+                erreur = position + "valeur positive attendue pour " + e.nom;
+                return false;
+            }
+        } else if (e.type == 'D') {
+            e.valeur = option("is", 1e-14);
+            e.n = option("n", 1.0);
+            e.vt = option("vt", 0.025852);
+            if (!(e.valeur > 0.0) || !(e.n > 0.0) || !(e.vt > 0.0)) {
+                erreur = position + "Is, N et Vt doivent être positifs (" + e.nom + ")";
+                return false;
+            }
+        } else {
+            string type;
+            if (!substituer(jetons[3], valeurs, type, erreur)) {
+                erreur = position + erreur;
+                return false;
+            }
+            static const map<string, int> types = {
+                {"sinus", 1}, {"echelon", 2}, {"triangle", 3}, {"creneau", 4}, {"rectangle", 5},
+                {"1", 1}, {"2", 2}, {"3", 3}, {"4", 4}, {"5", 5}};
+            auto t = types.find(minuscules(type));
+            if (t == types.end()) {
+                erreur = position + "type de source inconnu : " + type;
+                return false;
+            }
+            // Mêmes contrôles que les autres modes (f positive et finie, duty
+            // dans [0, 1], valeurs finies) ; circuit et méthode par défaut
+            ParametresSimulation p;
+            p.typeSource = t->second;
+            p.amplitude = option("a", 5.0);
+            p.f = option("f", 50.0);
+            p.dutyCycle = option("duty", 0.5);
+            p.offset = option("offset", 0.0);
+            p.startTime = option("t0", 0.0);
+            if (!verifierParametres(p, erreur)) {
+                erreur = position + erreur;
+                return false;
+            }
+            e.source = creerSource(p.typeSource, p.amplitude, p.f, p.dutyCycle, p.offset, p.startTime);
+        }
+        netlist.elements.push_back(e);
+    }
+    return true;
+}
+
+// --- Système MNA ---
+
+bool CircuitMNA::construire(Netlist netlist, string& erreur) {
+    netlist_ = move(netlist);
+    const int noeuds = static_cast<int>(netlist_.noeuds.size());
+    n_ = noeuds;
+    lineaire_ = true;
+    bool source = false;
+    for (auto& e : netlist_.elements) {
+        if (e.type == 'V' || e.type == 'C' || e.type == 'L') e.branche = n_++;
+        if (e.type == 'D') lineaire_ = false;
+        if (e.type == 'V') source = true;
+    }
+    if (!source) {
+        erreur = "aucune source de tension (Vin)";
+        return false;
+    }
+    sortie_ = -2;
+    for (int i = 0; i < noeuds; ++i) {
+        if (minuscules(netlist_.noeuds[i]) == minuscules(netlist_.sortie)) sortie_ = i;
+    }
+    if (minuscules(netlist_.sortie) == "0" || minuscules(netlist_.sortie) == "gnd") sortie_ = -1;
+    if (sortie_ == -2) {
+        erreur = "nœud de sortie inconnu : " + netlist_.sortie;
+        return false;
+    }
+
+    // Motif : diagonale complète, puis les entrées de chaque élément
+    vector<pair<int, int>> entrees;
+    for (int i = 0; i < n_; ++i) entrees.push_back({i, i});
+    auto paire = [&entrees](int i, int j) {
+        if (i >= 0 && j >= 0) entrees.push_back({i, j});
+    };
+    for (const auto& e : netlist_.elements) {
+        if (e.type == 'R' || e.type == 'D') {
+            paire(e.a, e.a); paire(e.a, e.b); paire(e.b, e.a); paire(e.b, e.b);
+        } else {
+            paire(e.a, e.branche); paire(e.b, e.branche);
+            paire(e.branche, e.a); paire(e.branche, e.b);
+        }
+    }
+    a_.construireMotif(n_, move(entrees));
+
+    auto position = [this](int i, int j) { return (i >= 0 && j >= 0) ? a_.position(i, j) : -1; };
+    positions_.assign(netlist_.elements.size(), Positions());
+    for (size_t k = 0; k < netlist_.elements.size(); ++k) {
+        const auto& e = netlist_.elements[k];
+        Positions& p = positions_[k];
+        if (e.type == 'R' || e.type == 'D') {
+            p.aa = position(e.a, e.a); p.ab = position(e.a, e.b);
+            p.ba = position(e.b, e.a); p.bb = position(e.b, e.b);
+        } else {
+            p.ak = position(e.a, e.branche); p.bk = position(e.b, e.branche);
+            p.ka = position(e.branche, e.a); p.kb = position(e.branche, e.b);
+            p.kk = position(e.branche, e.branche);
+        }
+    }
+    luInitial_ = LUCreuse();
+    luPas_ = LUCreuse();
+    return true;
+}
+
+double CircuitMNA::tensionElement(const vector<double>& x, const ElementNetlist& e) const {
+    return (e.a >= 0 ? x[e.a] : 0.0) - (e.b >= 0 ? x[e.b] : 0.0);
+}
+
+// Valeur vue depuis l'intervalle régulier courant (comme SourceSegment) : un
+// instant placé sur un front prend la valeur du côté courant
+double CircuitMNA::valeurSource(size_t element, double t) const {
+    const Source& s = *netlist_.elements[element].source;
+    if (s.estContinue()) return s.ve(t);
+    const double debut = debutSeg_[element] + marge_, fin = finSeg_[element] - marge_;
+    return s.ve(t < debut ? debut : (t > fin ? fin : t));
+}
+
+// Initial : condensateurs à tension imposée, inductances à courant imposé
+// (courants et tensions cohérents au départ, pour les trapèzes). Pas :
+// modèles compagnons, alpha = 1/h (Euler implicite) ou 2/h (trapèzes)
+//   C : i - alpha C v = -alpha C v0 [- i0]
+//   L : v - alpha L i = -alpha L i0 [- v0]
+// Diodes linéarisées autour de tension_ : conductance g et courant i - g v.
+void CircuitMNA::assembler(Mode mode, double alpha, double t, bool trapezes, bool matrice) {
+    if (matrice) fill(a_.valeurs.begin(), a_.valeurs.end(), 0.0);
+    fill(b_.begin(), b_.end(), 0.0);
+    auto ajouter = [this, matrice](int p, double v) {
+        if (matrice && p >= 0) a_.valeurs[p] += v;
+    };
+    auto injecter = [this](int i, double v) {
+        if (i >= 0) b_[i] += v;
+    };
+    for (size_t k = 0; k < netlist_.elements.size(); ++k) {
+        const ElementNetlist& e = netlist_.elements[k];
+        const Positions& p = positions_[k];
+        switch (e.type) {
+            case 'R': {
+                const double g = 1.0 / e.valeur;
+                ajouter(p.aa, g); ajouter(p.ab, -g); ajouter(p.ba, -g); ajouter(p.bb, g);
+                break;
+            }
+            case 'D': {
+                const double nvt = e.n * e.vt, v = tension_[k];
+                const double ex = exp(min(v / nvt, 100.0));
+                const double id = e.valeur * (ex - 1.0), gd = e.valeur * ex / nvt;
+                const double g = gd + GMIN;
+                ajouter(p.aa, g); ajouter(p.ab, -g); ajouter(p.ba, -g); ajouter(p.bb, g);
+                injecter(e.a, -(id - gd * v));
+                injecter(e.b, id - gd * v);
+                break;
+            }
+            case 'V':
+                ajouter(p.ak, 1.0); ajouter(p.bk, -1.0); ajouter(p.ka, 1.0); ajouter(p.kb, -1.0);
+                b_[e.branche] = valeurSource(k, t);
+                break;
+            case 'C':
+                ajouter(p.ak, 1.0); ajouter(p.bk, -1.0);
+                if (mode == Mode::Initial) {
+                    ajouter(p.ka, 1.0); ajouter(p.kb, -1.0);
+                    b_[e.branche] = tension_[k];
+                } else {
+                    const double ac = alpha * e.valeur;
+                    ajouter(p.kk, 1.0); ajouter(p.ka, -ac); ajouter(p.kb, ac);
+                    b_[e.branche] = -ac * tension_[k] - (trapezes ? courant_[k] : 0.0);
+                }
+                break;
+            case 'L':
+                ajouter(p.ak, 1.0); ajouter(p.bk, -1.0);
+                if (mode == Mode::Initial) {
+                    ajouter(p.kk, 1.0);
+                    b_[e.branche] = courant_[k];
+                } else {
+                    const double al = alpha * e.valeur;
+                    ajouter(p.ka, 1.0); ajouter(p.kb, -1.0); ajouter(p.kk, -al);
+                    b_[e.branche] = -al * courant_[k] - (trapezes ? tension_[k] : 0.0);
+                }
+                break;
+        }
+    }
+}
+
+bool CircuitMNA::resoudre(Mode mode, double h, double t, bool trapezes, string& erreur) {
+    const double alpha = (mode == Mode::Pas) ? (trapezes ? 2.0 : 1.0) / h : 0.0;
+    LUCreuse& lu = (mode == Mode::Initial) ? luInitial_ : luPas_;
+    for (int iteration = 0; iteration < NEWTON_MAX; ++iteration) {
+        // Circuit linéaire : la matrice ne dépend que du mode et du pas
+        const bool memeMatrice = lineaire_ && lu.factorisee() &&
+                                 (mode == Mode::Initial ? initialFactorise_ : alpha == alphaFactorise_);
+        assembler(mode, alpha, t, trapezes, !memeMatrice);
+        if (!memeMatrice) {
+            if (lu.factorisee() && lu.refactoriser(a_)) {
+                ++refactorisations;
+            } else if (lu.factoriser(a_)) {
+                ++factorisations;
+            } else {
+                ostringstream os;
+                os << "matrice singulière à t = " << t << " (nœud flottant, boucle de sources ?)";
+                erreur = os.str();
+                return false;
+            }
+            if (mode == Mode::Initial) initialFactorise_ = true;
+            else alphaFactorise_ = alpha;
+        }
+        lu.resoudre(b_.data());
+        ++resolutions;
+        if (lineaire_) {
+            x_.swap(b_);
+            return true;
+        }
+
+        bool converge = true;
+        for (int i = 0; i < n_ && converge; ++i) {
+            converge = fabs(b_[i] - x_[i]) <= RELTOL * max(fabs(b_[i]), fabs(x_[i])) + ABSTOL;
+        }
+        for (size_t k = 0; k < netlist_.elements.size(); ++k) {
+            const ElementNetlist& e = netlist_.elements[k];
+            if (e.type != 'D') continue;
+            const double v = tensionElement(b_, e);
+            const double limitee = limiterJonction(v, tension_[k], e.n * e.vt, e.valeur);
+            if (limitee != v) converge = false;
+            tension_[k] = limitee;
+        }
+        x_.swap(b_);
+        if (converge) return true;
+    }
+    ostringstream os;
+    os << "Newton sans convergence à t = " << t;
+    erreur = os.str();
+    return false;
+}
+
+void CircuitMNA::mettreAJourHistorique() {
+    for (size_t k = 0; k < netlist_.elements.size(); ++k) {
+        const ElementNetlist& e = netlist_.elements[k];
+        if (e.type == 'C' || e.type == 'L' || e.type == 'D') tension_[k] = tensionElement(x_, e);
+        if (e.type == 'C' || e.type == 'L') courant_[k] = x_[e.branche];
+    }
+}
+
+bool CircuitMNA::simuler(int methode, int npas, double dt,
+                         const function<void(double, double, double)>& sortie, string& erreur) {
+    if (methode != 6 && methode != 7) {
+        erreur = "méthode 6 (Euler implicite) ou 7 (trapèzes) requise";
+        return false;
+    }
+    if (npas <= 0 || !(dt > 0.0)) {
+        erreur = "npas et dt doivent être positifs";
+        return false;
+    }
+    const bool trapezes = methode == 7;
+    const size_t nElements = netlist_.elements.size();
+    x_.assign(n_, 0.0);
+    b_.assign(n_, 0.0);
+    tension_.assign(nElements, 0.0);
+    courant_.assign(nElements, 0.0);
+    factorisations = refactorisations = resolutions = 0;
+    initialFactorise_ = false;
+    alphaFactorise_ = 0.0;
+
+    // Intervalles réguliers des sources, comme statique::boucle
+    marge_ = 1e-7 * dt;
+    debutSeg_.assign(nElements, -numeric_limits<double>::infinity());
+    finSeg_.assign(nElements, numeric_limits<double>::infinity());
+    vector<size_t> sources;
+    for (size_t k = 0; k < nElements; ++k) {
+        if (netlist_.elements[k].type != 'V') continue;
+        sources.push_back(k);
+        finSeg_[k] = netlist_.elements[k].source->prochaineDiscontinuite(0.0);
+    }
+    const size_t entree = sources.front();
+
+    // Trapèzes : le premier pas utilise les courants des condensateurs et les
+    // tensions des inductances à t = 0, calculés depuis l'état nul. Si ce
+    // calcul est impossible (condensateur en parallèle sur une source,
+    // inductance seule en série avec une source de courant nul...), le pas
+    // qui suit t = 0 et chaque front est fait en Euler implicite, comme SPICE
+    // aux points de rupture
+    bool initialPossible = trapezes, historique = false;
+    auto initialiser = [&](double tc) {
+        if (!initialPossible) return true;
+        if (!resoudre(Mode::Initial, 0.0, tc, trapezes, erreur)) {
+            if (!lineaire_ && luInitial_.factorisee()) return false;   // Newton
+            initialPossible = false;
+            return true;
+        }
+        mettreAJourHistorique();
+        historique = true;
+        return true;
+    };
+    if (!initialiser(0.0)) return false;
+
+    for (int i = 0; i <= npas; ++i) {
+        const double t = i * dt, tFin = t + dt;
+        const double vin = valeurSource(entree, t);
+        double tc = t;
+        for (int sousPas = 1;; ++sousPas) {
+            // Au-delà de statique::SOUS_PAS_MAX fronts dans le pas : fin du
+            // pas d'un seul tenant, intervalles recalés après le pas
+            const bool force = sousPas > statique::SOUS_PAS_MAX;
+            double prochain = numeric_limits<double>::infinity();
+            for (size_t k : sources) prochain = min(prochain, finSeg_[k]);
+            if (force) prochain = numeric_limits<double>::infinity();
+            const bool front = prochain < tFin + marge_;
+            const double fin = (prochain < tFin - marge_) ? prochain : tFin;
+            if (fin - tc > marge_) {
+                // Pas entier : dt exactement (fin - tc porte l'arrondi de t + dt)
+                const double h = (tc == t && fin == tFin) ? dt : fin - tc;
+                if (!resoudre(Mode::Pas, h, fin, trapezes && historique, erreur)) return false;
+                mettreAJourHistorique();
+                historique = trapezes;
+            }
+            if (force) {
+                for (size_t k : sources) {
+                    if (finSeg_[k] <= tFin + marge_) {
+                        debutSeg_[k] = tFin;
+                        finSeg_[k] = netlist_.elements[k].source->prochaineDiscontinuite(tFin);
+                    }
+                }
+                historique = false;
+                if (!initialiser(tFin)) return false;
+                break;
+            }
+            if (!front) break;
+            // Front : nouvel intervalle des sources concernées ; aux trapèzes,
+            // courants et tensions recalculés avec la valeur d'après le front
+            tc = fin;
+            for (size_t k : sources) {
+                if (finSeg_[k] <= fin + marge_) {
+                    debutSeg_[k] = finSeg_[k];
+                    finSeg_[k] = netlist_.elements[k].source->prochaineDiscontinuite(finSeg_[k]);
+                }
+            }
+            historique = false;
+            if (!initialiser(tc)) return false;
+            if (tFin - tc <= marge_) break;
+        }
+        sortie(t, vin, sortie_ >= 0 ? x_[sortie_] : 0.0);
+    }
+    return true;
+}
+
+// --- Mode netlist ---
+
+int lancerNetlist(int argc, char** argv) {
+    if (argc < 1 || string(argv[0]).find('=') != string::npos) {
+        cerr << "Netlist : be-sim --netlist fichier.cir [cle=valeur ...]" << endl;
+        return 1;
+    }
+    const string chemin = argv[0];
+    ParametresSimulation p;
+    p.methode = 7;
+    bool npasDonne = false, tmaxDonne = false;
+    string noeud, sortie;
+    map<string, string> parametres;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        size_t eg = arg.find('=');
+        if (eg == string::npos) {
+            cerr << "Netlist : argument sans '=' : " << arg << endl;
+            return 1;
+        }
+        string cle = arg.substr(0, eg), valeur = arg.substr(eg + 1);
+        if (cle == "methode") p.methode = atoi(valeur.c_str());
+        else if (cle == "npas") { p.npas = atoi(valeur.c_str()); npasDonne = true; }
+        else if (cle == "tmax") { p.tmax = atof(valeur.c_str()); tmaxDonne = true; }
+        else if (cle == "noeud") noeud = valeur;
+        else if (cle == "sortie") sortie = valeur;
+        else parametres[cle] = valeur;
+    }
+
+    ifstream fichierNetlist(chemin);
+    if (!fichierNetlist) {
+        cerr << "Netlist : impossible de lire " << chemin << endl;
+        return 1;
+    }
+    Netlist netlist;
+    string erreur;
+    if (!lireNetlist(fichierNetlist, chemin, parametres, netlist, erreur)) {
+        cerr << "Netlist : " << erreur << endl;
+        return 1;
+    }
+    if (!noeud.empty()) netlist.sortie = noeud;
+    if (netlist.fin > 0.0) {
+        if (!tmaxDonne) p.tmax = netlist.fin;
+        if (!npasDonne) {
+            const double n = nearbyint(netlist.fin / netlist.pas);
+            p.npas = (n >= 1.0 && n <= INT_MAX) ? static_cast<int>(n) : 0;
+        }
+    }
+    if (p.npas <= 0 || !(p.tmax > 0.0)) {
+        cerr << "Netlist : npas et tmax doivent être positifs" << endl;
+        return 1;
+    }
+    const double dt = p.tmax / p.npas;
+
+    CircuitMNA circuit;
+    if (!circuit.construire(move(netlist), erreur)) {
+        cerr << "Netlist : " << erreur << endl;
+        return 1;
+    }
+    if (sortie.empty()) sortie = "resultats/netlist/" + filesystem::path(chemin).stem().string() + ".csv";
+    filesystem::path parent = filesystem::path(sortie).parent_path();
+    if (!parent.empty()) filesystem::create_directories(parent);
+    ofstream fichier(sortie);
+    if (!fichier) {
+        cerr << "Netlist : impossible d'écrire " << sortie << endl;
+        return 1;
+    }
+    fichier << "temps,Vin,Vout\n";
+    EmetteurCsv format;
+    format.fixerPas(dt);
+    EcrivainAsynchrone ecrivain(fichier, format);
+
+    cout << "=== Netlist (analyse nodale modifiée) ===" << endl;
+    cout << "  " << chemin << " : " << circuit.inconnues() << " inconnues, " << circuit.nonNulsA()
+         << " entrées non nulles, méthode " << p.methode << ", npas=" << p.npas << ", dt=" << dt << " s"
+         << endl;
+
+    auto debut = chrono::steady_clock::now();
+    const bool ok = circuit.simuler(p.methode, p.npas, dt,
+                                    [&ecrivain](double t, double vin, double vout) {
+                                        ecrivain.ajouter(t, vin, vout);
+                                    },
+                                    erreur);
+    ecrivain.terminer();
+    const double duree = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+    if (!ok) {
+        cerr << "Netlist : " << erreur << endl;
+        return 1;
+    }
+    cout << "  LU : " << circuit.nonNulsLU() << " entrées dans L et U, " << circuit.factorisations
+         << " factorisation(s) complète(s), " << circuit.refactorisations << " numérique(s), "
+         << circuit.resolutions << " résolutions" << endl;
+    cout << " Fichier '" << sortie << "' : " << p.npas + 1 << " points, calcul en " << duree << " s ("
+         << (p.npas + 1) / duree / 1e6 << " Mpas/s)" << endl;
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include "pool_taches.hpp"
+
+// Indice du thread du pool courant (-1 hors du pool)
+static thread_local int indiceThread = -1;
+static thread_local const PoolTaches* poolCourant = nullptr;
+
+PoolTaches::PoolTaches(unsigned nThreads) {
+    if (nThreads == 0) {
+        nThreads = std::thread::hardware_concurrency();
+        if (nThreads == 0) nThreads = 1;
+    }
+    for (unsigned i = 0; i < nThreads; ++i) {
+        files_.push_back(std::make_unique<File>());
+    }
+    for (unsigned i = 0; i < nThreads; ++i) {
+        threads_.emplace_back(&PoolTaches::boucleThread, this, i);
+    }
+}
+
+PoolTaches::~PoolTaches() {
+    {
+        std::lock_guard<std::mutex> verrou(mSommeil_);
+        arret_ = true;
+    }
+    cvTravail_.notify_all();
+    for (auto& th : threads_) {
+        th.join();
+    }
+}
+
+void PoolTaches::soumettre(std::function<void()> tache) {
+    std::size_t i = (poolCourant == this && indiceThread >= 0)
+                  ? static_cast<std::size_t>(indiceThread)
+                  : prochaineFile_.fetch_add(1) % files_.size();
+    nonTerminees_.fetch_add(1);
+    {
+        // Compter la tâche avant de la publier : enAttente_ ne passe jamais
+        // sous zéro. Prendre mSommeil_ évite de perdre le réveil d'un thread
+        // qui s'endort.
+        std::lock_guard<std::mutex> verrou(mSommeil_);
+        enAttente_.fetch_add(1);
+    }
+    {
+        std::lock_guard<std::mutex> verrou(files_[i]->m);
+        files_[i]->taches.push_back(std::move(tache));
+    }
+    cvTravail_.notify_one();
+}
+
+// Prend une tâche : d'abord dans sa propre file (par l'arrière), sinon vole
+// dans celle des autres (par l'avant)
+bool PoolTaches::prendre(unsigned indice, std::function<void()>& tache) {
+    {
+        File& f = *files_[indice];
+        std::lock_guard<std::mutex> verrou(f.m);
+        if (!f.taches.empty()) {
+            tache = std::move(f.taches.back());
+            f.taches.pop_back();
+            enAttente_.fetch_sub(1);
+            return true;
+        }
+    }
+    const std::size_t n = files_.size();
+    for (std::size_t k = 1; k < n; ++k) {
+        File& f = *files_[(indice + k) % n];
+        std::lock_guard<std::mutex> verrou(f.m);
+        if (!f.taches.empty()) {
+            tache = std::move(f.taches.front());
+            f.taches.pop_front();
+            enAttente_.fetch_sub(1);
+            vols_.fetch_add(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+void PoolTaches::boucleThread(unsigned indice) {
+    indiceThread = static_cast<int>(indice);
+    poolCourant = this;
+
+    std::function<void()> tache;
+    while (true) {
+        if (prendre(indice, tache)) {
+            tache();
+            tache = nullptr;
+            if (nonTerminees_.fetch_sub(1) == 1) {
+                std::lock_guard<std::mutex> verrou(mSommeil_);
+                cvFini_.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> verrou(mSommeil_);
+        cvTravail_.wait(verrou, [this] { return arret_ || enAttente_.load() > 0; });
+        if (arret_ && enAttente_.load() == 0) {
+            return;
+        }
+    }
+}
+
+void PoolTaches::attendre() {
+    std::unique_lock<std::mutex> verrou(mSommeil_);
+    cvFini_.wait(verrou, [this] { return nonTerminees_.load() == 0; });
+}
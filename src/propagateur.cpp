@@ -0,0 +1,80 @@
+#include "propagateur.hpp"
+#include <cmath>
+#include <vector>
+
+void exponentielleMatrice(int n, const double* a, double* e) {
+    // Mise à l'échelle : ||a / 2^s|| <= 1/2, la série converge alors vite
+    double norme = 0.0;
+    for (int i = 0; i < n; ++i) {
+        double ligne = 0.0;
+        for (int j = 0; j < n; ++j) ligne += std::fabs(a[i * n + j]);
+        if (ligne > norme) norme = ligne;
+    }
+    int s = 0;
+    if (norme > 0.5) s = static_cast<int>(std::ceil(std::log2(norme / 0.5)));
+    double echelle = std::ldexp(1.0, -s);
+
+    std::vector<double> x(n * n), terme(n * n), tmp(n * n);
+    for (int k = 0; k < n * n; ++k) {
+        x[k] = a[k] * echelle;
+        terme[k] = 0.0;
+        e[k] = 0.0;
+    }
+    for (int i = 0; i < n; ++i) {
+        terme[i * n + i] = 1.0;
+        e[i * n + i] = 1.0;
+    }
+
+    // Série de Taylor : terme_k = x^k / k!
+    for (int k = 1; k <= 30; ++k) {
+        double normeTerme = 0.0;
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                double v = 0.0;
+                for (int l = 0; l < n; ++l) v += terme[i * n + l] * x[l * n + j];
+                tmp[i * n + j] = v / k;
+            }
+        }
+        for (int q = 0; q < n * n; ++q) {
+            terme[q] = tmp[q];
+            e[q] += tmp[q];
+            normeTerme = std::fmax(normeTerme, std::fabs(tmp[q]));
+        }
+        if (normeTerme < 1e-18) break;
+    }
+
+    // exp(a) = exp(a / 2^s)^(2^s)
+    for (int r = 0; r < s; ++r) {
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                double v = 0.0;
+                for (int l = 0; l < n; ++l) v += e[i * n + l] * e[l * n + j];
+                tmp[i * n + j] = v;
+            }
+        }
+        for (int q = 0; q < n * n; ++q) e[q] = tmp[q];
+    }
+}
+
+void Propagateur::calculer(int ordreSysteme, const double a[2][2], const double b[2], double pas) {
+    ordre = ordreSysteme;
+    h = pas;
+
+    // Matrice augmentée (n+2) x (n+2), déjà multipliée par h
+    const int n = ordre;
+    const int m = n + 2;
+    double aug[16] = {0.0};
+    double e[16];
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) aug[i * m + j] = a[i][j] * h;
+        aug[i * m + n] = b[i] * h;
+    }
+    aug[n * m + n + 1] = h;
+    exponentielleMatrice(m, aug, e);
+
+    for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < 2; ++j) phi[i][j] = (i < n && j < n) ? e[i * m + j] : 0.0;
+        g0[i] = (i < n) ? e[i * m + n] : 0.0;
+        g1[i] = (i < n) ? e[i * m + n + 1] : 0.0;
+    }
+}
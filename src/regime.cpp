@@ -0,0 +1,261 @@
+#include "regime.hpp"
+#include "besim.hpp"
+#include "emetteur_csv.hpp"
+#include "fabrique.hpp"
+#include "solver_static.hpp"
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+// Itérations de Newton au-delà desquelles le tir est abandonné (circuit
+// linéaire : une seule ; au-delà, la période n'est pas contractante)
+static const int ITERATIONS_TIR_MAX = 20;
+
+bool periodeSource(int typeSource, double f, double& periode, string& erreur) {
+    if (typeSource == 2) {
+        erreur = "source non périodique (échelon)";
+        return false;
+    }
+    if (!(f > 0.0) || !isfinite(f) || !isfinite(1.0 / f)) {
+        erreur = "fréquence de la source invalide (f doit être positive et finie)";
+        return false;
+    }
+    periode = 1.0 / f;
+    return true;
+}
+
+static bool verifierMethode(int methode, int pasParPeriode, string& erreur) {
+    if (methode < 1 || methode > 10 || methode == 5) {
+        erreur = "méthode à pas fixe requise (1 à 4, 6 à 10)";
+        return false;
+    }
+    if (pasParPeriode < 1) {
+        erreur = "pas_periode doit être positif";
+        return false;
+    }
+    return true;
+}
+
+// Φ : une période depuis t = 0, source en phase ; (x1, x2) en entrée et en sortie
+static void unePeriode(const Circuit& circuit, const Source& source, double R2, int methode,
+                       int pasParPeriode, double dt, double& x1, double& x2) {
+    EtatBoucle e;
+    avancerStatique(circuit, source, R2, methode, pasParPeriode - 1, dt, x1, x2, e);
+}
+
+// max |fin - debut| sur l'état ; dedans : chaque composante dans rtol*|fin| + atol
+static double ecartPeriode(const double debut[2], const double fin[2], int ordre,
+                           const OptionsRegime& opt, bool& dedans) {
+    double ecart = 0.0;
+    dedans = true;
+    for (int j = 0; j < ordre; ++j) {
+        const double d = fabs(fin[j] - debut[j]);
+        ecart = max(ecart, d);
+        if (!(d <= opt.rtol * fabs(fin[j]) + opt.atol)) dedans = false;
+    }
+    return ecart;
+}
+
+bool regimeParTir(const Circuit& circuit, const Source& source, double R2, int methode,
+                  double periode, const OptionsRegime& opt, ResultatRegime& r, string& erreur) {
+    if (!verifierMethode(methode, opt.pasParPeriode, erreur)) return false;
+    const int ordre = circuit.order();
+    const int n = opt.pasParPeriode;
+    const double dt = periode / n;
+    r = ResultatRegime();
+
+    double x[2] = {0.0, 0.0};
+    while (r.iterations <= ITERATIONS_TIR_MAX && r.periodes < opt.periodesMax) {
+        double y[2] = {x[0], x[1]};
+        unePeriode(circuit, source, R2, methode, n, dt, y[0], y[1]);
+        ++r.periodes;
+        bool dedans;
+        r.ecart = ecartPeriode(x, y, ordre, opt, dedans);
+        if (dedans) {
+            r.converge = true;
+            break;
+        }
+        if (r.iterations == ITERATIONS_TIR_MAX || r.periodes + ordre > opt.periodesMax) break;
+
+        // Jacobien de Φ par différences finies, colonne par colonne. Φ est
+        // affine pour un circuit linéaire : le quotient est exact pour tout
+        // écart, un grand écart évite l'arrondi de Φ(x + h) - Φ(x)
+        double a[2][2] = {{1.0, 0.0}, {0.0, 1.0}};
+        for (int j = 0; j < ordre; ++j) {
+            double z[2] = {x[0], x[1]};
+            const double h = (circuit.lineaire() ? 1.0 : 1e-7) * (1.0 + fabs(x[j]));
+            z[j] += h;
+            unePeriode(circuit, source, R2, methode, n, dt, z[0], z[1]);
+            ++r.periodes;
+            for (int i = 0; i < ordre; ++i) a[i][j] = (z[i] - y[i]) / h;
+        }
+
+        // Newton : (Φ' - I) Δ = -(Φ(x) - x)
+        const double f0 = y[0] - x[0], f1 = y[1] - x[1];
+        a[0][0] -= 1.0;
+        a[1][1] -= 1.0;
+        if (ordre == 1) {
+            if (!(fabs(a[0][0]) > 1e-14)) {
+                erreur = "période non amortie : pas de régime permanent unique";
+                return false;
+            }
+            x[0] -= f0 / a[0][0];
+        } else {
+            const double det = a[0][0] * a[1][1] - a[0][1] * a[1][0];
+            if (!(fabs(det) > 1e-300) || !isfinite(det)) {
+                erreur = "période non amortie : pas de régime permanent unique";
+                return false;
+            }
+            x[0] += (-f0 * a[1][1] + f1 * a[0][1]) / det;
+            x[1] += (-f1 * a[0][0] + f0 * a[1][0]) / det;
+        }
+        ++r.iterations;
+    }
+    r.x1 = x[0];
+    r.x2 = x[1];
+    return true;
+}
+
+bool regimeParPeriodes(const Circuit& circuit, const Source& source, double R2, int methode,
+                       double periode, const OptionsRegime& opt, ResultatRegime& r,
+                       EcrivainAsynchrone* ecrivain, string& erreur) {
+    if (!verifierMethode(methode, opt.pasParPeriode, erreur)) return false;
+    const int ordre = circuit.order();
+    const long n = opt.pasParPeriode;
+    const double dt = periode / n;
+    r = ResultatRegime();
+
+    // Une seule boucle reprise période après période (EtatBoucle) : même
+    // trajectoire qu'un transitoire d'une traite, passé de BDF2 compris
+    EtatBoucle e;
+    double x[2] = {0.0, 0.0};
+    for (long k = 1; k <= opt.periodesMax; ++k) {
+        if (k * n - 1 > INT_MAX) {
+            erreur = "transitoire trop long pour la grille (periodes_max * pas_periode)";
+            return false;
+        }
+        const double debut[2] = {x[0], x[1]};
+        const int npas = static_cast<int>(k * n - 1);
+        if (ecrivain) {
+            simulerStatique(circuit, source, R2, methode, npas, dt, x[0], x[1], e, *ecrivain, 0, nullptr);
+        } else {
+            avancerStatique(circuit, source, R2, methode, npas, dt, x[0], x[1], e);
+        }
+        ++r.periodes;
+        bool dedans;
+        r.ecart = ecartPeriode(debut, x, ordre, opt, dedans);
+        if (dedans) {
+            r.converge = true;
+            break;
+        }
+    }
+    r.x1 = x[0];
+    r.x2 = x[1];
+    return true;
+}
+
+// --- Mode régime permanent ---
+
+int lancerRegime(int argc, char** argv) {
+    ParametresSimulation p;
+    OptionsRegime opt;
+    string sortie = "resultats/regime/regime.csv";
+    bool tir = true;
+    string erreur;
+    for (int i = 0; i < argc; ++i) {
+        string arg = argv[i];
+        size_t eg = arg.find('=');
+        if (eg == string::npos) {
+            cerr << "Régime : argument sans '=' : " << arg << endl;
+            return 1;
+        }
+        string cle = arg.substr(0, eg), valeur = arg.substr(eg + 1);
+        if (cle == "sortie") sortie = valeur;
+        else if (cle == "algo" && (valeur == "tir" || valeur == "periodes")) tir = valeur == "tir";
+        else if (cle == "pas_periode") opt.pasParPeriode = atoi(valeur.c_str());
+        else if (cle == "periodes_max") opt.periodesMax = atol(valeur.c_str());
+        else if (cle == "algo") {
+            cerr << "Régime : algo=tir ou algo=periodes" << endl;
+            return 1;
+        } else if (!fixerParametre(cle, valeur, p, erreur)) {
+            cerr << "Régime : " << erreur << endl;
+            return 1;
+        }
+    }
+    opt.rtol = p.rtol;
+    opt.atol = p.atol;
+    double periode;
+    if (!verifierParametres(p, erreur) || !verifierMethode(p.methode, opt.pasParPeriode, erreur)) {
+        cerr << "Régime : " << erreur << endl;
+        return 1;
+    }
+    if (!periodeSource(p.typeSource, p.f, periode, erreur)) {
+        cerr << "Régime : " << erreur << " : pas de régime permanent" << endl;
+        return 1;
+    }
+
+    unique_ptr<Circuit> circuit = creerCircuit(p.circuit, p.R, p.R2, p.C, p.L, p.f, false, p.diode);
+    unique_ptr<Source> source = creerSource(p.typeSource, p.amplitude, p.f, p.dutyCycle, p.offset,
+                                            p.startTime);
+    const double dt = periode / opt.pasParPeriode;
+
+    filesystem::path parent = filesystem::path(sortie).parent_path();
+    if (!parent.empty()) filesystem::create_directories(parent);
+    ofstream fichier(sortie);
+    if (!fichier) {
+        cerr << "Régime : impossible d'écrire " << sortie << endl;
+        return 1;
+    }
+    fichier << "temps,Vin,Vout\n";
+    EmetteurCsv format;
+    format.fixerPas(dt);
+    EcrivainAsynchrone ecrivain(fichier, format);
+
+    cout << "=== Régime permanent ===" << endl;
+    cout << "  Circuit " << p.circuit << ", source " << p.typeSource << ", méthode " << p.methode
+         << " : période " << periode << " s, " << opt.pasParPeriode << " pas par période (dt="
+         << dt << " s)" << endl;
+
+    ResultatRegime r;
+    auto debut = chrono::steady_clock::now();
+    bool ok;
+    if (tir) {
+        ok = regimeParTir(*circuit, *source, p.R2, p.methode, periode, opt, r, erreur);
+        // Une période du régime établi, depuis l'état trouvé
+        double x1 = r.x1, x2 = r.x2;
+        if (ok) simulerStatique(*circuit, *source, p.R2, p.methode, opt.pasParPeriode - 1, dt, x1, x2,
+                                ecrivain);
+    } else {
+        ok = regimeParPeriodes(*circuit, *source, p.R2, p.methode, periode, opt, r, &ecrivain, erreur);
+    }
+    ecrivain.terminer();
+    const double duree = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+    if (!ok) {
+        cerr << "Régime : " << erreur << endl;
+        return 1;
+    }
+
+    if (tir) {
+        cout << "  Tir : " << r.iterations << " itération(s) de Newton, " << r.periodes
+             << " périodes intégrées" << endl;
+    } else {
+        cout << "  Transitoire : " << r.periodes << " périodes intégrées (t = " << r.periodes * periode
+             << " s)" << endl;
+    }
+    cout << "  " << (r.converge ? "Régime établi" : "NON convergé") << " : écart entre début et fin de période "
+         << r.ecart << " (rtol=" << opt.rtol << ", atol=" << opt.atol << ")" << endl;
+    cout << "  État au début de la période : x1 = " << r.x1;
+    if (circuit->order() == 2) cout << ", x2 = " << r.x2;
+    cout << endl;
+    const long lignes = (tir ? 1 : r.periodes) * static_cast<long>(opt.pasParPeriode);
+    cout << " Fichier '" << sortie << "' : " << lignes << " points"
+         << (tir ? " (une période du régime établi)" : " (transitoire jusqu'au régime)") << ", calcul en "
+         << duree << " s" << endl;
+    return r.converge ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+#include "rk45.hpp"
+#include "solver_static.hpp"
+
+// Intégration commune aux deux points d'entrée ; ecrire(t, Vin, Vout) reçoit
+// les échantillons de la grille de sortie
+template <class Sortie, class Jalon>
+static StatsRK45 simulerRK45Vers(const Circuit& circuit, const Source& source, double R2,
+                                 int npas, double tmax, const OptionsRK45& opt,
+                                 double& x1, double& x2, Sortie&& ecrire,
+                                 EtatRK45& etat, int intervalle, Jalon&& jalon) {
+    const int dim = circuit.order();
+    StatsRK45 stats;
+
+    // Chemin rapide : circuit et source concrets, champ inliné
+    bool connu = statique::aiguillerTypes(circuit, source, [&](const auto& c, const auto& s) {
+        auto champ = [&](double t, double y1, double y2, double& d1, double& d2) {
+            double ve = s.ve(t);
+            if (dim == 1) { d1 = c.deriv1(t, y1, ve, R2); d2 = 0.0; }
+            else c.deriv2(t, y1, y2, ve, d1, d2);
+        };
+        auto entree = [&](double t) { return s.ve(t); };
+        auto discontinuite = [&](double t) { return s.prochaineDiscontinuite(t); };
+        stats = rk45::integrer(champ, entree, discontinuite, ecrire, dim, tmax, npas, opt, x1, x2,
+                               etat, intervalle, jalon);
+    });
+
+    // Chemin générique : appels virtuels
+    if (!connu) {
+        auto champ = [&](double t, double y1, double y2, double& d1, double& d2) {
+            double ve = source.ve(t);
+            if (dim == 1) { d1 = circuit.deriv1(t, y1, ve, R2); d2 = 0.0; }
+            else circuit.deriv2(t, y1, y2, ve, d1, d2);
+        };
+        auto entree = [&](double t) { return source.ve(t); };
+        auto discontinuite = [&](double t) { return source.prochaineDiscontinuite(t); };
+        stats = rk45::integrer(champ, entree, discontinuite, ecrire, dim, tmax, npas, opt, x1, x2,
+                               etat, intervalle, jalon);
+    }
+    return stats;
+}
+
+static void sansJalon(const EtatRK45&, double, double) {}
+
+StatsRK45 simulerRK45(const Circuit& circuit, const Source& source, double R2,
+                      int npas, double tmax, const OptionsRK45& opt,
+                      double& x1, double& x2, EcrivainAsynchrone& ecrivain) {
+    auto ecrire = [&ecrivain](double t, double Vin, double Vout) {
+        ecrivain.ajouter(t, Vin, Vout);
+    };
+    EtatRK45 etat;
+    return simulerRK45Vers(circuit, source, R2, npas, tmax, opt, x1, x2, ecrire, etat, 0, sansJalon);
+}
+
+StatsRK45 simulerRK45(const Circuit& circuit, const Source& source, double R2,
+                      int npas, double tmax, const OptionsRK45& opt,
+                      double& x1, double& x2, EtatRK45& etat, EcrivainAsynchrone& ecrivain,
+                      int intervalle,
+                      const std::function<void(const EtatRK45&, double, double)>& jalon) {
+    auto ecrire = [&ecrivain](double t, double Vin, double Vout) {
+        ecrivain.ajouter(t, Vin, Vout);
+    };
+    return simulerRK45Vers(circuit, source, R2, npas, tmax, opt, x1, x2, ecrire, etat, intervalle,
+                           jalon);
+}
+
+StatsRK45 simulerRK45(const Circuit& circuit, const Source& source, double R2,
+                      int npas, double tmax, const OptionsRK45& opt,
+                      double& x1, double& x2, double* temps, double* vin, double* vout,
+                      std::size_t& nombre) {
+    nombre = 0;
+    auto ranger = [&](double t, double Vin, double Vout) {
+        temps[nombre] = t;
+        vin[nombre] = Vin;
+        vout[nombre] = Vout;
+        ++nombre;
+    };
+    EtatRK45 etat;
+    return simulerRK45Vers(circuit, source, R2, npas, tmax, opt, x1, x2, ranger, etat, 0, sansJalon);
+}
+
+StatsRK45 simulerRK45(const Circuit& circuit, const Source& source, double R2,
+                      int npas, double tmax, const OptionsRK45& opt,
+                      double& x1, double& x2,
+                      const std::function<void(double, double, double)>& sortie) {
+    EtatRK45 etat;
+    return simulerRK45Vers(circuit, source, R2, npas, tmax, opt, x1, x2, sortie, etat, 0, sansJalon);
+}
@@ -0,0 +1,415 @@
+#include "serveur.hpp"
+#include "cache_resultats.hpp"
+#include "decimateur.hpp"
+#include "ecrivain.hpp"
+#include "fabrique.hpp"
+#include "flux_trames.hpp"
+#include "pool_taches.hpp"
+#include "rk45.hpp"
+#include "simulation.hpp"
+#include "solver_static.hpp"
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace std;
+
+// --- Lecture des requêtes ---
+
+static string texte(double v) {
+    ostringstream os;
+    os.precision(17);
+    os << v;
+    return os.str();
+}
+
+bool lireRequete(const string& ligne, RequeteSimulation& r, string& erreur) {
+    istringstream ss(ligne);
+    string champ;
+    while (ss >> champ) {
+        size_t eg = champ.find('=');
+        if (eg == string::npos) {
+            erreur = "champ sans '=' : " + champ;
+            return false;
+        }
+        if (!fixerParametre(champ.substr(0, eg), champ.substr(eg + 1), r, erreur)) return false;
+    }
+    return verifierParametres(r, erreur);
+}
+
+// --- Simulation d'une requête ---
+
+// Résultat lu dans le cache du processus : les blocs partent directement
+// des colonnes en mémoire, découpés comme les paquets de l'écrivain (mêmes
+// trames que le calcul qui a rempli le cache)
+static void envoyerDepuisCache(const RequeteSimulation& r, const ResultatSimulation& resultat,
+                               OrigineResultat origine, double attente, FluxTrames& flux,
+                               Decimateur& trace) {
+    const size_t ECHANTILLONS_PAR_TRAME = 8192;     // comme les paquets de l'écrivain
+    const Colonnes& s = resultat.signal;
+    for (size_t i = 0; i < s.taille(); ++i) {
+        flux.ajouter(s.temps()[i], s.vin()[i], s.vout()[i]);
+        if (r.trace > 0) trace.ajouter(s.temps()[i], s.vin()[i], s.vout()[i]);
+        if ((i + 1) % ECHANTILLONS_PAR_TRAME == 0) flux.envoyerBloc();
+    }
+    flux.envoyerBloc();
+    if (r.trace > 0) {
+        trace.terminer();
+        flux.envoyerTrace(trace);
+    }
+
+    FluxTrames::Parametres resume = {{"statut", "ok"},
+                                     {"cache", nomOrigine(origine)},
+                                     {"calcul_ms", texte(attente * 1e3)}};
+    if (r.methode == 5) {
+        resume.push_back({"pas_acceptes", to_string(resultat.pasAcceptes)});
+        resume.push_back({"pas_rejetes", to_string(resultat.pasRejetes)});
+    }
+    flux.terminer(resume);
+}
+
+static void diffuserRequete(const RequeteSimulation& r, FILE* sortie, bool avecCache) {
+    unique_ptr<Circuit> circuit = creerCircuit(r.circuit, r.R, r.R2, r.C, r.L, r.f, false, r.diode);
+    unique_ptr<Source> source = creerSource(r.typeSource, r.amplitude, r.f, r.dutyCycle,
+                                            r.offset, r.startTime);
+    Simulation sim(r.npas, r.tmax);
+    const size_t n = static_cast<size_t>(sim.getNpas()) + 1;
+
+    FluxTrames flux(sortie);
+    const FluxTrames::Parametres parametres = {
+        {"dt", texte(sim.getDt())},
+        {"npas", to_string(sim.getNpas())},
+        {"tmax", texte(sim.getTmax())},
+        {"circuit", string(1, r.circuit)},
+        {"methode", to_string(r.methode)},
+        {"source", source->getType()},
+        {"R", texte(r.R)},
+        {"R2", texte(r.R2)},
+        {"C", texte(r.C)},
+        {"L", texte(r.L)}};
+    if (!flux.ouvrir(n, parametres)) {
+        flux.terminer({{"statut", "erreur"}, {"message", "format binaire indisponible"}});
+        return;
+    }
+
+    // Cache : un succès est relu depuis la mémoire ; un échec est diffusé au
+    // fil de l'intégration tout en remplissant l'entrée, rangée à la fin. Un
+    // résultat plus grand que la limite mémoire n'est pas gardé (diffusé seul).
+    // Les demandes de la même clé arrivées pendant le calcul l'attendent.
+    Decimateur trace(n, r.trace, r.lttb ? Decimateur::Mode::Lttb : Decimateur::Mode::MinMax);
+    CacheResultats::Reservation reservation;
+    shared_ptr<ResultatSimulation> copie;
+    const auto debut = chrono::steady_clock::now();
+    if (avecCache && cacheResultats().gardable(n)) {
+        OrigineResultat origine = OrigineResultat::Calcul;
+        shared_ptr<const ResultatSimulation> resultat =
+            cacheResultats().chercher(cleCanonique(r), origine, reservation);
+        if (resultat) {
+            const double attente = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+            envoyerDepuisCache(r, *resultat, origine, attente, flux, trace);
+            return;
+        }
+        copie = make_shared<ResultatSimulation>();
+        copie->signal.allouer(n);
+    }
+
+    double x1 = 0.0, x2 = 0.0;
+    bool ok = true;
+    string erreur;
+    FluxTrames::Parametres resume;
+    if (avecCache) resume.push_back({"cache", copie ? "calcul" : "non"});
+    {
+        EcrivainAsynchrone ecrivain(flux);
+        if (r.trace > 0) ecrivain.fixerTrace(trace);
+        if (copie) ecrivain.fixerCopie(copie->signal);
+        if (r.methode == 5) {
+            OptionsRK45 opt;
+            opt.rtol = r.rtol;
+            opt.atol = r.atol;
+            StatsRK45 stats = simulerRK45(*circuit, *source, r.R2, sim.getNpas(), sim.getTmax(),
+                                          opt, x1, x2, ecrivain);
+            resume.push_back({"pas_acceptes", to_string(stats.pasAcceptes)});
+            resume.push_back({"pas_rejetes", to_string(stats.pasRejetes)});
+            if (copie) {
+                copie->pasAcceptes = stats.pasAcceptes;
+                copie->pasRejetes = stats.pasRejetes;
+            }
+        } else {
+            ok = simulerStatique(*circuit, *source, r.R2, r.methode, sim.getNpas(), sim.getDt(),
+                                 x1, x2, ecrivain);
+            if (!ok) erreur = "circuit ou source hors de l'aiguillage statique";
+        }
+        ecrivain.terminer();
+        resume.push_back({"paquets", to_string(ecrivain.paquetsEcrits())});
+        resume.push_back({"ecriture_ms", texte(ecrivain.dureeEcriture() * 1e3)});
+        resume.push_back({"attente_ms", texte(ecrivain.attenteIntegrateur() * 1e3)});
+    }
+    if (copie && ok) {
+        copie->dureeNs = chrono::duration<double, nano>(chrono::steady_clock::now() - debut).count();
+        reservation.ranger(copie);
+    }
+    if (r.trace > 0) {
+        trace.terminer();
+        flux.envoyerTrace(trace);
+    }
+    if (!ok) resume.insert(resume.begin(), {"message", erreur});
+    resume.insert(resume.begin(), {"statut", ok ? "ok" : "erreur"});
+    flux.terminer(resume);
+}
+
+void simulerRequete(const RequeteSimulation& r, FILE* sortie, bool avecCache) {
+    // Une requête qui échoue (mémoire épuisée, ...) ne concerne que son
+    // client : le serveur et les autres connexions continuent
+    try {
+        diffuserRequete(r, sortie, avecCache);
+    } catch (const exception& e) {
+        FluxTrames(sortie).terminer({{"statut", "erreur"},
+                                     {"message", string("échec de la simulation : ") + e.what()}});
+    }
+}
+
+// --- Connexions ---
+
+// Une requête tient sur quelques centaines d'octets : au-delà, le client
+// est fautif et n'a pas à faire grossir la mémoire du serveur
+constexpr size_t LONGUEUR_LIGNE_MAX = 64 * 1024;
+
+enum class Lecture { Ligne, Fin, TropLongue };
+
+// Ligne terminée par '\n' (sans lui) ; Fin en fin de connexion, TropLongue
+// au-delà de LONGUEUR_LIGNE_MAX octets (le reste n'est pas lu)
+static Lecture lireLigne(FILE* entree, string& ligne) {
+    ligne.clear();
+    int c;
+    while ((c = fgetc(entree)) != EOF) {
+        if (c == '\n') return Lecture::Ligne;
+        if (c == '\r') continue;
+        if (ligne.size() >= LONGUEUR_LIGNE_MAX) return Lecture::TropLongue;
+        ligne.push_back(static_cast<char>(c));
+    }
+    return ligne.empty() ? Lecture::Fin : Lecture::Ligne;
+}
+
+// Fermeture après une ligne trop longue : la réponse est envoyée et le côté
+// écriture fermé, puis l'entrée restante est lue et jetée (au plus `reste`
+// octets, ou jusqu'au délai d'inactivité) ; fermer une socket dont l'entrée
+// n'est pas lue la réinitialise et le client perdrait la réponse
+static void ecarterEntree(FILE* entree, FILE* sortie, size_t reste) {
+    fflush(sortie);
+    shutdown(fileno(sortie), SHUT_WR);
+    while (reste-- > 0 && fgetc(entree) != EOF) {
+    }
+}
+
+// SIGTERM ou SIGINT reçu : la boucle principale cesse d'accepter
+static volatile sig_atomic_t signalArret = 0;
+
+static void noterSignalArret(int) {
+    signalArret = 1;
+}
+
+// Débloque accept() dans la boucle principale après un "arret"
+static void reveiller(const string& chemin) {
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return;
+    sockaddr_un adresse{};
+    adresse.sun_family = AF_UNIX;
+    strncpy(adresse.sun_path, chemin.c_str(), sizeof(adresse.sun_path) - 1);
+    connect(fd, reinterpret_cast<sockaddr*>(&adresse), sizeof(adresse));
+    close(fd);
+}
+
+static void servirClient(int fd, const string& chemin, bool avecCache, int inactivite,
+                         bool arretPermis, atomic<bool>& arret) {
+    // Connexion inactive plus de `inactivite` s entre deux requêtes : fermée,
+    // pour rendre le thread du pool aux autres clients
+    if (inactivite > 0) {
+        timeval delai{};
+        delai.tv_sec = inactivite;
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &delai, sizeof(delai));
+    }
+    FILE* entree = fdopen(fd, "r");
+    FILE* sortie = fdopen(dup(fd), "w");
+    if (!entree || !sortie) {
+        if (entree) fclose(entree); else close(fd);
+        if (sortie) fclose(sortie);
+        return;
+    }
+
+    string ligne;
+    for (Lecture lu; (lu = lireLigne(entree, ligne)) != Lecture::Fin;) {
+        if (lu == Lecture::TropLongue) {
+            FluxTrames(sortie).terminer({{"statut", "erreur"},
+                                         {"message", "requête de plus de "
+                                                     + to_string(LONGUEUR_LIGNE_MAX) + " octets"}});
+            ecarterEntree(entree, sortie, 16 * LONGUEUR_LIGNE_MAX);
+            break;
+        }
+        if (ligne.find_first_not_of(" \t") == string::npos) continue;
+        if (ligne == "fin") break;
+        if (ligne == "arret" && !arretPermis) {
+            FluxTrames(sortie).terminer({{"statut", "erreur"},
+                                         {"message", "arret refusé : serveur lancé sans arret=oui"}});
+            continue;
+        }
+        if (ligne == "arret") {
+            arret = true;
+            reveiller(chemin);
+            break;
+        }
+        RequeteSimulation r;
+        string erreur;
+        if (lireRequete(ligne, r, erreur)) {
+            simulerRequete(r, sortie, avecCache);
+        } else {
+            FluxTrames(sortie).terminer({{"statut", "erreur"}, {"message", erreur}});
+        }
+        if (ferror(sortie)) break;  // client parti
+    }
+    fclose(sortie);
+    fclose(entree);
+}
+
+int lancerServeur(int argc, char** argv) {
+    string chemin = "/tmp/be-sim.sock";
+    bool cheminDonne = false;
+    unsigned threads = 0;
+    int inactivite = 60;
+    bool avecCache = true;
+    bool arretPermis = false;
+    OptionsCache optionsCache;
+    optionsCache.dossier = "resultats/cache";
+    for (int i = 0; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.rfind("threads=", 0) == 0) {
+            threads = static_cast<unsigned>(atoi(arg.c_str() + 8));
+        } else if (arg == "cache=non") {
+            avecCache = false;
+        } else if (arg.rfind("cache=", 0) == 0) {
+            optionsCache.dossier = arg.substr(6);
+        } else if (arg.rfind("cache_mo=", 0) == 0) {
+            optionsCache.limiteDisque = static_cast<size_t>(atol(arg.c_str() + 9)) << 20;
+        } else if (arg == "arret=oui" || arg == "arret=non") {
+            arretPermis = arg == "arret=oui";
+        } else if (arg.rfind("inactivite=", 0) == 0) {
+            inactivite = atoi(arg.c_str() + 11);
+        } else if (arg.find('=') != string::npos) {
+            cerr << "Serveur : option inconnue : " << arg << endl;
+            return 1;
+        } else if (cheminDonne || arg.empty()) {
+            cerr << "Serveur : un seul chemin de socket attendu : " << arg << endl;
+            return 1;
+        } else {
+            chemin = arg;
+            cheminDonne = true;
+        }
+    }
+
+    // Seule une socket (d'une exécution précédente) est remplacée : jamais un
+    // fichier ordinaire ou un dossier
+    struct stat etat;
+    if (lstat(chemin.c_str(), &etat) == 0) {
+        if (!S_ISSOCK(etat.st_mode)) {
+            cerr << "Serveur : " << chemin << " existe et n'est pas une socket" << endl;
+            return 1;
+        }
+        unlink(chemin.c_str());
+    }
+
+    sockaddr_un adresse{};
+    if (chemin.size() >= sizeof(adresse.sun_path)) {
+        cerr << "Serveur : chemin de socket trop long : " << chemin << endl;
+        return 1;
+    }
+    adresse.sun_family = AF_UNIX;
+    strncpy(adresse.sun_path, chemin.c_str(), sizeof(adresse.sun_path) - 1);
+
+    // Un client qui se déconnecte en cours de réponse ne doit pas tuer le serveur
+    signal(SIGPIPE, SIG_IGN);
+
+    int ecoute = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (ecoute < 0 || bind(ecoute, reinterpret_cast<sockaddr*>(&adresse), sizeof(adresse)) < 0
+        || listen(ecoute, 64) < 0) {
+        cerr << "Serveur : impossible d'écouter sur " << chemin << " (" << strerror(errno) << ")"
+             << endl;
+        if (ecoute >= 0) close(ecoute);
+        return 1;
+    }
+
+    // SIGTERM et SIGINT ne sont reçus que pendant l'attente de pselect() :
+    // bloqués avant la création du pool (ses threads héritent du masque), ils
+    // ne peuvent arriver ni ailleurs ni entre le test de signalArret et l'attente
+    sigset_t signauxArret, masqueAttente;
+    sigemptyset(&signauxArret);
+    sigaddset(&signauxArret, SIGTERM);
+    sigaddset(&signauxArret, SIGINT);
+    pthread_sigmask(SIG_BLOCK, &signauxArret, &masqueAttente);
+    struct sigaction action{};
+    action.sa_handler = noterSignalArret;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGTERM, &action, nullptr);
+    sigaction(SIGINT, &action, nullptr);
+
+    if (avecCache) configurerCache(optionsCache);
+    PoolTaches pool(threads);
+    cout << "=== Serveur de simulation ===" << endl;
+    cout << "  Socket " << chemin << ", " << pool.taille() << " threads";
+    if (inactivite > 0) cout << ", connexions inactives fermées après " << inactivite << " s";
+    cout << endl;
+    cout << "  Arrêt : SIGTERM ou SIGINT" << (arretPermis ? ", ou ligne \"arret\" d'un client" : "")
+         << endl;
+    if (avecCache) {
+        cout << "  Cache : mémoire " << (optionsCache.limiteMemoire >> 20) << " Mo, dossier "
+             << optionsCache.dossier << " (" << (optionsCache.limiteDisque >> 20) << " Mo)" << endl;
+    }
+
+    atomic<bool> arret{false};
+    size_t connexions = 0;
+    while (!arret && !signalArret) {
+        fd_set lecture;
+        FD_ZERO(&lecture);
+        FD_SET(ecoute, &lecture);
+        if (pselect(ecoute + 1, &lecture, nullptr, nullptr, nullptr, &masqueAttente) < 0) {
+            if (errno == EINTR) continue;
+            cerr << "Serveur : pselect : " << strerror(errno) << endl;
+            break;
+        }
+        int client = accept(ecoute, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR) continue;
+            cerr << "Serveur : accept : " << strerror(errno) << endl;
+            break;
+        }
+        if (arret) {
+            close(client);
+            break;
+        }
+        ++connexions;
+        pool.soumettre([client, &chemin, avecCache, inactivite, arretPermis, &arret] {
+            servirClient(client, chemin, avecCache, inactivite, arretPermis, arret);
+        });
+    }
+
+    close(ecoute);
+    pool.attendre();
+    unlink(chemin.c_str());
+    cout << " Serveur arrêté après " << connexions << " connexions" << endl;
+    if (avecCache) {
+        CacheResultats::Statistiques stats = cacheResultats().statistiques();
+        cout << "   Cache : " << stats.succesMemoire << " succès mémoire, " << stats.succesDisque
+             << " succès disque, " << stats.echecs << " calculs" << endl;
+    }
+    return 0;
+}
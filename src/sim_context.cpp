@@ -12,18 +12,11 @@ SimContext createSimContext(Circuit &circuit, const Source &source, double R2) {
         return circuit.deriv1(t, vs, ve, R2);
     };
 
-    ctx.f2_1 = [&circuit, &source](double t, double x1, double x2)->double {
+    ctx.f2 = [&circuit, &source](double t, double x1, double x2,
+                                 double &dx1, double &dx2)->double {
         double ve = source.ve(t);
-        double dx1, dx2;
         circuit.deriv2(t, x1, x2, ve, dx1, dx2);
-        return dx1;
-    };
-
-    ctx.f2_2 = [&circuit, &source](double t, double x1, double x2)->double {
-        double ve = source.ve(t);
-        double dx1, dx2;
-        circuit.deriv2(t, x1, x2, ve, dx1, dx2);
-        return dx2;
+        return ve;
     };
 
     return ctx;
@@ -22,6 +22,13 @@ void Simulation::calculerDt() {
     dt_ = tmax_ / npas_;
 }
 
+// Le pas n'est pas recalculé : tmax/npas pourrait différer de dt au dernier bit
+void Simulation::prolonger(double dt, int npas) {
+    dt_ = dt;
+    npas_ = npas;
+    tmax_ = npas * dt;
+}
+
 // Lire les paramètres depuis l'utilisateur
 void Simulation::lireParametres() {
     cout << "=== Configuration de la simulation ===" << endl;
@@ -9,67 +9,71 @@ void euler1(double& x, double dt, double t, Deriv1 f) {
 
 // Euler pour systèmes 2x2 (circuits 2ème ordre)
 
-void euler2(double& x1, double& x2, double dt, double t,
-           Deriv2 f1,
-           Deriv2 f2) {
+double euler2(double& x1, double& x2, double dt, double t, const Champ2& f) {
 
-    // Calcul des dérivées au point actuel
+    // Calcul des dérivées au point actuel (un seul appel au champ)
+
+    double dx1_dt, dx2_dt;
+    double ve = f(t, x1, x2, dx1_dt, dx2_dt);
 
-    double dx1_dt = f1(t, x1, x2);
-    double dx2_dt = f2(t, x1, x2);
-    
     // Mise à jour selon la méthode d'Euler
 
     x1 += dt * dx1_dt;
     x2 += dt * dx2_dt;
+    return ve;
 }
 
 // Runge-Kutta 4ème ordre pour systèmes 2x2
+// 4 évaluations du champ (donc 4 de la source) au lieu de 8
+
+double rk4(double& x1, double& x2, double dt, double t, const Champ2& f) {
+    double d1, d2;
 
-void rk4(double& x1, double& x2, double dt, double t,
-         Deriv2 f1,
-         Deriv2 f2) {
     // Coefficients RK4 pour x1 et x2
-    double k1_x1 = dt * f1(t, x1, x2);
-    double k1_x2 = dt * f2(t, x1, x2);
-    
-    double k2_x1 = dt * f1(t + dt/2, x1 + k1_x1/2, x2 + k1_x2/2);
-    double k2_x2 = dt * f2(t + dt/2, x1 + k1_x1/2, x2 + k1_x2/2);
-    
-    double k3_x1 = dt * f1(t + dt/2, x1 + k2_x1/2, x2 + k2_x2/2);
-    double k3_x2 = dt * f2(t + dt/2, x1 + k2_x1/2, x2 + k2_x2/2);
-    
-    double k4_x1 = dt * f1(t + dt, x1 + k3_x1, x2 + k3_x2);
-    double k4_x2 = dt * f2(t + dt, x1 + k3_x1, x2 + k3_x2);
-    
+    double ve = f(t, x1, x2, d1, d2);
+    double k1_x1 = dt * d1;
+    double k1_x2 = dt * d2;
+
+    f(t + dt/2, x1 + k1_x1/2, x2 + k1_x2/2, d1, d2);
+    double k2_x1 = dt * d1;
+    double k2_x2 = dt * d2;
+
+    f(t + dt/2, x1 + k2_x1/2, x2 + k2_x2/2, d1, d2);
+    double k3_x1 = dt * d1;
+    double k3_x2 = dt * d2;
+
+    f(t + dt, x1 + k3_x1, x2 + k3_x2, d1, d2);
+    double k4_x1 = dt * d1;
+    double k4_x2 = dt * d2;
+
     // Mise à jour finale
     x1 += (k1_x1 + 2*k2_x1 + 2*k3_x1 + k4_x1) / 6;
     x2 += (k1_x2 + 2*k2_x2 + 2*k3_x2 + k4_x2) / 6;
+    return ve;
 }
 
 // Heun (Euler amélioré) pour systèmes 2x2
 
-void heun(double& x1, double& x2, double dt, double t,
-          Deriv2 f1,
-          Deriv2 f2) {
+double heun(double& x1, double& x2, double dt, double t, const Champ2& f) {
 
     // Étape de prédiction (Euler)
 
-    double dx1_dt = f1(t, x1, x2);
-    double dx2_dt = f2(t, x1, x2);
-    
+    double dx1_dt, dx2_dt;
+    double ve = f(t, x1, x2, dx1_dt, dx2_dt);
+
     double x1_pred = x1 + dt * dx1_dt;
     double x2_pred = x2 + dt * dx2_dt;
-    
+
     // Étape de correction (moyenne des pentes)
 
-    double dx1_dt_pred = f1(t + dt, x1_pred, x2_pred);
-    double dx2_dt_pred = f2(t + dt, x1_pred, x2_pred);
-    
+    double dx1_dt_pred, dx2_dt_pred;
+    f(t + dt, x1_pred, x2_pred, dx1_dt_pred, dx2_dt_pred);
+
     // Mise à jour finale avec la moyenne
-    
+
     x1 += dt * (dx1_dt + dx1_dt_pred) / 2;
     x2 += dt * (dx2_dt + dx2_dt_pred) / 2;
+    return ve;
 }
 
 // Runge-Kutta 4 pour l'ordre 1
@@ -0,0 +1,81 @@
+#include "sortie_binaire.hpp"
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <unistd.h>
+
+SortieBinaire::~SortieBinaire() {
+    fermer();
+}
+
+bool SortieBinaire::ouvrir(const std::string& chemin, std::size_t n, const Parametres& parametres) {
+    fermer();
+
+    // Les colonnes sont écrites telles quelles : l'en-tête annonce du little-endian
+    const std::uint16_t un = 1;
+    if (*reinterpret_cast<const unsigned char*>(&un) != 1) {
+        std::cerr << "Sortie binaire : machine big-endian non prise en charge" << std::endl;
+        return false;
+    }
+
+    chemin_ = chemin;
+    parametres_ = parametres;
+    n_ = n;
+    valides_ = 0;
+    taille_ = TAILLE_ENTETE + 3 * n * sizeof(double);
+
+    fd_ = ::open(chemin.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+        std::cerr << "Sortie binaire : impossible de créer " << chemin << std::endl;
+        return false;
+    }
+    // Préallocation à la taille finale : pas d'extension du fichier pendant
+    // l'écriture (ftruncate seul donnerait un fichier creux)
+    bool alloue = (::ftruncate(fd_, static_cast<off_t>(taille_)) == 0);
+#ifdef __linux__
+    if (alloue) alloue = (::posix_fallocate(fd_, 0, static_cast<off_t>(taille_)) == 0);
+#endif
+    void* p = alloue ? ::mmap(nullptr, taille_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0)
+                     : MAP_FAILED;
+    if (p == MAP_FAILED) {
+        std::cerr << "Sortie binaire : impossible de projeter " << chemin << std::endl;
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    base_ = static_cast<char*>(p);
+    colonnes_ = reinterpret_cast<double*>(base_ + TAILLE_ENTETE);
+    ecrireEntete();
+    return true;
+}
+
+void SortieBinaire::ecrireEntete() {
+    std::string e = "BESIM-COLONNES\n";
+    e += "version=1\n";
+    e += "entete=" + std::to_string(TAILLE_ENTETE) + "\n";
+    e += "n=" + std::to_string(n_) + "\n";
+    e += "valides=" + std::to_string(valides_) + "\n";
+    e += "colonnes=" + noms_ + "\n";
+    for (const auto& p : parametres_) {
+        e += p.first + "=" + p.second + "\n";
+    }
+    if (e.size() > TAILLE_ENTETE - 1) {
+        e.resize(TAILLE_ENTETE - 1);    // paramètres tronqués, colonnes intactes
+    }
+    std::memset(base_, ' ', TAILLE_ENTETE);
+    std::memcpy(base_, e.data(), e.size());
+    base_[TAILLE_ENTETE - 1] = '\n';
+}
+
+void SortieBinaire::fermer() {
+    if (base_ == nullptr) return;
+    ecrireEntete();
+    ::msync(base_, taille_, MS_SYNC);
+    ::munmap(base_, taille_);
+    ::close(fd_);
+    base_ = nullptr;
+    colonnes_ = nullptr;
+    fd_ = -1;
+}
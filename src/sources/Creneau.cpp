@@ -42,24 +42,16 @@ CreneauSource::CreneauSource(double amplitude, double frequency, double dutyCycl
 
 // Calcul de la valeur : signal carré/créneau
 // Remplacé : getValue -> ve ; ajout de la condition t < 0
-double CreneauSource::ve(double t) const {
-    // 1) Toutes les sources sont nulles pour t < 0
-    if (t < 0.0) {
-        return 0.0;
-    }
-
-    // 2) Calcul du créneau pour t >= 0
-    double period = 1.0 / frequency_;
-    double timeInPeriod = fmod(t, period);  // modulo pour doubles
-    if (timeInPeriod < 0.0) {
-        timeInPeriod += period; // sécurise pour valeurs négatives éventuelles
-    }
-    double onTime = period * dutyCycle_;
-
-    if (timeInPeriod < onTime) {
-        return amplitude_ + offset_; // partie haute
-    } else {
-        return offset_;              // partie basse
+// (définie inline dans source.hpp)
+
+// Évaluation par blocs : accumulateur de phase (Source::remplirPhases) puis
+// comparaison au rapport cyclique
+void CreneauSource::remplir(double t0, double dt, std::size_t n, double* valeurs) const {
+    remplirPhases(t0, dt, n, frequency_, valeurs);
+    const double haut = amplitude_ + offset_, bas = offset_;
+    for (std::size_t k = 0; k < n; ++k) {
+        double p = valeurs[k];
+        double v = (p < dutyCycle_) ? haut : bas;
+        valeurs[k] = (p < 0.0) ? 0.0 : v;
     }
 }
-
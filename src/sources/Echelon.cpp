@@ -33,19 +33,15 @@ EchelonSource::EchelonSource() {
 EchelonSource::EchelonSource(double amplitude, double startTime) {
     amplitude_ = amplitude;
     startTime_ = startTime;
+    offset_ = 0.0;
 }
 
 // Calcul de la valeur : signal échelon
+// (définie inline dans source.hpp)
 
-double EchelonSource::ve(double t) const {
-    // Toutes les sources sont nulles pour t < 0
-    if (t < 0.0) {
-        return 0.0;
-    }
-
-    if (t < startTime_) {
-        return offset_;               // Avant le début de l'échelon
-    } else {
-        return amplitude_ + offset_;  // Après le début de l'échelon
+// Évaluation par blocs (ve inliné, sans appel virtuel)
+void EchelonSource::remplir(double t0, double dt, std::size_t n, double* valeurs) const {
+    for (std::size_t k = 0; k < n; ++k) {
+        valeurs[k] = EchelonSource::ve(t0 + k * dt);
     }
 }
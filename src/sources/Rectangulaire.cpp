@@ -42,22 +42,16 @@ RectangulaireSource::RectangulaireSource(double amplitude, double frequency, dou
 }
 
 // Calcul de la valeur : signal rectangulaire
-
-double RectangulaireSource::ve(double t) const {
-    // 1) Null for negative time
-    if (t < 0.0) {
-        return 0.0;
-    }
-
-    double period = 1.0 / frequency_;
-    double timeInPeriod = fmod(t, period);  // modulo fonctionne avec les doubles
-    if (timeInPeriod < 0.0) timeInPeriod += period;
-    double onTime = period * dutyCycle_;
-    
-    if ( timeInPeriod < onTime ) {
-        return amplitude_ + offset_;             // Dans la partie haute
-    } else {
-        return offset_;                          // Dans la partie basse
+// (définie inline dans source.hpp)
+
+// Évaluation par blocs : accumulateur de phase (Source::remplirPhases) puis
+// comparaison au rapport cyclique
+void RectangulaireSource::remplir(double t0, double dt, std::size_t n, double* valeurs) const {
+    remplirPhases(t0, dt, n, frequency_, valeurs);
+    const double haut = amplitude_ + offset_, bas = offset_;
+    for (std::size_t k = 0; k < n; ++k) {
+        double p = valeurs[k];
+        double v = (p < dutyCycle_) ? haut : bas;
+        valeurs[k] = (p < 0.0) ? 0.0 : v;
     }
 }
-
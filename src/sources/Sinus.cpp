@@ -37,13 +37,43 @@ SinusSource::SinusSource(double amplitude, double frequency, double offset) {
 }
 
 // Calcul de la valeur : signal sinusodal
+// (définie inline dans source.hpp)
 
-double SinusSource::ve(double t) const {
+// Évaluation par blocs : récurrence de rotation au lieu d'un sin() par
+// échantillon. Quatre rotations indépendantes (pas de 4*dt) entrelacées pour
+// que la boucle se vectorise ; recalage exact sur sin/cos tous les 1024
+// échantillons, ce qui élimine la dérive d'amplitude et de phase.
+void SinusSource::remplir(double t0, double dt, std::size_t n, double* valeurs) const {
+    const std::size_t VOIES = 4, RECALAGE = 1024;
+    const double w = 2 * M_PI * frequency_;
+    const double cosPas = cos(VOIES * w * dt), sinPas = sin(VOIES * w * dt);
+
+    std::size_t k = 0;
     // Toutes les sources sont nulles pour t < 0
-    if (t < 0.0) {
-        return 0.0;
+    while (k < n && t0 + k * dt < 0.0) {
+        valeurs[k++] = 0.0;
     }
 
-    return amplitude_ * sin(2 * M_PI * frequency_ * t) + offset_;
+    while (k < n) {
+        std::size_t fin = std::min(n, k + RECALAGE);
+        double c[VOIES], s[VOIES];
+        for (std::size_t j = 0; j < VOIES; ++j) {
+            double phase = w * (t0 + (k + j) * dt);
+            c[j] = cos(phase);
+            s[j] = sin(phase);
+        }
+        for (; k + VOIES <= fin; k += VOIES) {
+            for (std::size_t j = 0; j < VOIES; ++j) {
+                valeurs[k + j] = amplitude_ * s[j] + offset_;
+            }
+            for (std::size_t j = 0; j < VOIES; ++j) {
+                double cj = c[j] * cosPas - s[j] * sinPas;
+                s[j] = s[j] * cosPas + c[j] * sinPas;
+                c[j] = cj;
+            }
+        }
+        for (; k < fin; ++k) {
+            valeurs[k] = SinusSource::ve(t0 + k * dt);
+        }
+    }
 }
-
@@ -37,24 +37,17 @@ TriangulaireSource::TriangulaireSource(double amplitude, double frequency, doubl
 }
 
 // Calcul de la valeur : signal triangulaire
-
-double TriangulaireSource::ve(double t) const {
-    // Null for negative time per specification
-    if (t < 0.0) {
-        return 0.0;
-    }
-
-    double period = 1.0 / frequency_;
-    double timeInPeriod = fmod(t, period);
-    if (timeInPeriod < 0.0) timeInPeriod += period;
-    double halfPeriod = period / 2.0;
-
-    if (timeInPeriod < halfPeriod) {
-        // Montée : de offset_ à (offset_ + amplitude_)
-        return offset_ + (amplitude_ / halfPeriod) * timeInPeriod;
-    } else {
-        // Descente : de (offset_ + amplitude_) à offset_
-        return offset_ + amplitude_ - (amplitude_ / halfPeriod) * (timeInPeriod - halfPeriod);
+// (définie inline dans source.hpp)
+
+// Évaluation par blocs : accumulateur de phase (Source::remplirPhases) puis
+// forme du triangle, sans fmod ni division par échantillon
+void TriangulaireSource::remplir(double t0, double dt, std::size_t n, double* valeurs) const {
+    remplirPhases(t0, dt, n, frequency_, valeurs);
+    const double pente = 2.0 * amplitude_;     // par unité de phase
+    for (std::size_t k = 0; k < n; ++k) {
+        double p = valeurs[k];
+        double v = (p < 0.5) ? offset_ + pente * p
+                             : offset_ + amplitude_ - pente * (p - 0.5);
+        valeurs[k] = (p < 0.0) ? 0.0 : v;
     }
 }
-
@@ -0,0 +1,37 @@
+#include "source.hpp"
+#include <algorithm>
+#include <cmath>
+
+// Taille des blocs entre deux recalages de l'accumulateur de phase
+static const std::size_t BLOC_PHASE = 1024;
+
+void Source::remplirPhases(double t0, double dt, std::size_t n, double f, double* phases) {
+    const double dphi = f * dt;     // avance de phase par échantillon
+    std::size_t k = 0;
+    while (k < n) {
+        std::size_t fin = std::min(n, k + BLOC_PHASE);
+        double t = t0 + k * dt;
+
+        // Bloc qui démarre avant t = 0, ou phase trop grande pour un int :
+        // évaluation directe (cas rares)
+        if (t < 0.0 || dphi * static_cast<double>(fin - k) > 1e9) {
+            for (; k < fin; ++k) {
+                double tk = t0 + k * dt;
+                double u = tk * f;
+                phases[k] = (tk < 0.0) ? -1.0 : u - std::floor(u);
+            }
+            continue;
+        }
+
+        // Accumulateur recalé : phase = frac(p0 + j*dphi), sans fmod ni division
+        double u0 = t * f;
+        double p0 = u0 - std::floor(u0);
+        double* p = phases + k;
+        const std::size_t m = fin - k;
+        for (std::size_t j = 0; j < m; ++j) {
+            double u = p0 + static_cast<double>(j) * dphi;
+            p[j] = u - static_cast<double>(static_cast<int>(u));
+        }
+        k = fin;
+    }
+}
@@ -0,0 +1,227 @@
+#include "spectre.hpp"
+#include "besim.hpp"
+#include "emetteur_csv.hpp"
+#include "fabrique.hpp"
+#include "fft.hpp"
+#include "regime.hpp"
+#include "solver_static.hpp"
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <complex>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+// sqrt(A(2K)² + ... + A(HK)²) / A(K)
+static double tauxDistorsion(const vector<double>& amplitude, int periodes, int harmoniques) {
+    const double a1 = amplitude[periodes];
+    if (!(a1 > 0.0)) return numeric_limits<double>::quiet_NaN();
+    double somme = 0.0;
+    for (int h = 2; h <= harmoniques; ++h) {
+        const double a = amplitude[static_cast<size_t>(h) * periodes];
+        somme += a * a;
+    }
+    return sqrt(somme) / a1;
+}
+
+bool analyserSpectre(const double* vin, const double* vout, size_t n, int periodes, int harmoniques,
+                     double dt, ResultatSpectre& r, string& erreur) {
+    if (periodes < 1 || harmoniques < 1 || !(dt > 0.0)) {
+        erreur = "fenêtre invalide (periodes >= 1, harmoniques >= 1, dt > 0)";
+        return false;
+    }
+    if (n % static_cast<size_t>(periodes) != 0 || n / periodes < 2) {
+        erreur = "la fenêtre doit couvrir un nombre entier de périodes d'au moins 2 échantillons";
+        return false;
+    }
+    const size_t raies = n / 2 + 1;
+    r = ResultatSpectre();
+    r.periodes = periodes;
+    r.fondamentale = periodes / (static_cast<double>(n) * dt);
+    // Harmoniques au-delà de Nyquist : hors du spectre échantillonné
+    r.harmoniques = static_cast<int>(min(static_cast<size_t>(harmoniques), (n / 2) / periodes));
+    r.frequence.resize(raies);
+    for (size_t k = 0; k < raies; ++k) r.frequence[k] = k / (static_cast<double>(n) * dt);
+
+    const PlanFFTReelle plan(n);
+    vector<complex<double>> x(raies);
+    auto spectre = [&](const double* signal, vector<double>& amplitude, vector<double>& phase) {
+        plan.transformer(signal, x.data());
+        amplitude.resize(raies);
+        phase.resize(raies);
+        for (size_t k = 0; k < raies; ++k) {
+            // Spectre unilatéral : les raies k et N-k sont regroupées, sauf
+            // la composante continue et la raie de Nyquist (N pair)
+            const double echelle = (k == 0 || 2 * k == n) ? 1.0 / n : 2.0 / n;
+            amplitude[k] = abs(x[k]) * echelle;
+            phase[k] = atan2(x[k].imag(), x[k].real()) * (180.0 / M_PI);
+        }
+    };
+    spectre(vin, r.amplitudeVin, r.phaseVin);
+    spectre(vout, r.amplitudeVout, r.phaseVout);
+    r.thdVin = tauxDistorsion(r.amplitudeVin, periodes, r.harmoniques);
+    r.thdVout = tauxDistorsion(r.amplitudeVout, periodes, r.harmoniques);
+    return true;
+}
+
+// --- Mode spectre ---
+
+int lancerSpectre(int argc, char** argv) {
+    ParametresSimulation p;
+    OptionsRegime optRegime;
+    int periodes = 10, harmoniques = 20;
+    long ignorer = 100;
+    bool tir = true;
+    string sortie = "resultats/spectre/spectre.csv";
+    string erreur;
+    for (int i = 0; i < argc; ++i) {
+        string arg = argv[i];
+        size_t eg = arg.find('=');
+        if (eg == string::npos) {
+            cerr << "Spectre : argument sans '=' : " << arg << endl;
+            return 1;
+        }
+        string cle = arg.substr(0, eg), valeur = arg.substr(eg + 1);
+        if (cle == "sortie") sortie = valeur;
+        else if (cle == "periodes") periodes = atoi(valeur.c_str());
+        else if (cle == "harmoniques") harmoniques = atoi(valeur.c_str());
+        else if (cle == "ignorer") ignorer = atol(valeur.c_str());
+        else if (cle == "pas_periode") optRegime.pasParPeriode = atoi(valeur.c_str());
+        else if (cle == "periodes_max") optRegime.periodesMax = atol(valeur.c_str());
+        else if (cle == "regime" && (valeur == "tir" || valeur == "transitoire")) tir = valeur == "tir";
+        else if (cle == "regime") {
+            cerr << "Spectre : regime=tir ou regime=transitoire" << endl;
+            return 1;
+        } else if (!fixerParametre(cle, valeur, p, erreur)) {
+            cerr << "Spectre : " << erreur << endl;
+            return 1;
+        }
+    }
+    optRegime.rtol = p.rtol;
+    optRegime.atol = p.atol;
+    if (!verifierParametres(p, erreur)) {
+        cerr << "Spectre : " << erreur << endl;
+        return 1;
+    }
+    if (p.methode < 1 || p.methode > 10 || p.methode == 5) {
+        cerr << "Spectre : méthode à pas fixe requise (1 à 4, 6 à 10)" << endl;
+        return 1;
+    }
+    if (periodes < 1 || harmoniques < 1 || ignorer < 0 || optRegime.pasParPeriode < 2) {
+        cerr << "Spectre : periodes, harmoniques >= 1, ignorer >= 0, pas_periode >= 2" << endl;
+        return 1;
+    }
+    double periode;
+    if (!periodeSource(p.typeSource, p.f, periode, erreur)) {
+        cerr << "Spectre : " << erreur << " : pas de spectre de raies" << endl;
+        return 1;
+    }
+    const long pasParPeriode = optRegime.pasParPeriode;
+    const long depart = tir ? 0 : ignorer * pasParPeriode;
+    if ((tir ? 0 : ignorer) + periodes > INT_MAX / pasParPeriode) {
+        cerr << "Spectre : fenêtre trop longue pour la grille (periodes * pas_periode)" << endl;
+        return 1;
+    }
+    const size_t n = static_cast<size_t>(periodes) * pasParPeriode;
+    const double dt = periode / pasParPeriode;
+
+    unique_ptr<Circuit> circuit = creerCircuit(p.circuit, p.R, p.R2, p.C, p.L, p.f, false, p.diode);
+    unique_ptr<Source> source = creerSource(p.typeSource, p.amplitude, p.f, p.dutyCycle, p.offset,
+                                            p.startTime);
+
+    cout << "=== Spectre ===" << endl;
+    cout << "  Circuit " << p.circuit << ", source " << p.typeSource << ", méthode " << p.methode
+         << " : " << periodes << " périodes de " << periode << " s, " << n << " échantillons (dt="
+         << dt << " s)" << endl;
+
+    // État au début de la fenêtre (début d'une période de la source)
+    auto debut = chrono::steady_clock::now();
+    double x1 = 0.0, x2 = 0.0;
+    EtatBoucle e;
+    if (tir) {
+        ResultatRegime regime;
+        if (!regimeParTir(*circuit, *source, p.R2, p.methode, periode, optRegime, regime, erreur)) {
+            cerr << "Spectre : " << erreur << endl;
+            return 1;
+        }
+        if (!regime.converge) {
+            cerr << "Spectre : attention, tir non convergé (écart " << regime.ecart
+                 << ") : la fenêtre n'est pas en régime établi" << endl;
+        }
+        x1 = regime.x1;
+        x2 = regime.x2;
+        cout << "  Tir : " << regime.iterations << " itération(s) de Newton, " << regime.periodes
+             << " périodes intégrées" << endl;
+    } else if (depart > 0) {
+        avancerStatique(*circuit, *source, p.R2, p.methode, static_cast<int>(depart - 1), dt, x1, x2, e);
+        cout << "  Transitoire : " << ignorer << " périodes écartées" << endl;
+    }
+
+    // Ligne i de la boucle : (t_i, Vin(t_i), x1(t_i+1)) ; Vout est recalé
+    // pour que vin[j] et vout[j] soient pris au même instant
+    vector<double> temps(n), vin(n), suivant(n), vout(n);
+    vout[0] = x1;
+    simulerStatique(*circuit, *source, p.R2, p.methode, static_cast<int>(depart + n - 1), dt, x1, x2, e,
+                    temps.data(), vin.data(), suivant.data());
+    copy(suivant.begin(), suivant.end() - 1, vout.begin() + 1);
+    const double dureeSimulation = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+
+    ResultatSpectre r;
+    debut = chrono::steady_clock::now();
+    if (!analyserSpectre(vin.data(), vout.data(), n, periodes, harmoniques, dt, r, erreur)) {
+        cerr << "Spectre : " << erreur << endl;
+        return 1;
+    }
+    const double dureeFft = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+
+    // Fichier compact : raies jusqu'à la dernière harmonique, pas la série temporelle
+    filesystem::path chemin(sortie);
+    if (!chemin.parent_path().empty()) filesystem::create_directories(chemin.parent_path());
+    const size_t raies = min(r.frequence.size(), static_cast<size_t>(harmoniques) * periodes + 1);
+    {
+        ofstream fichier(sortie);
+        if (!fichier) {
+            cerr << "Spectre : impossible d'écrire " << sortie << endl;
+            return 1;
+        }
+        fichier << "frequence,vin,vout\n";
+        EmetteurCsv format;
+        for (size_t k = 0; k < raies; ++k) {
+            format.ligne(r.frequence[k], r.amplitudeVin[k], r.amplitudeVout[k]);
+        }
+        fichier.write(format.donnees(), static_cast<streamsize>(format.taille()));
+    }
+    filesystem::path cheminHarmoniques = chemin.parent_path() / (chemin.stem().string() + "_harmoniques.csv");
+    {
+        ofstream fichier(cheminHarmoniques);
+        if (!fichier) {
+            cerr << "Spectre : impossible d'écrire " << cheminHarmoniques.string() << endl;
+            return 1;
+        }
+        fichier.precision(17);
+        fichier << "harmonique,frequence,vin,phase_vin,vout,phase_vout\n";
+        for (int h = 1; h <= r.harmoniques; ++h) {
+            const size_t k = static_cast<size_t>(h) * periodes;
+            fichier << h << ',' << r.frequence[k] << ',' << r.amplitudeVin[k] << ',' << r.phaseVin[k] << ','
+                    << r.amplitudeVout[k] << ',' << r.phaseVout[k] << '\n';
+        }
+    }
+
+    auto pourcent = [](double thd) {
+        return isnan(thd) ? string("indéfini (fondamentale nulle)") : to_string(100.0 * thd) + " %";
+    };
+    cout << "  Fondamentale " << r.fondamentale << " Hz : Vin " << r.amplitudeVin[periodes] << " V, Vout "
+         << r.amplitudeVout[periodes] << " V ; composante continue Vout " << r.amplitudeVout[0] << " V"
+         << endl;
+    cout << "  THD sur " << r.harmoniques << " harmoniques : Vin " << pourcent(r.thdVin) << ", Vout "
+         << pourcent(r.thdVout) << endl;
+    cout << "  Simulation " << dureeSimulation * 1e3 << " ms, FFT " << dureeFft * 1e3 << " ms" << endl;
+    cout << " Fichiers '" << sortie << "' (" << raies << " raies) et '" << cheminHarmoniques.string()
+         << "'" << endl;
+    return 0;
+}
@@ -0,0 +1,298 @@
+#include "transitoire.hpp"
+#include "besim.hpp"
+#include "cache_resultats.hpp"
+#include "ecrivain.hpp"
+#include "fabrique.hpp"
+#include "simulation.hpp"
+#include <charconv>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+using namespace std;
+
+// --- Fichier de point de reprise ---
+
+static string texteExact(double v) {
+    char tampon[32];
+    auto r = to_chars(tampon, tampon + sizeof tampon, v);
+    return string(tampon, r.ptr);
+}
+
+bool ecrirePointReprise(const string& chemin, const PointReprise& p) {
+    const EtatBoucle& b = p.boucle;
+    const EtatRK45& r = p.rk45;
+    string e = "BESIM-REPRISE\n";
+    e += "version=1\n";
+    e += "identite=" + p.identite + "\n";
+    e += "dt=" + texteExact(p.dt) + "\n";
+    e += "x1=" + texteExact(p.x1) + "\n";
+    e += "x2=" + texteExact(p.x2) + "\n";
+    e += "indice=" + to_string(b.indice) + "\n";
+    e += "demarre=" + to_string(b.demarre) + "\n";
+    e += "debut_seg=" + texteExact(b.debutSeg) + "\n";
+    e += "fin_seg=" + texteExact(b.finSeg) + "\n";
+    e += "mem_x1=" + texteExact(b.m.x1) + "\n";
+    e += "mem_x2=" + texteExact(b.m.x2) + "\n";
+    e += "mem_h=" + texteExact(b.m.h) + "\n";
+    e += "mem_valide=" + to_string(b.m.valide) + "\n";
+    e += "raide=" + to_string(b.m.raide) + "\n";
+    e += "mem_vd=" + texteExact(b.m.vd) + "\n";
+    e += "sous_pas_h=" + texteExact(b.m.exactSousPas.h) + "\n";
+    e += "rk45_demarre=" + to_string(r.demarre) + "\n";
+    e += "rk45_t=" + texteExact(r.t) + "\n";
+    e += "rk45_h=" + texteExact(r.h) + "\n";
+    e += "rk45_debut_seg=" + texteExact(r.debutSeg) + "\n";
+    e += "rk45_fin_seg=" + texteExact(r.finSeg) + "\n";
+    e += "rk45_sortie=" + to_string(r.iSortie) + "\n";
+    e += "rk45_rejet=" + to_string(r.rejetPrecedent) + "\n";
+    e += "octets=" + to_string(p.octets) + "\n";
+
+    const string temporaire = chemin + ".tmp";
+    FILE* f = fopen(temporaire.c_str(), "w");
+    if (!f) return false;
+    bool ok = fwrite(e.data(), 1, e.size(), f) == e.size();
+    ok = (fclose(f) == 0) && ok;
+    return ok && rename(temporaire.c_str(), chemin.c_str()) == 0;
+}
+
+bool lirePointReprise(const string& chemin, PointReprise& p, string& erreur) {
+    ifstream f(chemin);
+    string ligne;
+    if (!f || !getline(f, ligne) || ligne != "BESIM-REPRISE") {
+        erreur = chemin + " n'est pas un point de reprise";
+        return false;
+    }
+    map<string, string> v;
+    while (getline(f, ligne)) {
+        size_t eg = ligne.find('=');
+        if (eg != string::npos) v[ligne.substr(0, eg)] = ligne.substr(eg + 1);
+    }
+    for (const char* cle : {"identite", "dt", "x1", "x2", "indice", "rk45_sortie", "octets"}) {
+        if (!v.count(cle)) {
+            erreur = chemin + " : champ " + cle + " manquant";
+            return false;
+        }
+    }
+    // strtod relit exactement l'écriture de to_chars, infinis compris
+    auto reel = [&](const char* cle) { return strtod(v[cle].c_str(), nullptr); };
+    auto entier = [&](const char* cle) { return atoi(v[cle].c_str()); };
+    p.identite = v["identite"];
+    p.dt = reel("dt");
+    p.x1 = reel("x1");
+    p.x2 = reel("x2");
+    p.boucle.indice = entier("indice");
+    p.boucle.demarre = entier("demarre") != 0;
+    p.boucle.debutSeg = reel("debut_seg");
+    p.boucle.finSeg = reel("fin_seg");
+    p.boucle.m.x1 = reel("mem_x1");
+    p.boucle.m.x2 = reel("mem_x2");
+    p.boucle.m.h = reel("mem_h");
+    p.boucle.m.valide = entier("mem_valide") != 0;
+    p.boucle.m.raide = entier("raide") != 0;
+    if (v.count("mem_vd")) p.boucle.m.vd = reel("mem_vd");
+    // Matrices du dernier sous-pas : recalculées pour ce h au premier usage
+    if (v.count("sous_pas_h")) p.boucle.m.exactSousPas.h = reel("sous_pas_h");
+    p.rk45.demarre = entier("rk45_demarre") != 0;
+    p.rk45.t = reel("rk45_t");
+    p.rk45.h = reel("rk45_h");
+    p.rk45.debutSeg = reel("rk45_debut_seg");
+    p.rk45.finSeg = reel("rk45_fin_seg");
+    p.rk45.iSortie = entier("rk45_sortie");
+    p.rk45.rejetPrecedent = entier("rk45_rejet") != 0;
+    p.octets = strtoull(v["octets"].c_str(), nullptr, 10);
+    if (!(p.dt > 0.0)) {
+        erreur = chemin + " : pas dt invalide";
+        return false;
+    }
+    return true;
+}
+
+// --- Mode transitoire ---
+
+int lancerTransitoire(int argc, char** argv) {
+    ParametresSimulation p;
+    string sortie = "resultats/transitoire/transitoire.csv";
+    string chemin;
+    long intervalle = 1L << 20;
+    bool reprendre = true;
+    bool npasDonne = false;
+    string erreur;
+    for (int i = 0; i < argc; ++i) {
+        string arg = argv[i];
+        size_t eg = arg.find('=');
+        if (eg == string::npos) {
+            cerr << "Transitoire : argument sans '=' : " << arg << endl;
+            return 1;
+        }
+        string cle = arg.substr(0, eg), valeur = arg.substr(eg + 1);
+        if (cle == "sortie") sortie = valeur;
+        else if (cle == "point") chemin = valeur;
+        else if (cle == "intervalle") intervalle = atol(valeur.c_str());
+        else if (cle == "reprendre") reprendre = !(valeur == "non" || valeur == "0");
+        else if (!fixerParametre(cle, valeur, p, erreur)) {
+            cerr << "Transitoire : " << erreur << endl;
+            return 1;
+        }
+        if (cle == "npas") npasDonne = true;
+    }
+    // Résultat écrit au fil de l'eau : pas de limite mémoire sur npas
+    if (!verifierParametres(p, erreur, INT_MAX - 1)) {
+        cerr << "Transitoire : " << erreur << endl;
+        return 1;
+    }
+    if (chemin.empty()) chemin = sortie + ".reprise";
+    // Pas fixe : un point de reprise tombe au bord d'un bloc de la source
+    const long bloc = statique::PAS_PAR_BLOC_SOURCE;
+    if (intervalle < 1) intervalle = bloc;
+    if (p.methode != 5) intervalle = (intervalle + bloc - 1) / bloc * bloc;
+    if (intervalle > INT_MAX) intervalle = INT_MAX / bloc * bloc;
+
+    const string identite = identiteTrajectoire(p);
+    Simulation sim(p.npas, p.tmax);
+    PointReprise point;
+    bool reprise = false;
+    if (reprendre && filesystem::exists(chemin)) {
+        if (!lirePointReprise(chemin, point, erreur)) {
+            cerr << "Transitoire : " << erreur << endl;
+            return 1;
+        }
+        if (point.identite != identite) {
+            cerr << "Transitoire : " << chemin << " décrit une autre configuration (" << point.identite
+                 << ") ; reprendre=non pour repartir de t = 0" << endl;
+            return 1;
+        }
+        if (npasDonne && fabs(sim.getDt() - point.dt) > 1e-9 * point.dt) {
+            cerr << "Transitoire : pas dt = " << sim.getDt() << " différent de celui du point de reprise ("
+                 << point.dt << ") ; ne donner que tmax pour prolonger" << endl;
+            return 1;
+        }
+        const double n = nearbyint(p.tmax / point.dt);
+        error_code ec;
+        const uintmax_t taille = filesystem::file_size(sortie, ec);
+        if (n < 1.0 || n >= INT_MAX) {
+            cerr << "Transitoire : tmax / dt hors limites" << endl;
+            return 1;
+        }
+        if (ec || taille < point.octets) {
+            cerr << "Transitoire : " << sortie << " est plus court que le point de reprise" << endl;
+            return 1;
+        }
+        sim.prolonger(point.dt, static_cast<int>(n));
+        reprise = true;
+    }
+
+    const int indice = !reprise ? 0 : (p.methode == 5 ? point.rk45.iSortie : point.boucle.indice);
+    cout << "=== Simulation transitoire ===" << endl;
+    cout << "  Circuit " << p.circuit << ", méthode " << p.methode << ", npas=" << sim.getNpas()
+         << ", tmax=" << sim.getTmax() << " s, dt=" << sim.getDt() << " s" << endl;
+    if (indice > sim.getNpas()) {
+        cout << "  Déjà calculé jusqu'à t = " << (indice - 1) * sim.getDt() << " s dans " << sortie
+             << " : rien à faire" << endl;
+        return 0;
+    }
+
+    // Le CSV est ramené aux lignes couvertes par le point (un arrêt brutal a
+    // pu en écrire davantage) et complété à partir de là
+    ofstream fichier;
+    uintmax_t depart;
+    if (reprise) {
+        error_code ec;
+        filesystem::resize_file(sortie, point.octets, ec);
+        fichier.open(sortie, ios::app);
+        depart = point.octets;
+        cout << "  Reprise à t = " << indice * sim.getDt() << " s (échantillon " << indice << ") : "
+             << sim.getNpas() + 1 - indice << " pas à calculer sur " << sim.getNpas() + 1 << endl;
+    } else {
+        filesystem::path parent = filesystem::path(sortie).parent_path();
+        if (!parent.empty()) filesystem::create_directories(parent);
+        fichier.open(sortie);
+        fichier << "temps,Vin,Vout\n";
+        depart = fichier.tellp();
+    }
+    if (!fichier) {
+        cerr << "Transitoire : impossible d'écrire " << sortie << endl;
+        return 1;
+    }
+
+    unique_ptr<Circuit> circuit = creerCircuit(p.circuit, p.R, p.R2, p.C, p.L, p.f, false, p.diode);
+    unique_ptr<Source> source = creerSource(p.typeSource, p.amplitude, p.f, p.dutyCycle, p.offset,
+                                            p.startTime);
+
+    EmetteurCsv format;
+    format.fixerPas(sim.getDt());
+    EcrivainAsynchrone ecrivain(fichier, format);
+    ecrivain.fixerPremierIndice(static_cast<size_t>(indice));
+
+    // Le point est écrit par le thread d'écriture, après les lignes qu'il
+    // couvre : sur disque, il ne devance jamais le CSV
+    size_t points = 0;
+    auto poser = [&](PointReprise pr) {
+        ++points;
+        ecrivain.jalon([pr, depart, &ecrivain, &fichier, &chemin]() mutable {
+            fichier.flush();
+            pr.octets = depart + ecrivain.octetsEcrits();
+            if (!ecrirePointReprise(chemin, pr)) {
+                cerr << "Transitoire : impossible d'écrire " << chemin << endl;
+            }
+        });
+    };
+    PointReprise courant = point;
+    courant.identite = identite;
+    courant.dt = sim.getDt();
+
+    double x1 = reprise ? point.x1 : 0.0;
+    double x2 = reprise ? point.x2 : 0.0;
+    auto debut = chrono::steady_clock::now();
+    if (p.methode == 5) {
+        OptionsRK45 opt;
+        opt.rtol = p.rtol;
+        opt.atol = p.atol;
+        EtatRK45 etat = reprise ? point.rk45 : EtatRK45();
+        auto jalon = [&](const EtatRK45& e, double y1, double y2) {
+            courant.rk45 = e;
+            courant.x1 = y1;
+            courant.x2 = y2;
+            poser(courant);
+        };
+        StatsRK45 stats = simulerRK45(*circuit, *source, p.R2, sim.getNpas(), sim.getTmax(), opt, x1, x2,
+                                      etat, ecrivain, static_cast<int>(intervalle), jalon);
+        courant.rk45 = etat;
+        cout << "  RK45 : " << stats.pasAcceptes << " pas acceptés, " << stats.pasRejetes << " rejetés"
+             << endl;
+    } else {
+        EtatBoucle etat = reprise ? point.boucle : EtatBoucle();
+        auto jalon = [&](const EtatBoucle& e, double y1, double y2) {
+            courant.boucle = e;
+            courant.x1 = y1;
+            courant.x2 = y2;
+            poser(courant);
+        };
+        simulerStatique(*circuit, *source, p.R2, p.methode, sim.getNpas(), sim.getDt(), x1, x2, etat,
+                        ecrivain, static_cast<int>(intervalle), jalon);
+        courant.boucle = etat;
+        const statique::MemoirePas& m = etat.m;
+        if (m.resolutionsNewton > 0) {
+            cout << "  Newton (diode) : " << static_cast<double>(m.iterationsNewton) / m.resolutionsNewton
+                 << " itérations par pas en moyenne, " << m.iterationsNewtonMax << " au plus" << endl;
+        }
+    }
+    // Point final : un prochain lancement avec un tmax plus grand prolonge
+    courant.x1 = x1;
+    courant.x2 = x2;
+    poser(courant);
+    ecrivain.terminer();
+    const double duree = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+
+    cout << " Fichier '" << sortie << "' : " << sim.getNpas() + 1 << " points de 0 à " << sim.getTmax()
+         << " s, " << sim.getNpas() + 1 - indice << " calculés en " << duree << " s" << endl;
+    cout << "   Points de reprise : " << points << " (tous les " << intervalle << " pas), dernier dans '"
+         << chemin << "'" << endl;
+    return 0;
+}
@@ -0,0 +1,914 @@
+"""
+Regression checks run against a built be-sim binary.
+
+    python3 tests/regressions.py [path/to/be-sim]
+
+Every call has a timeout: an input that used to hang the simulator fails
+the check instead of blocking the run.
+"""
+import cmath
+import concurrent.futures
+import contextlib
+import csv
+import gc
+import glob
+import importlib.util
+import decimal
+import math
+import shutil
+import os
+import re
+import socket
+import struct
+import sysconfig
+import subprocess
+import sys
+import tempfile
+import time
+import unittest
+
+BINARY = os.path.abspath(sys.argv.pop(1) if len(sys.argv) > 1 else 'be-sim')
+TIMEOUT = 20
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+
+
+def run(*args, input=None, text=True):
+    """Run be-sim with the given arguments in a scratch directory."""
+    with tempfile.TemporaryDirectory() as work:
+        return subprocess.run([BINARY, *args], cwd=work, input=input, capture_output=True,
+                              text=text, timeout=TIMEOUT)
+
+
+def read_frames(stream):
+    """Frames (see flux_trames.hpp) of one response as (type, payload), up to
+    and including the final RESU one; None if the stream ends before it."""
+    frames = []
+    while True:
+        head = stream.read(8)
+        if len(head) < 8:
+            return None
+        kind, size = head[:4].decode('ascii'), struct.unpack('<I', head[4:])[0]
+        frames.append((kind, stream.read(size)))
+        if kind == 'RESU':
+            return frames
+
+
+def columns(payload):
+    """ECHA or TRAC content: first index and the time, Vin and Vout columns."""
+    first, m = struct.unpack_from('<QQ', payload)
+    values = struct.unpack_from('<%dd' % (3 * m), payload, 16)
+    return first, values[:m], values[m:2 * m], values[2 * m:]
+
+
+def parse_summary(payload):
+    return dict(line.split('=', 1) for line in payload.decode().splitlines() if '=' in line)
+
+
+def read_summary(stream):
+    """Skip the frames of one response and parse its final RESU one."""
+    frames = read_frames(stream)
+    return None if frames is None else parse_summary(frames[-1][1])
+
+
+def connect(path):
+    sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    sock.settimeout(TIMEOUT)
+    try:
+        sock.connect(path)
+    except OSError:
+        sock.close()
+        raise
+    return sock
+
+
+def start_server(work, *options):
+    """Start be-sim --serveur on a socket in work, once it accepts connections."""
+    path = os.path.join(work, 'be-sim.sock')
+    if os.path.exists(path):
+        os.unlink(path)
+    server = subprocess.Popen([BINARY, '--serveur', path, *options], cwd=work,
+                              stdout=subprocess.PIPE, stderr=subprocess.DEVNULL, text=True)
+    for _ in range(100):
+        try:
+            connect(path).close()
+            break
+        except OSError:
+            time.sleep(0.05)
+    return server, path
+
+
+@contextlib.contextmanager
+def serve(work, *options):
+    """Run be-sim --serveur for the duration of the block; yields the socket path."""
+    server, path = start_server(work, *options)
+    try:
+        yield path
+    finally:
+        server.terminate()
+        server.communicate(timeout=TIMEOUT)
+
+
+class InvalidSource(unittest.TestCase):
+    """A frequency that is not positive and finite, or a duty cycle outside
+    [0, 1], is rejected by verifierParametres instead of hanging the run."""
+
+    def test_transient_negative_frequency(self):
+        r = run('--transitoire', 'circuit=A', 'source=4', 'f=-50', 'npas=1000')
+        self.assertNotEqual(r.returncode, 0)
+        self.assertIn('f doit être positive', r.stderr)
+
+    def test_transient_duty_out_of_range(self):
+        r = run('--transitoire', 'circuit=A', 'source=5', 'duty=2', 'npas=1000')
+        self.assertNotEqual(r.returncode, 0)
+        self.assertIn('duty', r.stderr)
+
+    def test_spectrum_reports_invalid_frequency(self):
+        r = run('--spectre', 'circuit=A', 'source=1', 'f=-50')
+        self.assertNotEqual(r.returncode, 0)
+        self.assertIn('f doit être positive', r.stderr)
+        self.assertNotIn('échelon', r.stderr)
+        r = run('--spectre', 'circuit=A', 'source=2')
+        self.assertNotEqual(r.returncode, 0)
+        self.assertIn('non périodique (échelon)', r.stderr)
+
+    def test_netlist_negative_frequency(self):
+        netlist = os.path.join(os.path.dirname(__file__), '..', 'netlists', 'circuitA.cir')
+        r = run('--netlist', os.path.abspath(netlist), 'source=4', 'f=-50')
+        self.assertNotEqual(r.returncode, 0)
+        self.assertIn('f doit être positive', r.stderr)
+        r = run('--netlist', os.path.abspath(netlist), 'source=5', 'duty=2')
+        self.assertNotEqual(r.returncode, 0)
+        self.assertIn('duty', r.stderr)
+
+    def test_server_survives_negative_frequency(self):
+        with tempfile.TemporaryDirectory() as work, serve(work, 'threads=1', 'cache=non') as path:
+            with connect(path) as sock:
+                stream = sock.makefile('rb')
+                # The single pool thread must answer the bad request and
+                # stay available for the next one
+                sock.sendall(b'circuit=A source=4 f=-50 npas=1000 tmax=1e-2\n')
+                summary = read_summary(stream)
+                self.assertEqual(summary.get('statut'), 'erreur')
+                self.assertIn('f', summary.get('message', ''))
+                sock.sendall(b'circuit=A source=4 f=50 npas=1000 tmax=1e-2\nfin\n')
+                summary = read_summary(stream)
+                self.assertEqual(summary.get('statut'), 'ok')
+
+
+class ServerConnection(unittest.TestCase):
+    """A request line longer than 64 KiB gets an error summary and the
+    connection is closed; the server keeps serving other clients."""
+
+    def test_overlong_line_closes_the_connection(self):
+        with tempfile.TemporaryDirectory() as work, serve(work, 'threads=1', 'cache=non') as path:
+            with connect(path) as sock:
+                # Sans fin de ligne : le serveur ne doit pas attendre la suite
+                try:
+                    sock.sendall(b'circuit=A ' + b'x' * (1 << 20))
+                except OSError:
+                    pass        # fermé pendant l'envoi : la réponse est déjà partie
+                with sock.makefile('rb') as stream:
+                    summary = read_summary(stream)
+                    self.assertEqual(summary.get('statut'), 'erreur')
+                    self.assertIn('65536 octets', summary.get('message', ''))
+                    self.assertEqual(stream.read(), b'')
+            with connect(path) as sock:
+                sock.sendall(b'circuit=A npas=100 tmax=1e-3\nfin\n')
+                with sock.makefile('rb') as stream:
+                    self.assertEqual(read_summary(stream).get('statut'), 'ok')
+
+
+class ServerShutdown(unittest.TestCase):
+    """A client "arret" line stops the server only if it was started with
+    arret=oui; SIGTERM always stops it cleanly, removing its socket."""
+
+    def test_arret_requires_the_option(self):
+        with tempfile.TemporaryDirectory() as work, serve(work, 'threads=1', 'cache=non') as path:
+            with connect(path) as sock:
+                sock.sendall(b'arret\ncircuit=A npas=100 tmax=1e-3\nfin\n')
+                with sock.makefile('rb') as stream:
+                    summary = read_summary(stream)
+                    self.assertEqual(summary.get('statut'), 'erreur')
+                    self.assertIn('arret=oui', summary.get('message', ''))
+                    self.assertEqual(read_summary(stream).get('statut'), 'ok')
+            connect(path).close()
+
+    def test_arret_with_the_option(self):
+        with tempfile.TemporaryDirectory() as work:
+            server, path = start_server(work, 'threads=1', 'cache=non', 'arret=oui')
+            with connect(path) as sock:
+                sock.sendall(b'arret\n')
+            out, _ = server.communicate(timeout=TIMEOUT)
+            self.assertEqual(server.returncode, 0)
+            self.assertIn('Serveur arrêté', out)
+            self.assertFalse(os.path.exists(path))
+
+    def test_sigterm(self):
+        with tempfile.TemporaryDirectory() as work:
+            server, path = start_server(work, 'threads=2', 'cache=non')
+            server.terminate()
+            out, _ = server.communicate(timeout=TIMEOUT)
+            self.assertEqual(server.returncode, 0)
+            self.assertIn('Serveur arrêté', out)
+            self.assertFalse(os.path.exists(path))
+
+
+class SweepOverFrequency(unittest.TestCase):
+    """Every point of a sweep goes through verifierParametres before the pool
+    starts; a valid frequency sweep of a periodic source runs to the end."""
+
+    def test_range_through_zero_is_rejected(self):
+        for source in ('3', '4', '5'):
+            r = run('--balayage', 'circuit=A', 'source=' + source, 'f=-100:100:3',
+                    'npas=1000', 'tmax=1e-2', 'threads=2')
+            self.assertNotEqual(r.returncode, 0)
+            self.assertIn('point 0 : f doit être positive', r.stderr)
+
+    def test_frequency_sweep_completes(self):
+        with tempfile.TemporaryDirectory() as work:
+            out = os.path.join(work, 'balayage.csv')
+            for source in ('3', '4', '5'):
+                r = run('--balayage', 'circuit=C', 'source=' + source, 'f=50:5000:6:log',
+                        'methode=1,3,5', 'npas=2000', 'tmax=1e-2', 'threads=2', 'sortie=' + out)
+                self.assertEqual(r.returncode, 0, r.stderr)
+                with open(out, newline='') as f:
+                    rows = list(csv.DictReader(f))
+                self.assertEqual(len(rows), 18)
+                self.assertEqual(len({row['f'] for row in rows}), 6)
+
+
+class OutputConvention(unittest.TestCase):
+    """Row t_i carries Vin(t_i) and the state after the step, x1(t_i+1), for
+    the adaptive RK45 as for the fixed-step methods."""
+
+    def test_rk45_rows_match_rk4(self):
+        with tempfile.TemporaryDirectory() as work:
+            rows = {}
+            for methode in ('3', '5'):
+                out = os.path.join(work, methode + '.csv')
+                r = run('--transitoire', 'circuit=A', 'source=2', 'methode=' + methode,
+                        'npas=50', 'tmax=1e-3', 'rtol=1e-9', 'atol=1e-12', 'sortie=' + out)
+                self.assertEqual(r.returncode, 0, r.stderr)
+                with open(out, newline='') as f:
+                    rows[methode] = list(csv.DictReader(f))
+            self.assertEqual(len(rows['3']), len(rows['5']))
+            for rk4, rk45 in zip(rows['3'], rows['5']):
+                self.assertAlmostEqual(float(rk4['temps']), float(rk45['temps']), places=12)
+                self.assertAlmostEqual(float(rk4['Vout']), float(rk45['Vout']), places=5)
+
+
+class ImplicitMethods(unittest.TestCase):
+    """With h / tau = 100 on circuit A, RK4 diverges while implicit Euler,
+    BDF2 and the automatic switch settle on the step; the trapezoidal rule
+    stays bounded. The automatic method runs BDF2 there, RK4 when h / tau
+    is small (raide=... in its checkpoint)."""
+
+    STIFF = ('circuit=A', 'source=2', 'R=1', 'C=1e-6', 'npas=200', 'tmax=2e-2')
+
+    def transient(self, work, methode, *params):
+        # Un fichier par lancement : le même nom reprendrait son point de reprise
+        out = os.path.join(work, '%s-%d.csv' % (methode, len(os.listdir(work))))
+        r = run('--transitoire', *params, 'methode=' + methode, 'sortie=' + out)
+        self.assertEqual(r.returncode, 0, r.stderr)
+        with open(out, newline='') as f:
+            vout = [float(row['Vout']) for row in csv.DictReader(f)]
+        with open(out + '.reprise') as f:
+            checkpoint = dict(line.strip().split('=', 1) for line in f if '=' in line)
+        return vout, checkpoint
+
+    def test_stiff_step(self):
+        with tempfile.TemporaryDirectory() as work:
+            vout, _ = self.transient(work, '3', *self.STIFF)
+            self.assertTrue(math.isnan(vout[-1]))
+            for methode in ('6', '8', '9'):
+                vout, _ = self.transient(work, methode, *self.STIFF)
+                self.assertTrue(all(math.isfinite(v) for v in vout), methode)
+                self.assertAlmostEqual(vout[-1], 5.0, places=9, msg=methode)
+            vout, _ = self.transient(work, '7', *self.STIFF)
+            self.assertTrue(all(abs(v) < 10.0 for v in vout))
+            self.assertAlmostEqual(vout[-1], 5.0, places=1)
+
+    def test_automatic_switch(self):
+        with tempfile.TemporaryDirectory() as work:
+            bdf2, _ = self.transient(work, '8', *self.STIFF)
+            auto, checkpoint = self.transient(work, '9', *self.STIFF)
+            self.assertEqual(checkpoint['raide'], '1')
+            self.assertEqual(auto, bdf2)
+            mild = [p.replace('R=1', 'R=1000') for p in self.STIFF]
+            rk4, _ = self.transient(work, '3', *mild)
+            auto, checkpoint = self.transient(work, '9', *mild)
+            self.assertEqual(checkpoint['raide'], '0')
+            self.assertEqual(auto, rk4)
+
+
+def significant_digits(text):
+    """Mantissa digits of a number as written, leading zeros excluded."""
+    return len(text.split('e')[0].replace('-', '').replace('.', '').lstrip('0'))
+
+
+class CsvFormat(unittest.TestCase):
+    """Fixed-step times are i * dt written as the shortest exact decimal;
+    --precision=N writes N significant digits of the same values."""
+
+    INPUT = 'n\nA\n1000\n1e-3\n1\n5\n50\n0\n3\n1000\n1e-6\n'
+
+    def interactive_rows(self, *options):
+        with tempfile.TemporaryDirectory() as work:
+            r = subprocess.run([BINARY, *options], cwd=work, input=self.INPUT,
+                               capture_output=True, text=True, timeout=TIMEOUT)
+            self.assertEqual(r.returncode, 0, r.stderr)
+            with open(os.path.join(work, 'resultats/simulations/circuit_output.csv'), newline='') as f:
+                return list(csv.reader(f))[1:]
+
+    def test_times_are_exact(self):
+        with tempfile.TemporaryDirectory() as work:
+            out = os.path.join(work, 'sortie.csv')
+            # dt = 5e-07 / 20000 = 2.5e-11, 2.4999999999999998e-11 en double
+            r = run('--transitoire', 'circuit=A', 'npas=20000', 'tmax=5e-7', 'sortie=' + out)
+            self.assertEqual(r.returncode, 0, r.stderr)
+            with open(out, newline='') as f:
+                rows = list(csv.DictReader(f))
+        self.assertGreater(len(rows), 20000)
+        step = decimal.Decimal('2.5e-11')
+        for i, row in enumerate(rows):
+            text = row['temps']
+            self.assertEqual(decimal.Decimal(text), i * step, text)
+            if i:
+                exact = (i * step).normalize().as_tuple().digits
+                self.assertEqual(significant_digits(text), len(exact), text)
+
+    def test_precision_round_trips(self):
+        # Temps de --precision : i * dt calculé en double (emetteur_csv.hpp)
+        shortest = self.interactive_rows()
+        dt = 1e-3 / 1000
+        for n in (6, 17):
+            rows = self.interactive_rows('--precision=%d' % n)
+            self.assertEqual(len(rows), len(shortest))
+            for i, (row, reference) in enumerate(zip(rows, shortest)):
+                values = [i * dt] + [float(v) for v in reference[1:]]
+                for text, value in zip(row, values):
+                    self.assertEqual(float(text), float('%.*g' % (n, value)), (n, text))
+                    self.assertLessEqual(significant_digits(text), n)
+
+
+class BatchEngine(unittest.TestCase):
+    """The lot/... cases of --banc check the batch engine against each
+    instance integrated alone before timing it."""
+
+    def test_batch_matches_single_instances(self):
+        r = run('--banc', 'filtre=lot/', 'npas=4096', 'lot=16', 'repetitions=1', 'diode=seuil')
+        self.assertEqual(r.returncode, 0, r.stderr)
+        for circuit in 'ABCD':
+            self.assertIn('lot/scalaire/rk4/' + circuit, r.stdout)
+
+    def test_shockley_diode_is_rejected(self):
+        r = run('--banc', 'filtre=/B', 'npas=4096', 'lot=16', 'repetitions=1', 'csv=non',
+                'diode=shockley')
+        self.assertEqual(r.returncode, 0, r.stderr)
+        self.assertIn('lot/*/B non mesuré', r.stdout)
+        self.assertNotIn('lot/scalaire/euler/B', r.stdout)
+
+
+def read_rows(path):
+    with open(path, newline='') as f:
+        return list(csv.DictReader(f))
+
+
+class DiodeModel(unittest.TestCase):
+    """Circuit B uses the 0.6 V threshold diode unless diode=shockley; the
+    implicit Shockley steps converge in a few Newton iterations and land
+    close to the threshold model."""
+
+    def transient(self, work, name, *args):
+        out = os.path.join(work, name + '.csv')
+        r = run('--transitoire', 'circuit=B', 'npas=20000', 'tmax=2e-2', 'sortie=' + out, *args)
+        self.assertEqual(r.returncode, 0, r.stderr)
+        return r, read_rows(out)
+
+    def test_threshold_is_the_default(self):
+        with tempfile.TemporaryDirectory() as work:
+            _, default = self.transient(work, 'defaut', 'source=1')
+            _, seuil = self.transient(work, 'seuil', 'source=1', 'diode=seuil')
+            self.assertEqual(default, seuil)
+
+    def test_newton_iterations(self):
+        with tempfile.TemporaryDirectory() as work:
+            for source, moyenne_max, max_max in (('2', 2.0, 4), ('1', 3.0, 5), ('4', 3.0, 20)):
+                for methode in ('6', '7', '8'):
+                    r, _ = self.transient(work, source + methode, 'diode=shockley',
+                                          'source=' + source, 'methode=' + methode)
+                    line = next(l for l in r.stdout.splitlines() if 'Newton (diode)' in l)
+                    mots = line.split()
+                    moyenne, maximum = float(mots[3]), int(mots[mots.index('au') - 1])
+                    self.assertLessEqual(moyenne, moyenne_max, line)
+                    self.assertLessEqual(maximum, max_max, line)
+
+    def test_agrees_with_threshold_model(self):
+        with tempfile.TemporaryDirectory() as work:
+            # Echelon de 5 V : vs -> (5 - vd) R2 / (R1 + R2), vd = 0,6 V ou ~0,67 V
+            _, seuil = self.transient(work, 'seuil', 'source=2', 'methode=3', 'diode=seuil')
+            _, shockley = self.transient(work, 'shockley', 'source=2', 'methode=3',
+                                         'diode=shockley')
+            self.assertAlmostEqual(float(seuil[-1]['Vout']), 2.2, places=6)
+            for a, b in zip(seuil[1000::1000], shockley[1000::1000]):
+                self.assertLess(abs(float(a['Vout']) - float(b['Vout'])), 0.05)
+
+
+class ResultCache(unittest.TestCase):
+    """A request answered from the memory or disk cache streams the same
+    frames, byte for byte, as the run that filled it."""
+
+    REQUEST = b'circuit=C source=4 f=200 duty=0.3 methode=3 npas=30000 tmax=2e-2 trace=200\n'
+
+    def ask(self, path, request=REQUEST):
+        with connect(path) as sock:
+            sock.sendall(request + b'fin\n')
+            with sock.makefile('rb') as stream:
+                frames = read_frames(stream)
+        self.assertIsNotNone(frames)
+        return frames[:-1], parse_summary(frames[-1][1])
+
+    def test_hits_are_byte_identical(self):
+        with tempfile.TemporaryDirectory() as work:
+            cache = 'cache=' + os.path.join(work, 'cache')
+            with serve(work, 'threads=2', cache) as path:
+                computed, summary = self.ask(path)
+                self.assertEqual(summary.get('cache'), 'calcul')
+                self.assertEqual([kind for kind, _ in computed[:1]], ['ENTE'])
+                self.assertIn('TRAC', [kind for kind, _ in computed])
+                memory, summary = self.ask(path)
+                self.assertEqual(summary.get('cache'), 'memoire')
+                self.assertEqual(memory, computed)
+            # Nouveau processus : seul le dossier du cache reste
+            with serve(work, 'threads=2', cache) as path:
+                disk, summary = self.ask(path)
+                self.assertEqual(summary.get('cache'), 'disque')
+                self.assertEqual(disk, computed)
+                other, summary = self.ask(path, self.REQUEST.replace(b'f=200', b'f=201'))
+                self.assertEqual(summary.get('cache'), 'calcul')
+
+    def test_concurrent_requests_compute_once(self):
+        # Assez long pour que les quatre demandes se recouvrent ; lues en
+        # parallèle, car le calcul diffusé bloque tant que son client ne lit pas
+        request = self.REQUEST.replace(b'npas=30000', b'npas=400000')
+        with tempfile.TemporaryDirectory() as work:
+            with serve(work, 'threads=4', 'cache=' + os.path.join(work, 'cache')) as path:
+                with concurrent.futures.ThreadPoolExecutor(4) as pool:
+                    answers = list(pool.map(lambda _: self.ask(path, request), range(4)))
+        origins = sorted(summary.get('cache') for _, summary in answers)
+        self.assertEqual(origins, ['calcul', 'memoire', 'memoire', 'memoire'])
+        for frames, _ in answers[1:]:
+            self.assertEqual(frames, answers[0][0])
+
+
+class PythonModule(unittest.TestCase):
+    """The besim extension (setup.py) exposes the columns as read-only (3, n)
+    float64 buffers that keep the result alive, with the row stride of the
+    allocation; bad parameters raise ValueError. Skipped without a C++
+    compiler or the Python headers."""
+
+    @classmethod
+    def setUpClass(cls):
+        compiler = (sysconfig.get_config_var('CXX') or 'c++').split()[0]
+        headers = os.path.join(sysconfig.get_paths()['include'], 'Python.h')
+        if shutil.which(compiler) is None or not os.path.exists(headers):
+            raise unittest.SkipTest('no C++ compiler or Python headers')
+        cls.work = tempfile.TemporaryDirectory()
+        r = subprocess.run([sys.executable, 'setup.py', 'build_ext', '-j', str(os.cpu_count() or 1),
+                            '--build-lib', cls.work.name,
+                            '--build-temp', os.path.join(cls.work.name, 'temp')],
+                           cwd=ROOT, capture_output=True, text=True, timeout=900)
+        if r.returncode != 0:
+            cls.work.cleanup()
+            raise AssertionError(r.stderr)
+        path = glob.glob(os.path.join(cls.work.name, 'besim*.so'))[0]
+        spec = importlib.util.spec_from_file_location('besim', path)
+        cls.besim = importlib.util.module_from_spec(spec)
+        spec.loader.exec_module(cls.besim)
+
+    @classmethod
+    def tearDownClass(cls):
+        cls.work.cleanup()
+
+    PARAMS = dict(circuit='C', source=4, f=200, methode=3, npas=20000, tmax=2e-2)
+
+    def test_signal_layout(self):
+        r = self.besim.simuler(cache=False, **self.PARAMS)
+        view = memoryview(r['signal'])
+        n = r['n']
+        self.assertEqual(n, 20001)
+        self.assertEqual((view.format, view.itemsize, view.ndim), ('d', 8, 2))
+        self.assertEqual(view.shape, (3, n))
+        self.assertEqual(view.strides[1], 8)
+        self.assertGreaterEqual(view.strides[0], 8 * n)
+        self.assertEqual(len(r['signal']), n)
+        self.assertEqual(view[0, 1], 1e-6)
+
+    def test_read_only(self):
+        view = memoryview(self.besim.simuler(cache=False, **self.PARAMS)['signal'])
+        self.assertTrue(view.readonly)
+        with self.assertRaises(TypeError):
+            view[0, 0] = 1.0
+
+    def test_view_outlives_result(self):
+        reference = memoryview(self.besim.simuler(cache=False, **self.PARAMS)['signal']).tolist()
+        view = memoryview(self.besim.simuler(cache=False, **self.PARAMS)['signal'])
+        gc.collect()
+        self.assertEqual(view.tolist(), reference)
+
+    def test_strided_trace(self):
+        # Lignes séparées de strides[0] octets (capacité des colonnes) : la
+        # trace est lue élément par élément à travers ces pas, sans copie
+        r = self.besim.simuler(cache=False, trace=1000, lttb=True, **self.PARAMS)
+        signal, trace = memoryview(r['signal']), memoryview(r['trace'])
+        m = trace.shape[1]
+        self.assertEqual(m, 1000)
+        self.assertEqual(trace.strides[1], 8)
+        self.assertGreaterEqual(trace.strides[0], 8 * m)
+        rows = [[trace[k, i] for i in range(m)] for k in range(3)]
+        self.assertEqual(rows, trace.tolist())
+        self.assertEqual((rows[0][0], rows[0][-1]), (signal[0, 0], signal[0, r['n'] - 1]))
+        # Chaque point de la trace est un échantillon du signal
+        times = signal.tolist()[0]
+        for t, vout in zip(rows[0], rows[2]):
+            self.assertEqual(vout, signal[2, times.index(t)])
+
+    def test_cache_stays_in_memory(self):
+        with tempfile.TemporaryDirectory() as work:
+            previous = os.getcwd()
+            os.chdir(work)
+            try:
+                params = dict(self.PARAMS, f=321)
+                self.assertEqual(self.besim.simuler(**params)['cache'], 'calcul')
+                self.assertEqual(self.besim.simuler(**params)['cache'], 'memoire')
+            finally:
+                os.chdir(previous)
+            self.assertEqual(os.listdir(work), [])
+
+    def test_bad_parameters(self):
+        for bad in (dict(circuit='Z'), dict(f=-50, source=4), dict(inconnu=1)):
+            with self.assertRaises(ValueError):
+                self.besim.simuler(**bad)
+
+
+class Checkpoint(unittest.TestCase):
+    """A transient run extended to a longer tmax from its checkpoint, after
+    rows written past the checkpoint were left behind, gives the same CSV
+    byte for byte as a single run (fixed-step methods)."""
+
+    def test_extend_matches_single_run(self):
+        with tempfile.TemporaryDirectory() as work:
+            # Créneau à 150 Hz : fronts hors grille, pas coupés après la reprise
+            common = ('circuit=D', 'source=4', 'f=150')
+            for methode in ('1', '3', '6', '7', '8', '9', '10'):
+                single = os.path.join(work, 'single%s.csv' % methode)
+                r = run('--transitoire', 'methode=' + methode, 'npas=30000', 'tmax=3e-2',
+                        'sortie=' + single, *common)
+                self.assertEqual(r.returncode, 0, r.stderr)
+                extended = os.path.join(work, 'extended%s.csv' % methode)
+                r = run('--transitoire', 'methode=' + methode, 'npas=10000', 'tmax=1e-2',
+                        'intervalle=3000', 'sortie=' + extended, *common)
+                self.assertEqual(r.returncode, 0, r.stderr)
+                # Lignes écrites après le point, comme après un arrêt brutal
+                with open(extended, 'a') as f:
+                    f.write('0.0100011,5,0.1\n0.01')
+                r = run('--transitoire', 'methode=' + methode, 'npas=30000', 'tmax=3e-2',
+                        'sortie=' + extended, *common)
+                self.assertEqual(r.returncode, 0, r.stderr)
+                self.assertIn('Reprise à t = 0.010001 s', r.stdout)
+                with open(single, 'rb') as a, open(extended, 'rb') as b:
+                    self.assertEqual(a.read(), b.read(), 'méthode ' + methode)
+
+
+class FrameStream(unittest.TestCase):
+    """be-sim --flux writes nothing but frames on stdout: one ENTE header,
+    ECHA blocks covering samples 0 .. n-1 in order, a final RESU; the
+    samples are those of the same run written as CSV by --transitoire."""
+
+    def test_layout(self):
+        # Défauts non, circuit A, npas, tmax, sinus 5 V 50 Hz, RK4, R, C
+        answers = b'n\nA\n100000\n0.05\n1\n5\n50\n0\n3\n1000\n1e-6\n'
+        r = run('--flux', input=answers, text=False)
+        self.assertEqual(r.returncode, 0, r.stderr)
+        data, offset, frames = r.stdout, 0, []
+        while offset < len(data):
+            self.assertGreaterEqual(len(data) - offset, 8)
+            kind = data[offset:offset + 4].decode('ascii')
+            size = struct.unpack_from('<I', data, offset + 4)[0]
+            frames.append((kind, data[offset + 8:offset + 8 + size]))
+            offset += 8 + size
+        self.assertEqual(offset, len(data))
+        self.assertEqual([kind for kind, _ in frames[:1]], ['ENTE'])
+        self.assertEqual(frames[-1][0], 'RESU')
+        self.assertEqual({kind for kind, _ in frames[1:-1]}, {'ECHA'})
+
+        header = frames[0][1].decode()
+        self.assertTrue(header.startswith('BESIM-FLUX\nversion=1\n'))
+        header = parse_summary(frames[0][1])
+        self.assertEqual(header['n'], '100001')
+        self.assertEqual(header['colonnes'], 'temps:<f8,Vin:<f8,Vout:<f8')
+        summary = parse_summary(frames[-1][1])
+        self.assertEqual(summary['statut'], 'ok')
+        self.assertEqual(summary['echantillons'], '100001')
+
+        rows = []
+        for kind, payload in frames[1:-1]:
+            first, t, vin, vout = columns(payload)
+            self.assertEqual(len(payload), 16 + 24 * len(t))
+            self.assertEqual(first, len(rows))
+            rows.extend(zip(t, vin, vout))
+        self.assertEqual(len(rows), 100001)
+        self.assertGreater(len(frames), 3)
+
+        with tempfile.TemporaryDirectory() as work:
+            out = os.path.join(work, 'a.csv')
+            r = run('--transitoire', 'circuit=A', 'source=1', 'A=5', 'f=50', 'methode=3',
+                    'npas=100000', 'tmax=0.05', 'R=1000', 'C=1e-6', 'sortie=' + out)
+            self.assertEqual(r.returncode, 0, r.stderr)
+            expected = [tuple(map(float, (row['temps'], row['Vin'], row['Vout'])))
+                        for row in read_rows(out)]
+        # Temps : i * dt en double dans les trames, décimal exact dans le CSV
+        self.assertEqual(len(rows), len(expected))
+        for i, (a, b) in enumerate(zip(rows, expected)):
+            if a[1:] != b[1:] or abs(a[0] - b[0]) > 1e-15 * b[0]:
+                self.fail('échantillon %d : %r au lieu de %r' % (i, a, b))
+
+
+class Trace(unittest.TestCase):
+    """The reduced trace (TRAC frame) keeps real samples in time order, the
+    first and the last one, at most `trace` points: exactly that many with
+    LTTB, the extremes of every bucket with min-max."""
+
+    def response(self, path, request):
+        with connect(path) as sock:
+            sock.sendall(request + b'\nfin\n')
+            with sock.makefile('rb') as stream:
+                frames = read_frames(stream)
+        samples = {}
+        trace = None
+        for kind, payload in frames:
+            if kind == 'ECHA':
+                _, t, vin, vout = columns(payload)
+                samples.update(zip(t, zip(vin, vout)))
+            elif kind == 'TRAC':
+                trace = columns(payload)
+        self.assertEqual(parse_summary(frames[-1][1]).get('statut'), 'ok')
+        return samples, trace
+
+    def test_point_counts(self):
+        with tempfile.TemporaryDirectory() as work, serve(work, 'threads=1', 'cache=non') as path:
+            for target in (10, 203, 1000):
+                for lttb in (0, 1):
+                    request = ('circuit=C source=4 f=200 npas=100000 tmax=2e-2 trace=%d lttb=%d'
+                               % (target, lttb)).encode()
+                    samples, (first, t, vin, vout) = self.response(path, request)
+                    self.assertEqual(first, 0)
+                    if lttb:
+                        self.assertEqual(len(t), target, request)
+                    else:
+                        buckets = (target - 2) // 4
+                        self.assertGreaterEqual(len(t), 2 + buckets, request)
+                        self.assertLessEqual(len(t), 2 + 4 * buckets, request)
+                        everything = [v for _, v in samples.values()]
+                        self.assertIn(max(everything), vout)
+                        self.assertIn(min(everything), vout)
+                    self.assertEqual(t[0], min(samples))
+                    self.assertEqual(t[-1], max(samples))
+                    self.assertTrue(all(a < b for a, b in zip(t, t[1:])), request)
+                    for point in zip(t, vin, vout):
+                        self.assertEqual(samples.get(point[0]), point[1:], request)
+            # Moins d'échantillons que de points demandés : tous gardés
+            samples, (_, t, _, _) = self.response(path, b'circuit=A npas=50 tmax=1e-3 trace=100')
+            self.assertEqual(sorted(samples), list(t))
+
+
+class StateSpace(unittest.TestCase):
+    """--etat reproduces the circuit classes of A, C and D, and integrates
+    higher-order ladders consistently across methods up to their DC limit."""
+
+    def etat(self, work, name, *args):
+        out = os.path.join(work, name + '.csv')
+        r = run('--etat', 'sortie=' + out, *args)
+        self.assertEqual(r.returncode, 0, r.stderr)
+        return [float(row['Vout']) for row in read_rows(out)]
+
+    def test_matches_circuit_classes(self):
+        with tempfile.TemporaryDirectory() as work:
+            common = ('source=4', 'f=150', 'npas=20000', 'tmax=2e-2')
+            for circuit in 'ACD':
+                for methode in ('3', '7', '8', '10'):
+                    cas = circuit + methode
+                    etat = self.etat(work, 'etat' + cas, 'modele=circuit', 'circuit=' + circuit,
+                                     'methode=' + methode, *common)
+                    out = os.path.join(work, 'classe%s.csv' % cas)
+                    r = run('--transitoire', 'circuit=' + circuit, 'methode=' + methode,
+                            'sortie=' + out, *common)
+                    self.assertEqual(r.returncode, 0, r.stderr)
+                    classe = [float(row['Vout']) for row in read_rows(out)]
+                    self.assertEqual(len(etat), len(classe))
+                    for a, b in zip(etat, classe):
+                        self.assertAlmostEqual(a, b, delta=1e-9, msg=cas)
+
+    def test_ladders_settle_to_the_input(self):
+        # Échelon de 5 V : 6 cellules RC (mode le plus lent ~17 ms), 3 cellules
+        # RLC (raides, L/R = 1 µs : implicites seulement à dt = 10 µs)
+        implicites = (('7', 1e-4), ('8', 1e-4), ('6', 1e-2))
+        with tempfile.TemporaryDirectory() as work:
+            for modele, sections, methodes in (('echelle', '6', (('3', 1e-6),) + implicites),
+                                               ('rlc', '3', implicites)):
+                common = ('modele=' + modele, 'sections=' + sections, 'source=2', 'npas=40000',
+                          'tmax=0.4')
+                exact = self.etat(work, modele + '10', 'methode=10', *common)
+                self.assertAlmostEqual(exact[-1], 5.0, delta=1e-6, msg=modele)
+                for methode, tolerance in methodes:
+                    other = self.etat(work, modele + methode, 'methode=' + methode, *common)
+                    for a, b in zip(other[::100], exact[::100]):
+                        self.assertAlmostEqual(a, b, delta=tolerance,
+                                               msg='%s methode=%s' % (modele, methode))
+
+
+class SteadyState(unittest.TestCase):
+    """--regime on a lightly damped circuit C: the shooting method converges
+    in one Newton iteration (linear circuit) onto the same period as the
+    transient stopped once two periods coincide; a step has no period."""
+
+    PARAMS = ('circuit=C', 'source=1', 'f=1000', 'R=1', 'methode=3', 'rtol=1e-8')
+
+    def regime(self, work, algo):
+        out = os.path.join(work, algo + '.csv')
+        r = run('--regime', *self.PARAMS, 'algo=' + algo, 'sortie=' + out)
+        self.assertEqual(r.returncode, 0, r.stderr)
+        self.assertIn('Régime établi', r.stdout)
+        with open(out, newline='') as f:
+            vout = [float(row['Vout']) for row in csv.DictReader(f)]
+        return r.stdout, vout
+
+    def test_shooting_matches_periods(self):
+        with tempfile.TemporaryDirectory() as work:
+            shooting, period = self.regime(work, 'tir')
+            periods, transient = self.regime(work, 'periodes')
+        self.assertIn('Tir : 1 itération(s) de Newton', shooting)
+        # État (x1, x2) affiché sur 6 chiffres
+        states = [re.search(r'x1 = (\S+), x2 = (\S+)', out).groups() for out in (shooting, periods)]
+        for a, b in zip(*states):
+            self.assertAlmostEqual(float(a), float(b), delta=1e-5 * abs(float(a)))
+        # Une période de 1000 pas, comparée à la dernière du transitoire
+        self.assertEqual(len(period), 1000)
+        self.assertGreater(len(transient), 10 * len(period))
+        scale = max(abs(v) for v in period)
+        for a, b in zip(period, transient[-len(period):]):
+            self.assertLessEqual(abs(a - b), 1e-8 * scale)
+
+    def test_step_is_rejected(self):
+        r = run('--regime', 'circuit=C', 'source=2')
+        self.assertNotEqual(r.returncode, 0)
+        self.assertIn('non périodique (échelon)', r.stderr)
+
+
+class ExactPropagator(unittest.TestCase):
+    """Method 10 (propagateur.hpp) is exact for the piecewise-affine sources of
+    A, C and D whatever the step, and second order for the sine; the
+    reference is RK4 on a 100 times finer grid."""
+
+    def compare(self, work, circuit, source, npas, tolerance):
+        exact, rk4 = (os.path.join(work, '%s%s_%s.csv' % (circuit, source, m)) for m in ('10', '3'))
+        common = ('circuit=' + circuit, 'source=' + source, 'tmax=2e-2')
+        r = run('--transitoire', 'methode=10', 'npas=%d' % npas, 'sortie=' + exact, *common)
+        self.assertEqual(r.returncode, 0, r.stderr)
+        r = run('--transitoire', 'methode=3', 'npas=%d' % (100 * npas), 'sortie=' + rk4, *common)
+        self.assertEqual(r.returncode, 0, r.stderr)
+        exact, rk4 = read_rows(exact), read_rows(rk4)
+        # Ligne i : x(t_i+1) ; sur la grille fine, t_i+1 = t_100i+100
+        for i, row in enumerate(exact[:-1]):
+            self.assertAlmostEqual(float(row['Vout']), float(rk4[100 * i + 99]['Vout']),
+                                   delta=tolerance,
+                                   msg='%s source=%s t=%s' % (circuit, source, row['temps']))
+
+    def test_piecewise_affine_sources_are_exact(self):
+        # dt = 5e-5 : RK4 à ce pas diverge sur C (L/R = 1e-6 s)
+        with tempfile.TemporaryDirectory() as work:
+            for circuit in 'ACD':
+                for source in ('2', '3', '4', '5'):
+                    self.compare(work, circuit, source, 400, 1e-6)
+
+    def test_sine_is_second_order(self):
+        with tempfile.TemporaryDirectory() as work:
+            for circuit in 'ACD':
+                self.compare(work, circuit, '1', 4000, 2e-6)
+
+
+class Bode(unittest.TestCase):
+    """--ac gives the analytic response of A (first-order low-pass, -3 dB at
+    1/(2πRC)) and C (series RLC) with every instruction set kernel."""
+
+    R, C, L = 1000.0, 1e-6, 1e-3
+
+    def sweep(self, work, circuit, jeu):
+        out = os.path.join(work, 'bode_%s_%s.csv' % (circuit, jeu))
+        r = run('--ac', 'circuit=' + circuit, 'R=%g' % self.R, 'C=%g' % self.C, 'L=%g' % self.L,
+                'fmin=10', 'fmax=1e5', 'points=2001', 'threads=2', 'jeu=' + jeu, 'sortie=' + out)
+        self.assertEqual(r.returncode, 0, r.stderr)
+        return [(float(row['frequence']), float(row['gain_db']), float(row['phase_deg']))
+                for row in read_rows(out)]
+
+    def test_cutoff_of_circuit_a(self):
+        with tempfile.TemporaryDirectory() as work:
+            rows = self.sweep(work, 'A', 'auto')
+        cutoff = -10 * math.log10(2)
+        for (f0, g0, _), (f1, g1, _) in zip(rows, rows[1:]):
+            if g0 >= cutoff > g1:
+                # Interpolation linéaire du gain en log f
+                f = f0 * (f1 / f0) ** ((cutoff - g0) / (g1 - g0))
+                break
+        else:
+            self.fail('pas de coupure à -3 dB entre 10 Hz et 100 kHz')
+        self.assertAlmostEqual(f, 1 / (2 * math.pi * self.R * self.C), delta=1e-3 * f)
+
+    def test_matches_transfer_function(self):
+        with tempfile.TemporaryDirectory() as work:
+            for jeu in ('scalaire', 'avx2', 'avx512'):
+                for circuit in 'AC':
+                    for f, gain, phase in self.sweep(work, circuit, jeu):
+                        s = 2j * math.pi * f
+                        if circuit == 'A':
+                            h = 1 / (1 + s * self.R * self.C)
+                        else:
+                            h = 1 / (1 + s * self.R * self.C + s * s * self.L * self.C)
+                        cas = '%s jeu=%s f=%g' % (circuit, jeu, f)
+                        self.assertAlmostEqual(gain, 20 * math.log10(abs(h)), delta=1e-9, msg=cas)
+                        self.assertAlmostEqual(phase, math.degrees(cmath.phase(h)), delta=1e-9,
+                                               msg=cas)
+
+
+class Spectrum(unittest.TestCase):
+    """The mixed-radix FFT of --spectre matches a direct DFT of the same
+    samples, for odd lengths, generic prime factors and the even real path."""
+
+    def test_fft_matches_direct_dft(self):
+        amplitude = 2.0
+        with tempfile.TemporaryDirectory() as work:
+            out = os.path.join(work, 'spectre.csv')
+            for periodes, pas_periode in ((3, 7), (5, 9), (4, 15), (7, 11), (2, 13), (6, 25),
+                                          (8, 16)):
+                n = periodes * pas_periode
+                # Fenêtre partant de t = 0 : Vin(t_j) est le triangle à la phase j / pas_periode
+                r = run('--spectre', 'circuit=A', 'source=3', 'A=%g' % amplitude, 'f=50',
+                        'regime=transitoire', 'ignorer=0', 'periodes=%d' % periodes,
+                        'pas_periode=%d' % pas_periode, 'harmoniques=%d' % n, 'methode=3',
+                        'sortie=' + out)
+                self.assertEqual(r.returncode, 0, r.stderr)
+                samples = []
+                for j in range(n):
+                    phase = j % pas_periode / pas_periode
+                    samples.append(2 * amplitude * phase if phase < 0.5
+                                   else amplitude - 2 * amplitude * (phase - 0.5))
+                rows = read_rows(out)
+                self.assertEqual(len(rows), n // 2 + 1)
+                for k, row in enumerate(rows):
+                    x = sum(v * cmath.exp(-2j * math.pi * j * k / n) for j, v in enumerate(samples))
+                    scale = 1 / n if k == 0 or 2 * k == n else 2 / n
+                    self.assertAlmostEqual(float(row['vin']), abs(x) * scale, delta=1e-9,
+                                           msg='N=%d, raie %d' % (n, k))
+                for row in read_rows(os.path.join(work, 'spectre_harmoniques.csv')):
+                    k = int(row['harmonique']) * periodes
+                    x = sum(v * cmath.exp(-2j * math.pi * j * k / n) for j, v in enumerate(samples))
+                    if abs(x) * 2 / n > 1e-6:
+                        ecart = (float(row['phase_vin']) - math.degrees(cmath.phase(x)) + 180) % 360 - 180
+                        self.assertLess(abs(ecart), 1e-6, 'N=%d, harmonique %s' % (n, row['harmonique']))
+
+
+class Netlist(unittest.TestCase):
+    """netlists/circuit{A..D}.cir solved by modified nodal analysis give the
+    same trajectory as the dedicated circuit classes (--transitoire)."""
+
+    def test_netlists_match_transient(self):
+        netlists = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'netlists')
+        with tempfile.TemporaryDirectory() as work:
+            for circuit in 'ABCD':
+                for source in ('1', '4'):
+                    for methode in ('6', '7'):
+                        cas = '%s source=%s methode=%s' % (circuit, source, methode)
+                        common = ('source=' + source, 'methode=' + methode, 'npas=4000',
+                                  'tmax=2e-2')
+                        mna = os.path.join(work, 'mna.csv')
+                        r = run('--netlist', os.path.join(netlists, 'circuit%s.cir' % circuit),
+                                'sortie=' + mna, *common)
+                        self.assertEqual(r.returncode, 0, r.stderr)
+                        # Sorties distinctes : pas de fichier de reprise d'un cas précédent
+                        classe = os.path.join(work, cas.replace(' ', '_') + '.csv')
+                        diode = ('diode=shockley',) if circuit == 'B' else ()
+                        r = run('--transitoire', 'circuit=' + circuit, 'sortie=' + classe,
+                                *diode, *common)
+                        self.assertEqual(r.returncode, 0, r.stderr)
+                        mna, classe = read_rows(mna), read_rows(classe)
+                        self.assertEqual(len(mna), len(classe), cas)
+                        for a, b in zip(mna, classe):
+                            self.assertEqual(a['temps'], b['temps'], cas)
+                            self.assertAlmostEqual(float(a['Vin']), float(b['Vin']), delta=1e-12,
+                                                   msg=cas)
+                            self.assertAlmostEqual(float(a['Vout']), float(b['Vout']), delta=1e-6,
+                                                   msg=cas + ', t=' + a['temps'])
+
+
+if __name__ == '__main__':
+    unittest.main()